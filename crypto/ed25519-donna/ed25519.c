@@ -101,16 +101,16 @@ ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_sec
 	contract256_modm(RS + 32, S);
 }
 
-int
-ED25519_FN(ed25519_sign_open) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
-	ge25519 ALIGN(16) R, A;
+/* ed25519_unpacked_public_key must be able to hold a decompressed point */
+typedef char ed25519_unpacked_public_key_size_check[(sizeof(ge25519) <= sizeof(ed25519_unpacked_public_key)) ? 1 : -1];
+
+static int
+ed25519_sign_open_point(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ge25519 *A, const ed25519_signature RS) {
+	ge25519 ALIGN(16) R;
 	hash_512bits hash;
 	bignum256modm hram, S;
 	unsigned char checkR[32];
 
-	if ((RS[63] & 224) || !ge25519_unpack_negative_vartime(&A, pk))
-		return -1;
-
 	/* hram = H(R,A,m) */
 	ed25519_hram(hash, RS, pk, m, mlen);
 	expand256_modm(hram, hash, 64);
@@ -119,13 +119,51 @@ ED25519_FN(ed25519_sign_open) (const unsigned char *m, size_t mlen, const ed2551
 	expand256_modm(S, RS + 32, 32);
 
 	/* SB - H(R,A,m)A */
-	ge25519_double_scalarmult_vartime(&R, &A, hram, S);
+	ge25519_double_scalarmult_vartime(&R, A, hram, S);
 	ge25519_pack(checkR, &R);
 
 	/* check that R = SB - H(R,A,m)A */
 	return ed25519_verify(RS, checkR, 32) ? 0 : -1;
 }
 
+int
+ED25519_FN(ed25519_sign_open) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
+	ge25519 ALIGN(16) A;
+
+	if ((RS[63] & 224) || !ge25519_unpack_negative_vartime(&A, pk))
+		return -1;
+
+	return ed25519_sign_open_point(m, mlen, pk, &A, RS);
+}
+
+/*
+	Decompresses pk once so repeated verifications against it can skip the square root, returns 0 on success
+*/
+
+int
+ED25519_FN(ed25519_publickey_unpack) (const ed25519_public_key pk, ed25519_unpacked_public_key *unpacked) {
+	ge25519 ALIGN(16) A;
+
+	memset(unpacked, 0, sizeof(*unpacked));
+	if (!ge25519_unpack_negative_vartime(&A, pk))
+		return -1;
+
+	memcpy(unpacked->point, &A, sizeof(A));
+	return 0;
+}
+
+int
+ED25519_FN(ed25519_sign_open_unpacked) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_unpacked_public_key *unpacked, const ed25519_signature RS) {
+	ge25519 ALIGN(16) A;
+
+	if (RS[63] & 224)
+		return -1;
+
+	/* copy to aligned storage for the sse2 implementation */
+	memcpy(&A, unpacked->point, sizeof(A));
+	return ed25519_sign_open_point(m, mlen, pk, &A, RS);
+}
+
 #include "ed25519-donna-batchverify.h"
 
 /*
@@ -13,10 +13,18 @@ typedef unsigned char ed25519_secret_key[32];
 
 typedef unsigned char curved25519_key[32];
 
+/* public key with its curve point already decompressed, large enough for every ge25519 representation */
+typedef struct ed25519_unpacked_public_key_t {
+	unsigned long long point[24];
+} ed25519_unpacked_public_key;
+
 void ed25519_publickey(const ed25519_secret_key sk, ed25519_public_key pk);
 int ed25519_sign_open(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 void ed25519_sign(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
 
+int ed25519_publickey_unpack(const ed25519_public_key pk, ed25519_unpacked_public_key *unpacked);
+int ed25519_sign_open_unpacked(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_unpacked_public_key *unpacked, const ed25519_signature RS);
+
 int ed25519_sign_open_batch(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
 
 void ed25519_randombytes_unsafe(void *out, size_t count);
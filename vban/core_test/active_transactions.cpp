@@ -603,7 +603,7 @@ TEST (active_transactions, dropped_cleanup)
 
 	// Not yet removed
 	ASSERT_TRUE (node.network.publish_filter.apply (block_bytes.data (), block_bytes.size ()));
-	ASSERT_EQ (1, node.active.blocks.count (block->hash ()));
+	ASSERT_TRUE (node.active.active (block->hash ()));
 
 	// Now simulate dropping the election
 	ASSERT_FALSE (election->confirmed ());
@@ -616,7 +616,7 @@ TEST (active_transactions, dropped_cleanup)
 	ASSERT_EQ (1, node.stats.count (vban::stat::type::election, vban::stat::detail::election_drop_all));
 
 	// Block cleared from active
-	ASSERT_EQ (0, node.active.blocks.count (block->hash ()));
+	ASSERT_FALSE (node.active.active (block->hash ()));
 
 	// Repeat test for a confirmed election
 	ASSERT_TRUE (node.network.publish_filter.apply (block_bytes.data (), block_bytes.size ()));
@@ -635,7 +635,7 @@ TEST (active_transactions, dropped_cleanup)
 	ASSERT_EQ (1, node.stats.count (vban::stat::type::election, vban::stat::detail::election_drop_all));
 
 	// Block cleared from active
-	ASSERT_EQ (0, node.active.blocks.count (block->hash ()));
+	ASSERT_FALSE (node.active.active (block->hash ()));
 }
 
 TEST (active_transactions, republish_winner)
@@ -1530,3 +1530,72 @@ TEST (active_transactions, fifo)
 	// Ensure the surviving transaction is the least recently inserted
 	ASSERT_TIMELY (1s, node.active.election (receive1->qualified_root ()) != nullptr);
 }
+
+// Elections spread over several shards stay consistent while being looked up and erased from multiple threads
+TEST (active_transactions, sharded_concurrent_access)
+{
+	vban::system system;
+	vban::node_config config{ vban::get_available_port (), system.logging };
+	config.frontiers_confirmation = vban::frontiers_confirmation_mode::disabled;
+	auto & node = *system.add_node (config);
+	vban::state_block_builder builder;
+	std::vector<std::shared_ptr<vban::block>> blocks;
+	vban::block_hash previous (vban::genesis_hash);
+	for (auto i (1); i <= 32; ++i)
+	{
+		auto send = builder.make_block ()
+					.account (vban::dev_genesis_key.pub)
+					.previous (previous)
+					.representative (vban::dev_genesis_key.pub)
+					.link (vban::dev_genesis_key.pub)
+					.balance (vban::genesis_amount - i)
+					.sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+					.work (*system.work.generate (previous))
+					.build_shared ();
+		ASSERT_EQ (vban::process_result::progress, node.process (*send).code);
+		previous = send->hash ();
+		blocks.push_back (send);
+	}
+	vban::blocks_confirm (node, blocks);
+	ASSERT_EQ (blocks.size (), node.active.size ());
+	ASSERT_EQ (blocks.size (), node.active.blocks_size ());
+	// Elections are listed in insertion order regardless of the shard they live in
+	auto active (node.active.list_active ());
+	ASSERT_EQ (blocks.size (), active.size ());
+	for (size_t i (0); i < active.size (); ++i)
+	{
+		ASSERT_EQ (blocks[i]->hash (), active[i]->winner ()->hash ());
+	}
+	std::atomic<bool> done{ false };
+	std::vector<std::thread> readers;
+	for (auto i (0); i < 4; ++i)
+	{
+		readers.emplace_back ([&node, &blocks, &done] () {
+			while (!done)
+			{
+				for (auto const & block : blocks)
+				{
+					auto election (node.active.election (block->qualified_root ()));
+					if (election != nullptr)
+					{
+						ASSERT_EQ (block->hash (), election->winner ()->hash ());
+					}
+					node.active.active (block->hash ());
+				}
+				ASSERT_LE (node.active.list_active ().size (), blocks.size ());
+			}
+		});
+	}
+	for (auto const & block : blocks)
+	{
+		node.active.erase (*block);
+	}
+	done = true;
+	for (auto & reader : readers)
+	{
+		reader.join ();
+	}
+	ASSERT_TRUE (node.active.empty ());
+	ASSERT_EQ (0, node.active.blocks_size ());
+	ASSERT_TRUE (node.active.list_active ().empty ());
+}
@@ -22,6 +22,18 @@ TEST (ed25519, signing)
 	ASSERT_NE (0, valid2);
 }
 
+TEST (ed25519, signing_unpacked)
+{
+	vban::keypair key;
+	vban::uint256_union message (0);
+	auto signature (vban::sign_message (key.prv, key.pub, message));
+	ed25519_unpacked_public_key unpacked;
+	ASSERT_EQ (0, ed25519_publickey_unpack (key.pub.bytes.data (), &unpacked));
+	ASSERT_EQ (0, ed25519_sign_open_unpacked (message.bytes.data (), sizeof (message.bytes), key.pub.bytes.data (), &unpacked, signature.bytes.data ()));
+	signature.bytes[32] ^= 0x1;
+	ASSERT_NE (0, ed25519_sign_open_unpacked (message.bytes.data (), sizeof (message.bytes), key.pub.bytes.data (), &unpacked, signature.bytes.data ()));
+}
+
 TEST (transaction_block, empty)
 {
 	vban::keypair key1;
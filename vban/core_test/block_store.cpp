@@ -270,6 +270,34 @@ TEST (block_store, pending_iterator)
 	ASSERT_EQ (vban::epoch::epoch_1, pending.epoch);
 }
 
+TEST (block_store, pending_account_iterator)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	{
+		auto transaction (store->tx_begin_write ());
+		store->pending_put (transaction, vban::pending_key (vban::account (1), vban::block_hash (1)), vban::pending_info (vban::account (10), vban::amount (1), vban::epoch::epoch_0));
+		store->pending_put (transaction, vban::pending_key (vban::account (1), vban::block_hash (2)), vban::pending_info (vban::account (10), vban::amount (2), vban::epoch::epoch_0));
+		store->pending_put (transaction, vban::pending_key (vban::account (3), vban::block_hash (3)), vban::pending_info (vban::account (10), vban::amount (3), vban::epoch::epoch_0));
+	}
+	auto transaction (store->tx_begin_read ());
+	size_t count (0);
+	for (auto i (store->pending_begin (transaction, vban::account (1))), n (store->pending_end ()); i != n && i->first.account == vban::account (1); ++i)
+	{
+		++count;
+	}
+	ASSERT_EQ (2, count);
+	auto empty (store->pending_begin (transaction, vban::account (2)));
+	ASSERT_TRUE (empty == store->pending_end () || empty->first.account != vban::account (2));
+	// Seeking by key still continues across accounts
+	auto next (store->pending_begin (transaction, vban::pending_key (vban::account (2), 0)));
+	ASSERT_NE (store->pending_end (), next);
+	ASSERT_EQ (vban::account (3), next->first.account);
+	ASSERT_TRUE (store->pending_any (transaction, vban::account (3)));
+	ASSERT_FALSE (store->pending_any (transaction, vban::account (2)));
+}
+
 /**
  * Regression test for Issue 1164
  * This reconstructs the situation where a key is larger in pending than the account being iterated in pending_v1, leaving
@@ -715,6 +743,38 @@ TEST (mdb_block_store, bad_path)
 	ASSERT_TRUE (store.init_error ());
 }
 
+TEST (mdb_block_store, checkpoint)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	vban::logger_mt logger;
+	vban::lmdb_config lmdb_config;
+	lmdb_config.sync = vban::lmdb_config::sync_strategy::checkpoint;
+	// Only flushes on request
+	lmdb_config.checkpoint_interval = std::chrono::hours (1);
+	vban::mdb_store store (logger, vban::unique_path (), vban::txn_tracking_config{}, std::chrono::milliseconds (5000), lmdb_config);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_TRUE (store.checkpoint_get ().enabled);
+	auto committed_before (store.checkpoint_get ().committed);
+	for (auto i (0); i < 3; ++i)
+	{
+		auto transaction (store.tx_begin_write ());
+		store.confirmation_height_put (transaction, vban::account (i), vban::confirmation_height_info (1, vban::block_hash (i)));
+	}
+	auto checkpoint (store.checkpoint_get ());
+	ASSERT_EQ (committed_before + 3, checkpoint.committed);
+	ASSERT_LT (checkpoint.durable, checkpoint.committed);
+	ASSERT_FALSE (store.checkpoint_wait (std::chrono::seconds (5)));
+	auto checkpoint2 (store.checkpoint_get ());
+	ASSERT_EQ (checkpoint.committed, checkpoint2.durable);
+	ASSERT_NE (std::chrono::system_clock::time_point{}, checkpoint2.time);
+	// Nothing new to flush
+	ASSERT_FALSE (store.checkpoint_wait (std::chrono::milliseconds (0)));
+}
+
 TEST (block_store, DISABLED_already_open) // File can be shared
 {
 	auto path (vban::unique_path ());
@@ -874,6 +934,331 @@ TEST (block_store, account_count)
 	ASSERT_EQ (1, store->account_count (transaction));
 }
 
+TEST (block_store, account_cache)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	store->account_cache_memory_set (1024 * 1024);
+	auto account_hits = [&store] () {
+		auto info (store->collect_cache_info ("store_cache"));
+		auto & accounts (static_cast<vban::container_info_composite &> (*static_cast<vban::container_info_composite &> (*info).get_children ()[0]));
+		return static_cast<vban::container_info_leaf &> (*accounts.get_children ()[1]).get_info ().count;
+	};
+	vban::account account (200);
+	vban::account_info info1 (1, 2, 3, 4, 5, 6, vban::epoch::epoch_0);
+	vban::account_info info2 (7, 2, 3, 8, 9, 10, vban::epoch::epoch_1);
+	vban::account_info result;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->account_put (transaction, account, info1);
+		ASSERT_FALSE (store->account_get (transaction, account, result));
+		ASSERT_EQ (info1, result);
+		ASSERT_EQ (1, account_hits ());
+	}
+	// Read transactions keep their snapshot even after a newer value was written through the cache
+	auto read (store->tx_begin_read ());
+	{
+		auto transaction (store->tx_begin_write ());
+		store->account_put (transaction, account, info2);
+		ASSERT_FALSE (store->account_get (transaction, account, result));
+		ASSERT_EQ (info2, result);
+		store->confirmation_height_put (transaction, account, { 6, 1 });
+	}
+	ASSERT_FALSE (store->account_get (read, account, result));
+	ASSERT_EQ (info1, result);
+	read.refresh ();
+	ASSERT_FALSE (store->account_get (read, account, result));
+	ASSERT_EQ (info2, result);
+	ASSERT_EQ (2, account_hits ());
+	// Deletions and table drops invalidate the cache
+	{
+		auto transaction (store->tx_begin_write ());
+		store->account_del (transaction, account);
+		ASSERT_TRUE (store->account_get (transaction, account, result));
+		vban::confirmation_height_info confirmation_height_info;
+		ASSERT_FALSE (store->confirmation_height_get (transaction, account, confirmation_height_info));
+		ASSERT_EQ (6, confirmation_height_info.height);
+		store->confirmation_height_clear (transaction);
+		ASSERT_TRUE (store->confirmation_height_get (transaction, account, confirmation_height_info));
+		ASSERT_EQ (0, confirmation_height_info.height);
+	}
+	// Shrinking the budget evicts entries, disabling it falls back to the database
+	{
+		auto transaction (store->tx_begin_write ());
+		for (auto i (0); i < 1000; ++i)
+		{
+			store->account_put (transaction, vban::account (i), info1);
+		}
+		store->account_cache_memory_set (0);
+		ASSERT_FALSE (store->account_get (transaction, vban::account (999), result));
+		ASSERT_EQ (info1, result);
+	}
+	ASSERT_EQ (2, account_hits ());
+}
+
+TEST (block_store, block_cache)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	store->block_cache_size_set (1024);
+	auto block_hits = [&store] () {
+		auto info (store->collect_cache_info ("store_cache"));
+		auto & blocks (static_cast<vban::container_info_composite &> (*static_cast<vban::container_info_composite &> (*info).get_children ()[2]));
+		return static_cast<vban::container_info_leaf &> (*blocks.get_children ()[1]).get_info ().count;
+	};
+	vban::open_block block1 (0, 1, 0, vban::keypair ().prv, 0, 0);
+	block1.sideband_set ({});
+	vban::open_block block2 (0, 2, 0, vban::keypair ().prv, 0, 0);
+	block2.sideband_set ({});
+	auto transaction (store->tx_begin_write ());
+	store->block_put (transaction, block1.hash (), block1);
+	store->block_put (transaction, block2.hash (), block2);
+	auto block1_store (store->block_get (transaction, block1.hash ()));
+	ASSERT_NE (nullptr, block1_store);
+	ASSERT_EQ (0, block_hits ());
+	// Decoded blocks are shared between readers
+	ASSERT_EQ (block1_store, store->block_get (transaction, block1.hash ()));
+	ASSERT_EQ (1, block_hits ());
+	// Raw puts replace the cached block
+	auto modified_sideband = block1_store->sideband ();
+	modified_sideband.successor = block2.hash ();
+	block1.sideband_set (modified_sideband);
+	store->block_put (transaction, block1.hash (), block1);
+	auto block1_successor (store->block_get (transaction, block1.hash ()));
+	ASSERT_NE (block1_store, block1_successor);
+	ASSERT_EQ (block2.hash (), block1_successor->sideband ().successor);
+	ASSERT_EQ (1, block_hits ());
+	store->block_successor_clear (transaction, block1.hash ());
+	ASSERT_EQ (0, store->block_get (transaction, block1.hash ())->sideband ().successor.number ());
+	store->block_del (transaction, block1.hash ());
+	ASSERT_EQ (nullptr, store->block_get (transaction, block1.hash ()));
+	ASSERT_EQ (1, block_hits ());
+}
+
+TEST (block_store, block_view)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::keypair key1;
+	std::vector<std::shared_ptr<vban::block>> blocks;
+	blocks.push_back (std::make_shared<vban::send_block> (1, 2, 3, key1.prv, key1.pub, 4));
+	blocks.push_back (std::make_shared<vban::receive_block> (5, 6, key1.prv, key1.pub, 7));
+	blocks.push_back (std::make_shared<vban::open_block> (8, 9, key1.pub, key1.prv, key1.pub, 10));
+	blocks.push_back (std::make_shared<vban::change_block> (11, 12, key1.prv, key1.pub, 13));
+	blocks.push_back (std::make_shared<vban::state_block> (key1.pub, 14, 15, 16, 17, key1.prv, key1.pub, 18));
+	auto transaction (store->tx_begin_write ());
+	ASSERT_FALSE (store->block_get_view (transaction, blocks[0]->hash ()));
+	uint64_t height (1);
+	for (auto & block : blocks)
+	{
+		block->sideband_set (vban::block_sideband (key1.pub, height + 100, height + 200, height, height + 300, vban::epoch::epoch_1, true, false, false, vban::epoch::epoch_0));
+		store->block_put (transaction, block->hash (), *block);
+		++height;
+	}
+	for (auto & block : blocks)
+	{
+		auto view (store->block_get_view (transaction, block->hash ()));
+		ASSERT_TRUE (view);
+		ASSERT_EQ (block->type (), view.type ());
+		ASSERT_EQ (block->hash (), view.hash ());
+		ASSERT_EQ (key1.pub, view.account ());
+		ASSERT_EQ (block->previous (), view.previous ());
+		ASSERT_EQ (block->representative (), view.representative ());
+		ASSERT_EQ (store->block_balance_calculated (block), view.balance ().number ());
+		ASSERT_EQ (block->link (), view.link ());
+		ASSERT_EQ (block->source (), view.source ());
+		ASSERT_EQ (block->destination (), view.destination ());
+		auto stored (store->block_get (transaction, block->hash ()));
+		ASSERT_EQ (stored->sideband ().successor, view.successor ());
+		ASSERT_EQ (stored->sideband ().height, view.height ());
+		ASSERT_EQ (stored->sideband ().timestamp, view.sideband ().timestamp);
+		ASSERT_EQ (*stored, *view.block ());
+		std::vector<uint8_t> expected;
+		std::vector<uint8_t> serialized;
+		{
+			vban::vectorstream stream (expected);
+			vban::serialize_block (stream, *block);
+		}
+		{
+			vban::vectorstream stream (serialized);
+			view.serialize (stream);
+		}
+		ASSERT_EQ (expected, serialized);
+	}
+	size_t count (0);
+	for (auto i (store->block_views_begin (transaction)), n (store->block_views_end ()); i != n; ++i, ++count)
+	{
+		ASSERT_EQ (i->first, i->second.hash ());
+	}
+	ASSERT_EQ (blocks.size (), count);
+}
+
+TEST (block_store, compact_state_blocks)
+{
+	vban::logger_mt logger;
+	auto path (vban::unique_path ());
+	vban::keypair key1;
+	vban::state_block block1 (key1.pub, 0, vban::account (10), 0, vban::account (1), key1.prv, key1.pub, 0);
+	block1.sideband_set ({});
+	vban::state_block block2 (key1.pub, block1.hash (), vban::account (11), vban::amount (100), vban::account (2), key1.prv, key1.pub, 0);
+	block2.sideband_set ({});
+	vban::state_block block3 (key1.pub, block2.hash (), vban::account (10), vban::amount (std::numeric_limits<vban::uint128_t>::max ()), vban::account (3), key1.prv, key1.pub, 0);
+	block3.sideband_set ({});
+	vban::open_block block4 (0, 1, 0, vban::keypair ().prv, 0, 0);
+	block4.sideband_set ({});
+	{
+		auto store = vban::make_store (logger, path);
+		ASSERT_FALSE (store->init_error ());
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block1.hash (), block1);
+		store->block_put (transaction, block2.hash (), block2);
+		store->block_put (transaction, block3.hash (), block3);
+		store->block_put (transaction, block4.hash (), block4);
+		// Successor updates rewrite the compact previous entries
+		ASSERT_EQ (block2.hash (), store->block_successor (transaction, block1.hash ()));
+		ASSERT_EQ (block3.hash (), store->block_successor (transaction, block2.hash ()));
+		store->block_successor_clear (transaction, block2.hash ());
+		ASSERT_TRUE (store->block_successor (transaction, block2.hash ()).is_zero ());
+		ASSERT_EQ (block2, *store->block_get (transaction, block2.hash ()));
+	}
+	// The representatives are loaded again when the store is opened
+	auto store = vban::make_store (logger, path);
+	ASSERT_FALSE (store->init_error ());
+	auto transaction (store->tx_begin_read ());
+	for (auto const & block : std::vector<vban::block const *>{ &block1, &block2, &block3, &block4 })
+	{
+		auto stored (store->block_get (transaction, block->hash ()));
+		ASSERT_NE (nullptr, stored);
+		ASSERT_EQ (*block, *stored);
+		ASSERT_TRUE (store->block_exists (transaction, block->hash ()));
+		auto view (store->block_get_view (transaction, block->hash ()));
+		ASSERT_EQ (block->representative (), view.representative ());
+		ASSERT_EQ (block->hash (), view.hash ());
+	}
+	ASSERT_EQ (block3.balance (), store->block_get_view (transaction, block3.hash ()).balance ());
+	size_t count (0);
+	for (auto i (store->block_views_begin (transaction)), n (store->block_views_end ()); i != n; ++i, ++count)
+	{
+		ASSERT_EQ (i->first, i->second.hash ());
+		ASSERT_NE (nullptr, store->block_get (transaction, i->first));
+		ASSERT_EQ (*store->block_get (transaction, i->first), *i->second.block ());
+	}
+	ASSERT_EQ (4, count);
+}
+
+TEST (block_store, compact_state_encoding)
+{
+	vban::keypair key1;
+	vban::state_block block (key1.pub, 1, key1.pub, vban::amount (300), 2, key1.prv, key1.pub, 3);
+	block.sideband_set ({});
+	std::vector<uint8_t> data;
+	{
+		vban::vectorstream stream (data);
+		vban::serialize_block (stream, block);
+		block.sideband ().serialize (stream, block.type ());
+	}
+	vban::account representative;
+	ASSERT_TRUE (vban::block_encoding::compactable (data, representative));
+	ASSERT_EQ (key1.pub, representative);
+	vban::representative_dictionary dictionary;
+	dictionary.insert (0, 1);
+	dictionary.insert (1, key1.pub);
+	std::vector<uint8_t> compact;
+	vban::block_encoding::compact (data, 1, compact);
+	ASSERT_TRUE (vban::block_encoding::is_compact (compact.data (), compact.size ()));
+	ASSERT_FALSE (vban::block_encoding::is_compact (data.data (), data.size ()));
+	// One byte for the representative id and two for the balance instead of 32 and 16
+	ASSERT_EQ (data.size () - sizeof (vban::account) - sizeof (vban::amount) + 3, compact.size ());
+	ASSERT_EQ (data, *vban::block_encoding::expand (compact.data (), compact.size (), dictionary));
+	// Views read compact entries in place
+	vban::block_view view (compact.data (), compact.size (), nullptr, &dictionary);
+	ASSERT_EQ (vban::block_type::state, view.type ());
+	ASSERT_EQ (block.hash (), view.hash ());
+	ASSERT_EQ (block.representative (), view.representative ());
+	ASSERT_EQ (block.balance (), view.balance ());
+	ASSERT_EQ (block.link (), view.link ());
+	ASSERT_EQ (block, *view.block ());
+	std::vector<uint8_t> serialized;
+	{
+		vban::vectorstream stream (serialized);
+		view.serialize (stream);
+	}
+	ASSERT_EQ (std::vector<uint8_t> (data.begin (), data.end () - vban::block_sideband::size (vban::block_type::state)), serialized);
+	uint64_t id;
+	ASSERT_FALSE (dictionary.find (key1.pub, id));
+	ASSERT_EQ (1, id);
+	ASSERT_TRUE (dictionary.find (2, id));
+	ASSERT_EQ (2, dictionary.next ());
+}
+
+TEST (block_store, compact_state_balance)
+{
+	vban::keypair key1;
+	vban::representative_dictionary dictionary;
+	dictionary.insert (0, key1.pub);
+	auto serialize = [] (vban::state_block const & block_a) {
+		std::vector<uint8_t> result;
+		vban::vectorstream stream (result);
+		vban::serialize_block (stream, block_a);
+		block_a.sideband ().serialize (stream, block_a.type ());
+		return result;
+	};
+	// Balances below 2^112 fit 16 varint bytes, larger ones keep the fixed 16 bytes
+	for (auto balance : { vban::uint128_t (0), (vban::uint128_t (1) << 112) - 1, vban::uint128_t (1) << 112, std::numeric_limits<vban::uint128_t>::max () })
+	{
+		vban::state_block block (key1.pub, 1, key1.pub, vban::amount (balance), 2, key1.prv, key1.pub, 3);
+		block.sideband_set ({});
+		auto data (serialize (block));
+		std::vector<uint8_t> compact;
+		vban::block_encoding::compact (data, 0, compact);
+		ASSERT_LE (compact.size (), data.size () - sizeof (vban::account) + 1);
+		ASSERT_EQ (balance >= (vban::uint128_t (1) << 112), compact[0] == vban::block_encoding::compact_state_fixed_balance);
+		ASSERT_EQ (data, *vban::block_encoding::expand (compact.data (), compact.size (), dictionary));
+		vban::block_view view (compact.data (), compact.size (), nullptr, &dictionary);
+		ASSERT_EQ (block.balance (), view.balance ());
+		ASSERT_EQ (block.hash (), view.hash ());
+	}
+}
+
+TEST (block_store, compact_state_corrupt)
+{
+	vban::keypair key1;
+	vban::state_block block (key1.pub, 1, key1.pub, vban::amount (300), 2, key1.prv, key1.pub, 3);
+	block.sideband_set ({});
+	std::vector<uint8_t> data;
+	{
+		vban::vectorstream stream (data);
+		vban::serialize_block (stream, block);
+		block.sideband ().serialize (stream, block.type ());
+	}
+	vban::representative_dictionary dictionary;
+	dictionary.insert (0, key1.pub);
+	std::vector<uint8_t> compact;
+	vban::block_encoding::compact (data, 0, compact);
+	vban::block_encoding::compact_fields fields;
+	ASSERT_FALSE (vban::block_encoding::decode (compact.data (), compact.size (), fields));
+	// Truncated entries
+	ASSERT_TRUE (vban::block_encoding::decode (compact.data (), vban::block_encoding::representative_offset + 1, fields));
+	ASSERT_TRUE (vban::block_encoding::decode (compact.data (), compact.size () - 1, fields));
+	ASSERT_EQ (nullptr, vban::block_encoding::expand (compact.data (), compact.size () - 1, dictionary));
+	// Unknown representative id
+	std::vector<uint8_t> unknown;
+	vban::block_encoding::compact (data, 1, unknown);
+	ASSERT_FALSE (vban::block_encoding::decode (unknown.data (), unknown.size (), fields));
+	ASSERT_EQ (nullptr, vban::block_encoding::expand (unknown.data (), unknown.size (), dictionary));
+	// Representative ids overflowing 64 bits, either in the last byte or with too many bytes
+	for (auto const & id : { std::vector<uint8_t>{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02 }, std::vector<uint8_t>{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 } })
+	{
+		std::vector<uint8_t> overflow (compact.begin (), compact.begin () + vban::block_encoding::representative_offset);
+		overflow.insert (overflow.end (), id.begin (), id.end ());
+		overflow.insert (overflow.end (), compact.begin () + vban::block_encoding::representative_offset + 1, compact.end ());
+		ASSERT_TRUE (vban::block_encoding::decode (overflow.data (), overflow.size (), fields));
+	}
+}
+
 TEST (block_store, cemented_count_cache)
 {
 	vban::logger_mt logger;
@@ -1570,10 +1955,11 @@ TEST (mdb_block_store, upgrade_v17_v18)
 	ASSERT_FALSE (store.init_error ());
 	auto transaction (store.tx_begin_read ());
 
-	// Size of state block should equal that set in db (no change)
+	// State blocks end up in the compact format
 	vban::mdb_val value;
 	ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks, vban::mdb_val (state_send.hash ()), value));
-	ASSERT_EQ (value.size (), sizeof (vban::block_type) + vban::state_block::size + vban::block_sideband::size (vban::block_type::state));
+	ASSERT_TRUE (vban::block_encoding::is_compact (static_cast<uint8_t const *> (value.data ()), value.size ()));
+	ASSERT_LT (value.size (), sizeof (vban::block_type) + vban::state_block::size + vban::block_sideband::size (vban::block_type::state));
 
 	// Check that sidebands are correctly populated
 	{
@@ -1842,6 +2228,150 @@ TEST (mdb_block_store, upgrade_v20_v21)
 	ASSERT_LT (19, store.version_get (transaction));
 }
 
+TEST (mdb_block_store, upgrade_v21_v22)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (vban::unique_path ());
+	vban::genesis genesis;
+	vban::logger_mt logger;
+	vban::stat stats;
+	{
+		vban::mdb_store store (logger, path);
+		vban::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		// Delete account_heights table
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.account_heights, 1));
+		store.version_put (transaction, 21);
+	}
+	// Upgrading should create the table
+	vban::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.account_heights, 0);
+
+	// Version should be correct, the new index starts out incomplete
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (21, store.version_get (transaction));
+	ASSERT_FALSE (store.account_heights_complete (transaction));
+}
+
+TEST (mdb_block_store, upgrade_v22_v23)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (vban::unique_path ());
+	vban::genesis genesis;
+	vban::logger_mt logger;
+	vban::stat stats;
+	{
+		vban::mdb_store store (logger, path);
+		vban::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		// Delete delegators table
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.delegators, 1));
+		store.version_put (transaction, 22);
+	}
+	// Upgrading should create the table
+	vban::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.delegators, 0);
+
+	// Version should be correct, the new index starts out incomplete
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (22, store.version_get (transaction));
+	ASSERT_FALSE (store.delegators_complete (transaction));
+}
+
+TEST (mdb_block_store, upgrade_v23_v24)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (vban::unique_path ());
+	vban::genesis genesis;
+	vban::logger_mt logger;
+	vban::stat stats;
+	{
+		vban::mdb_store store (logger, path);
+		vban::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		// Delete pending_summary table
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.pending_summary, 1));
+		store.version_put (transaction, 23);
+	}
+	// Upgrading should create the table
+	vban::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.pending_summary, 0);
+
+	// Version should be correct, the new index starts out incomplete
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (23, store.version_get (transaction));
+	ASSERT_FALSE (store.pending_summary_complete (transaction));
+}
+
+TEST (mdb_block_store, upgrade_v24_v25)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (vban::unique_path ());
+	vban::genesis genesis;
+	vban::logger_mt logger;
+	vban::stat stats;
+	vban::keypair key1;
+	vban::state_block state_send (vban::dev_genesis_key.pub, genesis.hash (), key1.pub, vban::genesis_amount - vban::Gxrb_ratio, key1.pub, vban::dev_genesis_key.prv, vban::dev_genesis_key.pub, 0);
+	state_send.sideband_set (vban::block_sideband (vban::dev_genesis_key.pub, 0, vban::genesis_amount - vban::Gxrb_ratio, 2, vban::seconds_since_epoch (), vban::epoch::epoch_0, true, false, false, vban::epoch::epoch_0));
+	std::vector<uint8_t> classic;
+	{
+		vban::vectorstream stream (classic);
+		vban::serialize_block (stream, state_send);
+		state_send.sideband ().serialize (stream, state_send.type ());
+	}
+	{
+		vban::mdb_store store (logger, path);
+		vban::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		// Write the state block in the format used before v25 and delete the representatives table
+		ASSERT_FALSE (mdb_put (store.env.tx (transaction), store.blocks, vban::mdb_val (state_send.hash ()), vban::mdb_val (classic.size (), classic.data ()), 0));
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.representatives, 1));
+		store.version_put (transaction, 24);
+	}
+	// Upgrading should create the table and rewrite state blocks
+	vban::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.representatives, 0);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (24, store.version_get (transaction));
+	ASSERT_EQ (1, store.count (transaction, store.representatives));
+	vban::mdb_val value;
+	ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks, vban::mdb_val (state_send.hash ()), value));
+	ASSERT_TRUE (vban::block_encoding::is_compact (static_cast<uint8_t const *> (value.data ()), value.size ()));
+	ASSERT_LT (value.size (), classic.size ());
+	auto block (store.block_get (transaction, state_send.hash ()));
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (state_send, *block);
+	ASSERT_EQ (state_send.sideband ().height, block->sideband ().height);
+	// Other block types are left as they are
+	ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks, vban::mdb_val (genesis.hash ()), value));
+	ASSERT_FALSE (vban::block_encoding::is_compact (static_cast<uint8_t const *> (value.data ()), value.size ()));
+	ASSERT_EQ (*genesis.open, *store.block_get (transaction, genesis.hash ()));
+}
+
 TEST (mdb_block_store, upgrade_backup)
 {
 	if (vban::using_rocksdb_in_tests ())
@@ -1959,6 +2489,50 @@ TEST (block_store, final_vote)
 	}
 }
 
+TEST (block_store, account_heights)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	vban::account account1 (1);
+	vban::account account2 (2);
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_FALSE (store->account_heights_complete (transaction));
+		store->account_height_put (transaction, account1, 256, vban::block_hash (3));
+		store->account_height_put (transaction, account1, 2, vban::block_hash (2));
+		store->account_height_put (transaction, account1, 1, vban::block_hash (1));
+		store->account_height_put (transaction, account2, 1, vban::block_hash (4));
+		store->account_heights_complete_set (transaction, true);
+	}
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_TRUE (store->account_heights_complete (transaction));
+		ASSERT_EQ (vban::block_hash (2), store->account_height_get (transaction, account1, 2));
+		ASSERT_TRUE (store->account_height_get (transaction, account1, 3).is_zero ());
+		// Entries of an account are ordered by height
+		auto i (store->account_heights_begin (transaction, vban::account_height_key (account1, 2)));
+		ASSERT_NE (store->account_heights_end (), i);
+		ASSERT_EQ (account1, i->first.account ());
+		ASSERT_EQ (2, i->first.height ());
+		++i;
+		ASSERT_NE (store->account_heights_end (), i);
+		ASSERT_EQ (256, i->first.height ());
+		ASSERT_EQ (vban::block_hash (3), i->second);
+		++i;
+		ASSERT_NE (store->account_heights_end (), i);
+		ASSERT_EQ (account2, i->first.account ());
+		ASSERT_EQ (1, i->first.height ());
+		store->account_height_del (transaction, account1, 2);
+		ASSERT_TRUE (store->account_height_get (transaction, account1, 2).is_zero ());
+		store->account_heights_complete_set (transaction, false);
+		store->account_heights_clear (transaction);
+	}
+	auto transaction (store->tx_begin_read ());
+	ASSERT_FALSE (store->account_heights_complete (transaction));
+	ASSERT_EQ (store->account_heights_end (), store->account_heights_begin (transaction, vban::account_height_key (vban::account (0), 0)));
+}
+
 // Ledger versions are not forward compatible
 TEST (block_store, incompatible_version)
 {
@@ -2054,6 +2628,83 @@ TEST (rocksdb_block_store, tombstone_count)
 		ASSERT_EQ (store->tombstone_map.at (vban::tables::unchecked).num_since_last_flush.load (), 1);
 	}
 }
+
+TEST (rocksdb_block_store, bulk_ingest)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		vban::logger_mt logger;
+		auto store = std::make_unique<vban::rocksdb_store> (logger, vban::unique_path ());
+		ASSERT_TRUE (!store->init_error ());
+		vban::account_info info1 (1, 2, 3, 4, 5, 6, vban::epoch::epoch_0);
+		vban::account_info info2 (7, 8, 9, 10, 11, 12, vban::epoch::epoch_1);
+		std::vector<std::unique_ptr<vban::bulk_writer>> writers;
+		// Writers cover separate key ranges, one of them stays empty
+		writers.push_back (store->bulk_writer_make (vban::tables::accounts));
+		writers.push_back (store->bulk_writer_make (vban::tables::accounts));
+		writers.push_back (store->bulk_writer_make (vban::tables::pending));
+		writers[0]->account_put (vban::account (1), info1);
+		writers[0]->account_put (vban::account (2), info2);
+		writers[1]->account_put (vban::account (3), info1);
+		for (auto const & writer : writers)
+		{
+			ASSERT_FALSE (writer->finish ());
+		}
+		ASSERT_FALSE (store->bulk_ingest (writers));
+		auto transaction (store->tx_begin_read ());
+		ASSERT_EQ (3, store->account_count (transaction));
+		vban::account_info info;
+		ASSERT_FALSE (store->account_get (transaction, vban::account (2), info));
+		ASSERT_EQ (info2, info);
+		ASSERT_FALSE (store->account_get (transaction, vban::account (3), info));
+		ASSERT_EQ (info1, info);
+		ASSERT_EQ (store->pending_end (), store->pending_begin (transaction));
+	}
+}
+
+TEST (rocksdb_block_store, upgrade_v24_v25)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		auto path (vban::unique_path ());
+		vban::genesis genesis;
+		vban::logger_mt logger;
+		vban::stat stats;
+		vban::keypair key1;
+		vban::state_block state_send (vban::dev_genesis_key.pub, genesis.hash (), key1.pub, vban::genesis_amount - vban::Gxrb_ratio, key1.pub, vban::dev_genesis_key.prv, vban::dev_genesis_key.pub, 0);
+		state_send.sideband_set (vban::block_sideband (vban::dev_genesis_key.pub, 0, vban::genesis_amount - vban::Gxrb_ratio, 2, vban::seconds_since_epoch (), vban::epoch::epoch_0, true, false, false, vban::epoch::epoch_0));
+		std::vector<uint8_t> classic;
+		{
+			vban::vectorstream stream (classic);
+			vban::serialize_block (stream, state_send);
+			state_send.sideband ().serialize (stream, state_send.type ());
+		}
+		{
+			vban::rocksdb_store store (logger, path);
+			ASSERT_FALSE (store.init_error ());
+			vban::ledger ledger (store, stats);
+			auto transaction (store.tx_begin_write ());
+			store.initialize (transaction, genesis, ledger.cache);
+			// Write the state block in the format used before v25
+			ASSERT_FALSE (store.put (transaction, vban::tables::blocks, state_send.hash (), vban::rocksdb_val{ classic.size (), classic.data () }));
+			store.version_put (transaction, 24);
+		}
+		// Opening the store rewrites state blocks
+		vban::rocksdb_store store (logger, path);
+		ASSERT_FALSE (store.init_error ());
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (25, store.version_get (transaction));
+		ASSERT_EQ (1, store.count (transaction, vban::tables::representatives));
+		vban::rocksdb_val value;
+		ASSERT_FALSE (store.get (transaction, vban::tables::blocks, state_send.hash (), value));
+		ASSERT_TRUE (vban::block_encoding::is_compact (static_cast<uint8_t const *> (value.data ()), value.size ()));
+		ASSERT_LT (value.size (), classic.size ());
+		auto block (store.block_get (transaction, state_send.hash ()));
+		ASSERT_NE (nullptr, block);
+		ASSERT_EQ (state_send, *block);
+		ASSERT_EQ (*genesis.open, *store.block_get (transaction, genesis.hash ()));
+	}
+}
 }
 
 namespace
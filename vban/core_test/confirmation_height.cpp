@@ -255,7 +255,7 @@ TEST (confirmation_height, gap_bootstrap)
 		// Confirmation heights should not be updated
 		{
 			auto transaction (node1.store.tx_begin_read ());
-			auto unchecked_count (node1.store.unchecked_count (transaction));
+			auto unchecked_count (node1.unchecked.count (transaction));
 			ASSERT_EQ (unchecked_count, 2);
 
 			vban::confirmation_height_info confirmation_height_info;
@@ -271,7 +271,7 @@ TEST (confirmation_height, gap_bootstrap)
 		// Confirmation height should be unchanged and unchecked should now be 0
 		{
 			auto transaction (node1.store.tx_begin_read ());
-			auto unchecked_count (node1.store.unchecked_count (transaction));
+			auto unchecked_count (node1.unchecked.count (transaction));
 			ASSERT_EQ (unchecked_count, 0);
 
 			vban::confirmation_height_info confirmation_height_info;
@@ -358,7 +358,7 @@ TEST (confirmation_height, gap_live)
 
 		// This should confirm the open block and the source of the receive blocks
 		auto transaction (node->store.tx_begin_read ());
-		auto unchecked_count (node->store.unchecked_count (transaction));
+		auto unchecked_count (node->unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
 
 		vban::confirmation_height_info confirmation_height_info;
@@ -1008,10 +1008,7 @@ TEST (confirmation_height, callback_confirmed_history)
 			election->force_confirm ();
 			ASSERT_TIMELY (10s, node->active.size () == 0);
 			ASSERT_EQ (0, node->active.list_recently_cemented ().size ());
-			{
-				vban::lock_guard<vban::mutex> guard (node->active.mutex);
-				ASSERT_EQ (0, node->active.blocks.size ());
-			}
+			ASSERT_EQ (0, node->active.blocks_size ());
 
 			auto transaction = node->store.tx_begin_read ();
 			ASSERT_FALSE (node->ledger.block_confirmed (transaction, send->hash ()));
@@ -1031,7 +1028,7 @@ TEST (confirmation_height, callback_confirmed_history)
 		ASSERT_TIMELY (10s, node->stats.count (vban::stat::type::confirmation_observer, vban::stat::detail::active_quorum, vban::stat::dir::out) == 1);
 
 		ASSERT_EQ (1, node->active.list_recently_cemented ().size ());
-		ASSERT_EQ (0, node->active.blocks.size ());
+		ASSERT_EQ (0, node->active.blocks_size ());
 
 		// Confirm the callback is not called under this circumstance
 		ASSERT_EQ (2, node->stats.count (vban::stat::type::http_callback, vban::stat::detail::http_callback, vban::stat::dir::out));
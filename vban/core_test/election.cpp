@@ -258,3 +258,189 @@ TEST (election, quorum_minimum_update_weight_before_quorum_checks)
 	ASSERT_TRUE (election->confirmed ());
 }
 }
+
+TEST (election, incremental_tally)
+{
+	vban::system system;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.online_weight_minimum = vban::genesis_amount;
+	node_config.frontiers_confirmation = vban::frontiers_confirmation_mode::disabled;
+	auto & node1 = *system.add_node (node_config);
+	vban::keypair key1;
+	vban::keypair key2;
+	vban::block_builder builder;
+	auto send1 = builder.state ()
+				 .account (vban::dev_genesis_key.pub)
+				 .previous (vban::genesis_hash)
+				 .representative (vban::dev_genesis_key.pub)
+				 .balance (vban::genesis_amount - 100)
+				 .link (key1.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*system.work.generate (vban::genesis_hash))
+				 .build_shared ();
+	auto open1 = builder.state ()
+				 .account (key1.pub)
+				 .previous (0)
+				 .representative (key1.pub)
+				 .balance (100)
+				 .link (send1->hash ())
+				 .sign (key1.prv, key1.pub)
+				 .work (*system.work.generate (key1.pub))
+				 .build_shared ();
+	auto send2 = builder.state ()
+				 .account (vban::dev_genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (vban::dev_genesis_key.pub)
+				 .balance (vban::genesis_amount - 300)
+				 .link (key2.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .build_shared ();
+	auto open2 = builder.state ()
+				 .account (key2.pub)
+				 .previous (0)
+				 .representative (key2.pub)
+				 .balance (200)
+				 .link (send2->hash ())
+				 .sign (key2.prv, key2.pub)
+				 .work (*system.work.generate (key2.pub))
+				 .build_shared ();
+	auto fork1 = builder.state ()
+				 .account (vban::dev_genesis_key.pub)
+				 .previous (send2->hash ())
+				 .representative (vban::dev_genesis_key.pub)
+				 .balance (vban::genesis_amount - 301)
+				 .link (key1.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*system.work.generate (send2->hash ()))
+				 .build_shared ();
+	auto fork2 = builder.state ()
+				 .account (vban::dev_genesis_key.pub)
+				 .previous (send2->hash ())
+				 .representative (vban::dev_genesis_key.pub)
+				 .balance (vban::genesis_amount - 301)
+				 .link (key2.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*system.work.generate (send2->hash ()))
+				 .build_shared ();
+	for (auto const & block : { send1, open1, send2, open2, fork1 })
+	{
+		ASSERT_EQ (vban::process_result::progress, node1.process (*block).code);
+	}
+	node1.block_confirm (fork1);
+	auto election = node1.active.election (fork1->qualified_root ());
+	ASSERT_NE (nullptr, election);
+	ASSERT_FALSE (election->publish (fork2));
+	ASSERT_TRUE (election->vote (key1.pub, 1, fork1->hash ()).processed);
+	ASSERT_TRUE (election->vote (key2.pub, 1, fork2->hash ()).processed);
+	auto tally1 (election->tally ());
+	ASSERT_EQ (2, tally1.size ());
+	ASSERT_EQ (200, tally1.begin ()->first);
+	ASSERT_EQ (fork2, tally1.begin ()->second);
+	ASSERT_EQ (100, tally1.rbegin ()->first);
+	// Replacing a vote moves its weight to the new candidate, fork1 keeps the initial zero weight vote
+	ASSERT_TRUE (election->vote (key1.pub, std::numeric_limits<uint64_t>::max (), fork2->hash ()).processed);
+	auto tally2 (election->tally ());
+	ASSERT_EQ (2, tally2.size ());
+	ASSERT_EQ (300, tally2.begin ()->first);
+	ASSERT_EQ (fork2, tally2.begin ()->second);
+	ASSERT_EQ (0, tally2.rbegin ()->first);
+	ASSERT_EQ (100, election->current_status ().status.final_tally.number ());
+	// Weight changes are picked up by the next tally
+	node1.ledger.cache.rep_weights.representation_add (key2.pub, 50);
+	auto tally3 (election->tally ());
+	ASSERT_EQ (2, tally3.size ());
+	ASSERT_EQ (350, tally3.begin ()->first);
+	ASSERT_FALSE (election->confirmed ());
+}
+
+TEST (election, tally_weight_changes)
+{
+	vban::system system;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.online_weight_minimum = vban::genesis_amount;
+	node_config.frontiers_confirmation = vban::frontiers_confirmation_mode::disabled;
+	auto & node1 = *system.add_node (node_config);
+	vban::keypair key1;
+	vban::keypair key2;
+	vban::keypair key3;
+	vban::block_builder builder;
+	auto send1 = builder.state ()
+				 .account (vban::dev_genesis_key.pub)
+				 .previous (vban::genesis_hash)
+				 .representative (vban::dev_genesis_key.pub)
+				 .balance (vban::genesis_amount - 100)
+				 .link (key1.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*system.work.generate (vban::genesis_hash))
+				 .build_shared ();
+	auto open1 = builder.state ()
+				 .account (key1.pub)
+				 .previous (0)
+				 .representative (key1.pub)
+				 .balance (100)
+				 .link (send1->hash ())
+				 .sign (key1.prv, key1.pub)
+				 .work (*system.work.generate (key1.pub))
+				 .build_shared ();
+	auto send2 = builder.state ()
+				 .account (vban::dev_genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (vban::dev_genesis_key.pub)
+				 .balance (vban::genesis_amount - 300)
+				 .link (key2.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .build_shared ();
+	auto open2 = builder.state ()
+				 .account (key2.pub)
+				 .previous (0)
+				 .representative (key2.pub)
+				 .balance (200)
+				 .link (send2->hash ())
+				 .sign (key2.prv, key2.pub)
+				 .work (*system.work.generate (key2.pub))
+				 .build_shared ();
+	auto send3 = builder.state ()
+				 .account (vban::dev_genesis_key.pub)
+				 .previous (send2->hash ())
+				 .representative (vban::dev_genesis_key.pub)
+				 .balance (vban::genesis_amount - 301)
+				 .link (key3.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*system.work.generate (send2->hash ()))
+				 .build_shared ();
+	for (auto const & block : { send1, open1, send2, open2, send3 })
+	{
+		ASSERT_EQ (vban::process_result::progress, node1.process (*block).code);
+	}
+	node1.block_confirm (send3);
+	auto election = node1.active.election (send3->qualified_root ());
+	ASSERT_NE (nullptr, election);
+	auto & rep_weights (node1.ledger.cache.rep_weights);
+	ASSERT_TRUE (election->vote (key1.pub, 1, send3->hash ()).processed);
+	ASSERT_EQ (100, election->tally ().begin ()->first);
+	auto rebuilds (node1.stats.count (vban::stat::type::election, vban::stat::detail::tally_rebuild));
+	// Weights written between votes by representatives which are not voting leave the sums as they are
+	rep_weights.representation_add (key3.pub, 10);
+	ASSERT_TRUE (election->vote (key2.pub, 1, send3->hash ()).processed);
+	rep_weights.representation_add (key3.pub, 10);
+	ASSERT_EQ (300, election->tally ().begin ()->first);
+	// Changes of voting representatives only refresh their own weight
+	rep_weights.representation_add (key1.pub, 50);
+	ASSERT_TRUE (election->vote (key2.pub, std::numeric_limits<uint64_t>::max (), send3->hash ()).processed);
+	rep_weights.representation_add (key2.pub, 25);
+	ASSERT_TRUE (election->vote (key1.pub, std::numeric_limits<uint64_t>::max (), send3->hash ()).processed);
+	ASSERT_EQ (375, election->tally ().begin ()->first);
+	ASSERT_EQ (375, election->current_status ().status.final_tally.number ());
+	ASSERT_EQ (rebuilds, node1.stats.count (vban::stat::type::election, vban::stat::detail::tally_rebuild));
+	// Once more changes happened than are recorded the sums are rebuilt
+	for (auto i (0); i < 5000; ++i)
+	{
+		rep_weights.representation_add (key3.pub, 1);
+	}
+	rep_weights.representation_add (key1.pub, 50);
+	ASSERT_EQ (425, election->tally ().begin ()->first);
+	ASSERT_EQ (rebuilds + 1, node1.stats.count (vban::stat::type::election, vban::stat::detail::tally_rebuild));
+	ASSERT_FALSE (election->confirmed ());
+}
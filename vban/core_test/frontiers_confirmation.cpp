@@ -172,7 +172,7 @@ TEST (frontiers_confirmation, prioritize_frontiers_max_optimistic_elections)
 		node->active.frontiers_confirmation (lk);
 	}
 
-	ASSERT_EQ (max_optimistic_election_count, node->active.roots.size ());
+	ASSERT_EQ (max_optimistic_election_count, node->active.size ());
 
 	vban::account next_frontier_account{ 2 };
 	node->active.next_frontier_account = next_frontier_account;
@@ -183,7 +183,7 @@ TEST (frontiers_confirmation, prioritize_frontiers_max_optimistic_elections)
 		node->active.frontiers_confirmation (lk);
 	}
 
-	ASSERT_EQ (max_optimistic_election_count, node->active.roots.size ());
+	ASSERT_EQ (max_optimistic_election_count, node->active.size ());
 	ASSERT_EQ (next_frontier_account, node->active.next_frontier_account);
 }
 
@@ -636,6 +636,75 @@ TEST (ledger, representation_changes)
 	ASSERT_EQ (1, rep_weights.representation_get (key1.pub));
 	rep_weights.representation_put (key1.pub, 2);
 	ASSERT_EQ (2, rep_weights.representation_get (key1.pub));
+	ASSERT_EQ (vban::uint256_fixed (2), rep_weights.representation_get_fixed (key1.pub));
+	ASSERT_EQ (vban::uint256_fixed (0), rep_weights.representation_get_fixed (vban::keypair ().pub));
+}
+
+TEST (ledger, representation_changes_recorded)
+{
+	vban::keypair key1;
+	vban::keypair key2;
+	vban::rep_weights rep_weights;
+	auto epoch (rep_weights.epoch ());
+	rep_weights.representation_add (key1.pub, 1);
+	rep_weights.representation_add_dual (key1.pub, 1, key2.pub, 1);
+	ASSERT_EQ (epoch + 3, rep_weights.epoch ());
+	std::vector<vban::account> changed;
+	ASSERT_FALSE (rep_weights.changes (epoch, epoch + 3, changed));
+	ASSERT_EQ (3, changed.size ());
+	ASSERT_EQ (2, std::count (changed.begin (), changed.end (), key1.pub));
+	ASSERT_EQ (1, std::count (changed.begin (), changed.end (), key2.pub));
+	// Only changes inside the requested range are returned
+	changed.clear ();
+	ASSERT_FALSE (rep_weights.changes (epoch + 1, epoch + 2, changed));
+	ASSERT_EQ (1, changed.size ());
+	// Changes are recorded per shard, filling the shard of key1 loses the oldest of them
+	for (auto i (0); i < 2000; ++i)
+	{
+		rep_weights.representation_add (key1.pub, 1);
+	}
+	changed.clear ();
+	ASSERT_TRUE (rep_weights.changes (epoch, rep_weights.epoch (), changed));
+	changed.clear ();
+	ASSERT_FALSE (rep_weights.changes (rep_weights.epoch () - 10, rep_weights.epoch (), changed));
+	ASSERT_EQ (10, changed.size ());
+}
+
+TEST (ledger, representation_concurrent_changes)
+{
+	std::vector<vban::account> reps;
+	vban::rep_weights rep_weights;
+	for (auto i (0); i < 64; ++i)
+	{
+		reps.push_back (vban::keypair ().pub);
+		rep_weights.representation_put (reps.back (), 1000);
+	}
+	std::vector<std::thread> threads;
+	for (auto i (0); i < 4; ++i)
+	{
+		threads.emplace_back ([&reps, &rep_weights, i] () {
+			for (size_t j (0); j < 10000; ++j)
+			{
+				rep_weights.representation_add_dual (reps[(i + j) % reps.size ()], 0 - vban::uint256_t (1), reps[(i * 7 + j * 3) % reps.size ()], 1);
+			}
+		});
+	}
+	// Lookups run concurrently with the transfers
+	for (auto k (0); k < 100; ++k)
+	{
+		ASSERT_LT (0, rep_weights.representation_get (reps[k % reps.size ()]));
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	vban::uint256_t total (0);
+	for (auto const & rep : reps)
+	{
+		total += rep_weights.representation_get (rep);
+	}
+	ASSERT_EQ (64 * 1000, total);
+	ASSERT_EQ (reps.size (), rep_weights.get_rep_amounts ().size ());
 }
 
 TEST (ledger, representation)
@@ -2664,7 +2733,7 @@ TEST (ledger, epoch_open_pending)
 	node1.block_processor.flush ();
 	ASSERT_FALSE (node1.ledger.block_or_pruned_exists (epoch_open->hash ()));
 	// Open block should be inserted into unchecked
-	auto blocks (node1.store.unchecked_get (node1.store.tx_begin_read (), vban::hash_or_account (epoch_open->account ()).hash));
+	auto blocks (node1.unchecked.get (node1.store.tx_begin_read (), vban::hash_or_account (epoch_open->account ()).hash));
 	ASSERT_EQ (blocks.size (), 1);
 	ASSERT_EQ (blocks[0].block->full_hash (), epoch_open->full_hash ());
 	ASSERT_EQ (blocks[0].verified, vban::signature_verification::valid_epoch);
@@ -2852,10 +2921,10 @@ TEST (ledger, unchecked_epoch)
 	node1.block_processor.flush ();
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
-		auto blocks (node1.store.unchecked_get (transaction, epoch1->previous ()));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
+		auto blocks (node1.unchecked.get (transaction, epoch1->previous ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, vban::signature_verification::valid_epoch);
 	}
@@ -2865,9 +2934,9 @@ TEST (ledger, unchecked_epoch)
 	{
 		auto transaction (node1.store.tx_begin_read ());
 		ASSERT_TRUE (node1.store.block_exists (transaction, epoch1->hash ()));
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
 		vban::account_info info;
 		ASSERT_FALSE (node1.store.account_get (transaction, destination.pub, info));
 		ASSERT_EQ (info.epoch (), vban::epoch::epoch_1);
@@ -2897,10 +2966,10 @@ TEST (ledger, unchecked_epoch_invalid)
 	node1.block_processor.flush ();
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 2);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
-		auto blocks (node1.store.unchecked_get (transaction, epoch1->previous ()));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
+		auto blocks (node1.unchecked.get (transaction, epoch1->previous ()));
 		ASSERT_EQ (blocks.size (), 2);
 		ASSERT_EQ (blocks[0].verified, vban::signature_verification::valid);
 		ASSERT_EQ (blocks[1].verified, vban::signature_verification::valid);
@@ -2913,9 +2982,9 @@ TEST (ledger, unchecked_epoch_invalid)
 		ASSERT_FALSE (node1.store.block_exists (transaction, epoch1->hash ()));
 		ASSERT_TRUE (node1.store.block_exists (transaction, epoch2->hash ()));
 		ASSERT_TRUE (node1.active.empty ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
 		vban::account_info info;
 		ASSERT_FALSE (node1.store.account_get (transaction, destination.pub, info));
 		ASSERT_NE (info.epoch (), vban::epoch::epoch_1);
@@ -2947,10 +3016,10 @@ TEST (ledger, unchecked_open)
 	node1.block_processor.flush ();
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
-		auto blocks (node1.store.unchecked_get (transaction, open1->source ()));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
+		auto blocks (node1.unchecked.get (transaction, open1->source ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, vban::signature_verification::valid);
 	}
@@ -2959,9 +3028,9 @@ TEST (ledger, unchecked_open)
 	{
 		auto transaction (node1.store.tx_begin_read ());
 		ASSERT_TRUE (node1.store.block_exists (transaction, open1->hash ()));
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
 	}
 }
 
@@ -2985,10 +3054,10 @@ TEST (ledger, unchecked_receive)
 	// Previous block for receive1 is unknown, signature cannot be validated
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
-		auto blocks (node1.store.unchecked_get (transaction, receive1->previous ()));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
+		auto blocks (node1.unchecked.get (transaction, receive1->previous ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, vban::signature_verification::unknown);
 	}
@@ -2997,10 +3066,10 @@ TEST (ledger, unchecked_receive)
 	// Previous block for receive1 is known, signature was validated
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
-		auto blocks (node1.store.unchecked_get (transaction, receive1->source ()));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
+		auto blocks (node1.unchecked.get (transaction, receive1->source ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, vban::signature_verification::valid);
 	}
@@ -3009,9 +3078,9 @@ TEST (ledger, unchecked_receive)
 	{
 		auto transaction (node1.store.tx_begin_read ());
 		ASSERT_TRUE (node1.store.block_exists (transaction, receive1->hash ()));
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
-		ASSERT_EQ (unchecked_count, node1.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node1.unchecked.count (transaction));
 	}
 }
 
@@ -3785,6 +3854,344 @@ TEST (ledger, pruning_safe_functions)
 	ASSERT_FALSE (error);
 }
 
+TEST (ledger, cache_snapshot)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::stat stats;
+	vban::ledger ledger (*store, stats);
+	vban::genesis genesis;
+	store->initialize (store->tx_begin_write (), genesis, ledger.cache);
+	ASSERT_FALSE (ledger.cache_snapshot_loaded);
+	vban::work_pool pool (std::numeric_limits<unsigned>::max ());
+	vban::keypair key;
+	vban::block_builder builder;
+	auto send = builder.state ()
+				.account (vban::genesis_account)
+				.previous (genesis.hash ())
+				.representative (key.pub)
+				.balance (vban::genesis_amount - 100)
+				.link (key.pub)
+				.sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				.work (*pool.generate (genesis.hash ()))
+				.build ();
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send).code);
+	}
+	// Modify the cache so a loaded snapshot can be told apart from a scan
+	ledger.cache.account_count = 1000;
+	{
+		auto transaction (store->tx_begin_write ());
+		ledger.cache_snapshot_write (transaction);
+	}
+	vban::ledger ledger1 (*store, stats);
+	ASSERT_TRUE (ledger1.cache_snapshot_loaded);
+	ASSERT_EQ (1000, ledger1.cache.account_count);
+	ASSERT_EQ (2, ledger1.cache.block_count);
+	ASSERT_EQ (1, ledger1.cache.cemented_count);
+	ASSERT_EQ (0, ledger1.weight (vban::genesis_account));
+	ASSERT_EQ (vban::genesis_amount - 100, ledger1.weight (key.pub));
+	// A corrupted snapshot falls back to scanning the ledger
+	{
+		auto transaction (store->tx_begin_write ());
+		std::vector<uint8_t> data;
+		ASSERT_FALSE (store->cache_snapshot_get (transaction, data));
+		data[data.size () / 2] ^= 1;
+		store->cache_snapshot_put (transaction, data);
+	}
+	vban::ledger ledger2 (*store, stats);
+	ASSERT_FALSE (ledger2.cache_snapshot_loaded);
+	ASSERT_EQ (1, ledger2.cache.account_count);
+	ASSERT_EQ (2, ledger2.cache.block_count);
+	// So does a snapshot written by another store version, or none at all
+	{
+		auto transaction (store->tx_begin_write ());
+		ledger.cache_snapshot_write (transaction);
+		store->version_put (transaction, store->version_get (transaction) - 1);
+	}
+	ASSERT_FALSE (vban::ledger (*store, stats).cache_snapshot_loaded);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->version_put (transaction, store->version_get (transaction) + 1);
+		store->cache_snapshot_del (transaction);
+	}
+	ASSERT_FALSE (vban::ledger (*store, stats).cache_snapshot_loaded);
+	// Disabled caches are not in the snapshot, a ledger needing them scans while one that does not still loads it
+	vban::generate_cache generate_cache;
+	generate_cache.reps = false;
+	generate_cache.account_count = false;
+	generate_cache.block_count = false;
+	vban::ledger ledger3 (*store, stats, generate_cache);
+	ASSERT_EQ (0, ledger3.cache.block_count);
+	{
+		auto transaction (store->tx_begin_write ());
+		ledger3.cache_snapshot_write (transaction);
+	}
+	vban::ledger ledger4 (*store, stats);
+	ASSERT_FALSE (ledger4.cache_snapshot_loaded);
+	ASSERT_EQ (2, ledger4.cache.block_count);
+	ASSERT_EQ (vban::genesis_amount - 100, ledger4.weight (key.pub));
+	vban::ledger ledger5 (*store, stats, generate_cache);
+	ASSERT_TRUE (ledger5.cache_snapshot_loaded);
+	ASSERT_EQ (1, ledger5.cache.cemented_count);
+}
+
+TEST (ledger, account_heights)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::stat stats;
+	vban::ledger ledger (*store, stats);
+	vban::genesis genesis;
+	store->initialize (store->tx_begin_write (), genesis, ledger.cache);
+	ledger.account_heights_enabled = true;
+	vban::work_pool pool (std::numeric_limits<unsigned>::max ());
+	vban::keypair key;
+	vban::block_builder builder;
+	auto send = builder.state ()
+				.account (vban::genesis_account)
+				.previous (genesis.hash ())
+				.representative (vban::genesis_account)
+				.balance (vban::genesis_amount - 100)
+				.link (key.pub)
+				.sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				.work (*pool.generate (genesis.hash ()))
+				.build ();
+	auto open = builder.state ()
+				.account (key.pub)
+				.previous (0)
+				.representative (key.pub)
+				.balance (100)
+				.link (send->hash ())
+				.sign (key.prv, key.pub)
+				.work (*pool.generate (key.pub))
+				.build ();
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send).code);
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *open).code);
+		ASSERT_EQ (send->hash (), store->account_height_get (transaction, vban::genesis_account, 2));
+		ASSERT_EQ (open->hash (), store->account_height_get (transaction, key.pub, 1));
+		// Rolling back the send also rolls back the open receiving it
+		ASSERT_FALSE (ledger.rollback (transaction, send->hash ()));
+		ASSERT_TRUE (store->account_height_get (transaction, vban::genesis_account, 2).is_zero ());
+		ASSERT_TRUE (store->account_height_get (transaction, key.pub, 1).is_zero ());
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send).code);
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *open).code);
+		// The genesis block was not indexed as the store was initialized before the index was enabled
+		ASSERT_TRUE (store->account_height_get (transaction, vban::genesis_account, 1).is_zero ());
+		ASSERT_FALSE (store->account_heights_complete (transaction));
+	}
+	ASSERT_EQ (3, ledger.account_heights_rebuild (2));
+	auto transaction (store->tx_begin_read ());
+	ASSERT_TRUE (store->account_heights_complete (transaction));
+	ASSERT_EQ (genesis.hash (), store->account_height_get (transaction, vban::genesis_account, 1));
+	ASSERT_EQ (send->hash (), store->account_height_get (transaction, vban::genesis_account, 2));
+	ASSERT_EQ (open->hash (), store->account_height_get (transaction, key.pub, 1));
+}
+
+TEST (ledger, delegators)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::stat stats;
+	vban::ledger ledger (*store, stats);
+	vban::genesis genesis;
+	store->initialize (store->tx_begin_write (), genesis, ledger.cache);
+	ASSERT_EQ (1, ledger.delegators_rebuild ());
+	ledger.delegators_enabled = true;
+	vban::work_pool pool (std::numeric_limits<unsigned>::max ());
+	vban::keypair key;
+	vban::keypair rep;
+	vban::block_builder builder;
+	auto send = builder.state ()
+				.account (vban::genesis_account)
+				.previous (genesis.hash ())
+				.representative (vban::genesis_account)
+				.balance (vban::genesis_amount - 100)
+				.link (key.pub)
+				.sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				.work (*pool.generate (genesis.hash ()))
+				.build ();
+	auto open = builder.state ()
+				.account (key.pub)
+				.previous (0)
+				.representative (vban::genesis_account)
+				.balance (100)
+				.link (send->hash ())
+				.sign (key.prv, key.pub)
+				.work (*pool.generate (key.pub))
+				.build ();
+	auto change = builder.state ()
+				  .account (key.pub)
+				  .previous (open->hash ())
+				  .representative (rep.pub)
+				  .balance (100)
+				  .link (0)
+				  .sign (key.prv, key.pub)
+				  .work (*pool.generate (open->hash ()))
+				  .build ();
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_TRUE (store->delegators_complete (transaction));
+		ASSERT_TRUE (store->delegator_exists (transaction, vban::genesis_account, vban::genesis_account));
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send).code);
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *open).code);
+		ASSERT_TRUE (store->delegator_exists (transaction, vban::genesis_account, key.pub));
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *change).code);
+		ASSERT_FALSE (store->delegator_exists (transaction, vban::genesis_account, key.pub));
+		ASSERT_TRUE (store->delegator_exists (transaction, rep.pub, key.pub));
+		// Rolling back moves the account back to its previous representative
+		ASSERT_FALSE (ledger.rollback (transaction, change->hash ()));
+		ASSERT_FALSE (store->delegator_exists (transaction, rep.pub, key.pub));
+		ASSERT_TRUE (store->delegator_exists (transaction, vban::genesis_account, key.pub));
+		// Rolling back the open removes the account
+		ASSERT_FALSE (ledger.rollback (transaction, open->hash ()));
+		ASSERT_FALSE (store->delegator_exists (transaction, vban::genesis_account, key.pub));
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *open).code);
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *change).code);
+		store->delegators_clear (transaction);
+	}
+	ASSERT_EQ (2, ledger.delegators_rebuild (1));
+	auto transaction (store->tx_begin_read ());
+	ASSERT_TRUE (store->delegators_complete (transaction));
+	ASSERT_TRUE (store->delegator_exists (transaction, vban::genesis_account, vban::genesis_account));
+	ASSERT_TRUE (store->delegator_exists (transaction, rep.pub, key.pub));
+	auto i (store->delegators_begin (transaction, vban::delegator_key (rep.pub, vban::account (0))));
+	ASSERT_NE (store->delegators_end (), i);
+	ASSERT_EQ (key.pub, i->first.account);
+	++i;
+	ASSERT_TRUE (i == store->delegators_end () || i->first.representative != rep.pub);
+}
+
+TEST (ledger, pending_summary)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::stat stats;
+	vban::ledger ledger (*store, stats);
+	vban::genesis genesis;
+	store->initialize (store->tx_begin_write (), genesis, ledger.cache);
+	ASSERT_EQ (0, ledger.pending_summary_rebuild ());
+	ledger.pending_summary_enabled = true;
+	vban::work_pool pool (std::numeric_limits<unsigned>::max ());
+	vban::keypair key;
+	vban::block_builder builder;
+	auto send1 = builder.state ()
+				 .account (vban::genesis_account)
+				 .previous (genesis.hash ())
+				 .representative (vban::genesis_account)
+				 .balance (vban::genesis_amount - 100)
+				 .link (key.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*pool.generate (genesis.hash ()))
+				 .build ();
+	auto send2 = builder.state ()
+				 .account (vban::genesis_account)
+				 .previous (send1->hash ())
+				 .representative (vban::genesis_account)
+				 .balance (vban::genesis_amount - 150)
+				 .link (key.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*pool.generate (send1->hash ()))
+				 .build ();
+	auto open = builder.state ()
+				.account (key.pub)
+				.previous (0)
+				.representative (vban::genesis_account)
+				.balance (100)
+				.link (send1->hash ())
+				.sign (key.prv, key.pub)
+				.work (*pool.generate (key.pub))
+				.build ();
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_TRUE (store->pending_summary_complete (transaction));
+		vban::pending_summary summary;
+		ASSERT_TRUE (store->pending_summary_get (transaction, key.pub, summary));
+		ASSERT_TRUE (ledger.pending_summary_excludes (transaction, key.pub, 0));
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send1).code);
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send2).code);
+		ASSERT_FALSE (store->pending_summary_get (transaction, key.pub, summary));
+		ASSERT_EQ (2, summary.count);
+		ASSERT_EQ (150, summary.total.number ());
+		ASSERT_EQ (50, summary.minimum.number ());
+		ASSERT_EQ (100, summary.maximum.number ());
+		ASSERT_FALSE (ledger.pending_summary_excludes (transaction, key.pub, 100));
+		ASSERT_TRUE (ledger.pending_summary_excludes (transaction, key.pub, 101));
+		// Receiving the largest amount narrows the range
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *open).code);
+		ASSERT_FALSE (store->pending_summary_get (transaction, key.pub, summary));
+		ASSERT_EQ (1, summary.count);
+		ASSERT_EQ (50, summary.total.number ());
+		ASSERT_EQ (50, summary.minimum.number ());
+		ASSERT_EQ (50, summary.maximum.number ());
+		ASSERT_TRUE (ledger.pending_summary_excludes (transaction, key.pub, 51));
+		// Rolling back the receive restores the pending entry
+		ASSERT_FALSE (ledger.rollback (transaction, open->hash ()));
+		vban::pending_summary restored;
+		ASSERT_FALSE (store->pending_summary_get (transaction, key.pub, restored));
+		ASSERT_EQ (2, restored.count);
+		ASSERT_EQ (150, restored.total.number ());
+		ASSERT_EQ (100, restored.maximum.number ());
+		// Rolling back both sends removes the summary
+		ASSERT_FALSE (ledger.rollback (transaction, send1->hash ()));
+		ASSERT_TRUE (store->pending_summary_get (transaction, key.pub, summary));
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send1).code);
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send2).code);
+		store->pending_summary_clear (transaction);
+	}
+	ASSERT_EQ (1, ledger.pending_summary_rebuild (1));
+	auto transaction (store->tx_begin_read ());
+	ASSERT_TRUE (store->pending_summary_complete (transaction));
+	vban::pending_summary summary;
+	ASSERT_FALSE (store->pending_summary_get (transaction, key.pub, summary));
+	ASSERT_EQ (2, summary.count);
+	ASSERT_EQ (150, summary.total.number ());
+	ASSERT_EQ (50, summary.minimum.number ());
+	ASSERT_EQ (100, summary.maximum.number ());
+}
+
+TEST (ledger, pending_summary_bounds)
+{
+	vban::pending_summary summary;
+	for (auto i (0); i < 3; ++i)
+	{
+		summary.add (10);
+	}
+	summary.add (100);
+	ASSERT_EQ (3, summary.minimum_count);
+	ASSERT_EQ (1, summary.maximum_count);
+	// Removing entries equal to a bound only decrements its count
+	summary.remove (10);
+	ASSERT_EQ (10, summary.minimum.number ());
+	ASSERT_EQ (2, summary.minimum_count);
+	summary.add (50);
+	// Removing the last maximum keeps it as an upper bound
+	summary.remove (100);
+	ASSERT_EQ (3, summary.count);
+	ASSERT_EQ (70, summary.total.number ());
+	ASSERT_EQ (100, summary.maximum.number ());
+	ASSERT_EQ (0, summary.maximum_count);
+	// An amount equal to the inexact bound makes it exact again
+	summary.add (100);
+	ASSERT_EQ (1, summary.maximum_count);
+	summary.remove (100);
+	summary.remove (10);
+	summary.remove (10);
+	// The last remaining amount is known exactly
+	ASSERT_EQ (1, summary.count);
+	ASSERT_EQ (50, summary.minimum.number ());
+	ASSERT_EQ (50, summary.maximum.number ());
+	ASSERT_EQ (1, summary.minimum_count);
+	ASSERT_EQ (1, summary.maximum_count);
+}
+
 TEST (ledger, hash_root_random)
 {
 	vban::logger_mt logger;
@@ -3873,6 +4280,15 @@ TEST (ledger, migrate_lmdb_to_rocksdb)
 		send->sideband_set ({});
 		store.block_put (transaction, send->hash (), *send);
 		store.final_vote_put (transaction, send->qualified_root (), vban::block_hash (2));
+
+		// Optional indexes, the delegators index is left incomplete
+		store.account_height_put (transaction, vban::genesis_account, 2, send->hash ());
+		store.account_heights_complete_set (transaction, true);
+		store.delegator_put (transaction, vban::dev_genesis_key.pub, vban::account (10));
+		vban::pending_summary summary;
+		summary.add (100);
+		store.pending_summary_put (transaction, vban::genesis_account, summary);
+		store.pending_summary_complete_set (transaction, true);
 	}
 
 	auto error = ledger.migrate_lmdb_to_rocksdb (path);
@@ -3895,6 +4311,8 @@ TEST (ledger, migrate_lmdb_to_rocksdb)
 	auto block1 = rocksdb_store.block_get (rocksdb_transaction, send->hash ());
 
 	ASSERT_EQ (*send, *block1);
+	// State blocks are stored compactly, the representative ids are persisted with them
+	ASSERT_EQ (1, rocksdb_store.count (rocksdb_transaction, vban::tables::representatives));
 	ASSERT_TRUE (rocksdb_store.peer_exists (rocksdb_transaction, endpoint_key));
 	ASSERT_EQ (rocksdb_store.version_get (rocksdb_transaction), version);
 	ASSERT_EQ (rocksdb_store.frontier_get (rocksdb_transaction, 2), 5);
@@ -3909,6 +4327,16 @@ TEST (ledger, migrate_lmdb_to_rocksdb)
 	ASSERT_EQ (unchecked_infos.size (), 1);
 	ASSERT_EQ (unchecked_infos.front ().account, vban::genesis_account);
 	ASSERT_EQ (*unchecked_infos.front ().block, *send);
+
+	ASSERT_EQ (send->hash (), rocksdb_store.account_height_get (rocksdb_transaction, vban::genesis_account, 2));
+	ASSERT_TRUE (rocksdb_store.account_heights_complete (rocksdb_transaction));
+	ASSERT_TRUE (rocksdb_store.delegator_exists (rocksdb_transaction, vban::dev_genesis_key.pub, vban::account (10)));
+	ASSERT_FALSE (rocksdb_store.delegators_complete (rocksdb_transaction));
+	vban::pending_summary summary;
+	ASSERT_FALSE (rocksdb_store.pending_summary_get (rocksdb_transaction, vban::genesis_account, summary));
+	ASSERT_EQ (1, summary.count);
+	ASSERT_EQ (100, summary.total.number ());
+	ASSERT_TRUE (rocksdb_store.pending_summary_complete (rocksdb_transaction));
 }
 
 TEST (ledger, unconfirmed_frontiers)
@@ -0,0 +1,96 @@
+#include <vban/lib/logger_mt.hpp>
+#include <vban/lib/stats.hpp>
+#include <vban/lib/work.hpp>
+#include <vban/secure/blockstore.hpp>
+#include <vban/secure/ledger.hpp>
+#include <vban/secure/membership_filter.hpp>
+#include <vban/secure/utility.hpp>
+#include <vban/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+TEST (membership_filter, false_positive_rate)
+{
+	size_t const count (100000);
+	vban::membership_filter filter (count, 10);
+	for (auto i (0u); i < count; ++i)
+	{
+		filter.insert (vban::uint256_union (i));
+	}
+	for (auto i (0u); i < count; ++i)
+	{
+		ASSERT_TRUE (filter.may_contain (vban::uint256_union (i)));
+	}
+	size_t false_positives (0);
+	for (auto i (count); i < 2 * count; ++i)
+	{
+		false_positives += filter.may_contain (vban::uint256_union (i)) ? 1 : 0;
+	}
+	// Around 1-2% for 10 bits per entry
+	ASSERT_LT (false_positives, count / 20);
+}
+
+TEST (membership_filter, store)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	vban::stat stats;
+	vban::ledger ledger (*store, stats);
+	vban::genesis genesis;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+		store->pruned_put (transaction, vban::block_hash (1));
+	}
+	vban::block_hash missing (2);
+	ASSERT_FALSE (store->block_filter_enabled ());
+	ASSERT_FALSE (store->block_filter_excludes (missing));
+	std::atomic<bool> stopped{ false };
+	store->block_filter_build (10, stopped);
+	ASSERT_TRUE (store->block_filter_enabled ());
+	ASSERT_FALSE (store->block_filter_excludes (genesis.hash ()));
+	ASSERT_FALSE (store->block_filter_excludes (vban::block_hash (1)));
+	ASSERT_TRUE (ledger.block_or_pruned_exists (genesis.hash ()));
+	ASSERT_TRUE (ledger.block_or_pruned_exists (vban::block_hash (1)));
+	// Blocks written after the build are recorded before their transaction commits
+	vban::work_pool pool (std::numeric_limits<unsigned>::max ());
+	vban::keypair key;
+	auto send (std::make_shared<vban::send_block> (genesis.hash (), key.pub, 0, vban::dev_genesis_key.prv, vban::dev_genesis_key.pub, *pool.generate (genesis.hash ())));
+	ASSERT_TRUE (store->block_filter_excludes (send->hash ()));
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_EQ (vban::process_result::progress, ledger.process (transaction, *send).code);
+	}
+	ASSERT_FALSE (store->block_filter_excludes (send->hash ()));
+	ASSERT_TRUE (ledger.block_or_pruned_exists (send->hash ()));
+	auto negatives (0);
+	for (auto i (3); i < 1003; ++i)
+	{
+		ASSERT_FALSE (ledger.block_or_pruned_exists (vban::block_hash (i)));
+		negatives += store->block_filter_excludes (vban::block_hash (i)) ? 1 : 0;
+	}
+	ASSERT_EQ (negatives, stats.count (vban::stat::type::ledger, vban::stat::detail::block_filter_negative));
+	ASSERT_EQ (1000 - negatives, stats.count (vban::stat::type::ledger, vban::stat::detail::block_filter_false_positive));
+	ASSERT_GT (negatives, 900);
+}
+
+TEST (membership_filter, store_stopped)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	vban::stat stats;
+	vban::ledger ledger (*store, stats);
+	vban::genesis genesis;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+	}
+	// A partial filter would exclude stored blocks, so a stopped build leaves it disabled
+	std::atomic<bool> stopped{ true };
+	store->block_filter_build (10, stopped);
+	ASSERT_FALSE (store->block_filter_enabled ());
+	ASSERT_FALSE (store->block_filter_excludes (genesis.hash ()));
+	ASSERT_TRUE (ledger.block_or_pruned_exists (genesis.hash ()));
+}
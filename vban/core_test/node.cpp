@@ -447,13 +447,8 @@ TEST (node, search_pending_confirmed)
 	}
 	system.wallet (0)->insert_adhoc (key2.prv);
 	ASSERT_FALSE (system.wallet (0)->search_pending (system.wallet (0)->wallets.tx_begin_read ()));
-	{
-		vban::lock_guard<vban::mutex> guard (node->active.mutex);
-		auto existing1 (node->active.blocks.find (send1->hash ()));
-		ASSERT_EQ (node->active.blocks.end (), existing1);
-		auto existing2 (node->active.blocks.find (send2->hash ()));
-		ASSERT_EQ (node->active.blocks.end (), existing2);
-	}
+	ASSERT_FALSE (node->active.active (send1->hash ()));
+	ASSERT_FALSE (node->active.active (send2->hash ()));
 	ASSERT_TIMELY (10s, node->balance (key2.pub) == 2 * node->config.receive_minimum.number ());
 }
 
@@ -492,13 +487,8 @@ TEST (node, search_pending_pruned)
 	// Receive pruned block
 	system.wallet (1)->insert_adhoc (key2.prv);
 	ASSERT_FALSE (system.wallet (1)->search_pending (system.wallet (1)->wallets.tx_begin_read ()));
-	{
-		vban::lock_guard<vban::mutex> guard (node2->active.mutex);
-		auto existing1 (node2->active.blocks.find (send1->hash ()));
-		ASSERT_EQ (node2->active.blocks.end (), existing1);
-		auto existing2 (node2->active.blocks.find (send2->hash ()));
-		ASSERT_EQ (node2->active.blocks.end (), existing2);
-	}
+	ASSERT_FALSE (node2->active.active (send1->hash ()));
+	ASSERT_FALSE (node2->active.active (send2->hash ()));
 	ASSERT_TIMELY (10s, node2->balance (key2.pub) == 2 * node2->config.receive_minimum.number ());
 }
 
@@ -2046,11 +2036,7 @@ TEST (node, bootstrap_confirm_frontiers)
 		ASSERT_NO_ERROR (system0.poll ());
 		ASSERT_NO_ERROR (system1.poll ());
 	}
-	{
-		vban::lock_guard<vban::mutex> guard (node1->active.mutex);
-		auto existing1 (node1->active.blocks.find (send0->hash ()));
-		ASSERT_NE (node1->active.blocks.end (), existing1);
-	}
+	ASSERT_TRUE (node1->active.active (send0->hash ()));
 	// Wait for confirmation height update
 	system1.deadline_set (10s);
 	bool done (false);
@@ -3162,11 +3148,8 @@ TEST (node, epoch_conflict_confirm)
 	// Start elections for node0
 	vban::blocks_confirm (*node0, { change, epoch_open });
 	ASSERT_EQ (2, node0->active.size ());
-	{
-		vban::lock_guard<vban::mutex> lock (node0->active.mutex);
-		ASSERT_TRUE (node0->active.blocks.find (change->hash ()) != node0->active.blocks.end ());
-		ASSERT_TRUE (node0->active.blocks.find (epoch_open->hash ()) != node0->active.blocks.end ());
-	}
+	ASSERT_TRUE (node0->active.active (change->hash ()));
+	ASSERT_TRUE (node0->active.active (epoch_open->hash ()));
 	system.wallet (1)->insert_adhoc (vban::dev_genesis_key.prv);
 	ASSERT_TIMELY (5s, node0->active.election (change->qualified_root ()) == nullptr);
 	ASSERT_TIMELY (5s, node0->active.empty ());
@@ -3331,7 +3314,7 @@ TEST (node, block_processor_signatures)
 	// Invalid signature to unchecked
 	{
 		auto transaction (node1.store.tx_begin_write ());
-		node1.store.unchecked_put (transaction, send5->previous (), send5);
+		node1.unchecked.put (transaction, vban::unchecked_key (send5->previous (), send5->hash ()), vban::unchecked_info (send5, send5->account (), vban::seconds_since_epoch ()));
 	}
 	auto receive1 = builder.make_block ()
 					.account (key1.pub)
@@ -3422,6 +3405,80 @@ TEST (node, block_processor_reject_state)
 	ASSERT_TRUE (node.ledger.block_or_pruned_exists (send2->hash ()));
 }
 
+TEST (node, block_processor_adaptive_batch)
+{
+	vban::block_processor_batch_controller controller (100ms, 64, 1024);
+	ASSERT_EQ (64, controller.size ());
+	// A full batch with a backlog left and cheap commits grows
+	ASSERT_EQ (vban::block_processor_batch_controller::decision::grow, controller.update (64, 10ms, 1ms, 1000, 0));
+	ASSERT_EQ (128, controller.size ());
+	ASSERT_NE (0, controller.commit_average ().count ());
+	// Partial batches keep the size
+	ASSERT_EQ (vban::block_processor_batch_controller::decision::hold, controller.update (10, 5ms, 1ms, 0, 0));
+	ASSERT_EQ (128, controller.size ());
+	// Doubling would be projected to overrun the target
+	ASSERT_EQ (vban::block_processor_batch_controller::decision::hold, controller.update (128, 90ms, 1ms, 1000, 0));
+	ASSERT_EQ (128, controller.size ());
+	// Other writers waiting on the write queue shrink the batch
+	ASSERT_EQ (vban::block_processor_batch_controller::decision::shrink, controller.update (128, 10ms, 1ms, 1000, 1));
+	ASSERT_EQ (64, controller.size ());
+	// Never below the minimum
+	ASSERT_EQ (vban::block_processor_batch_controller::decision::hold, controller.update (64, 200ms, 1ms, 1000, 0));
+	ASSERT_EQ (64, controller.size ());
+	// Nor above the maximum
+	while (controller.update (controller.size (), 1ms, 100us, 1000, 0) == vban::block_processor_batch_controller::decision::grow)
+	{
+	}
+	ASSERT_EQ (1024, controller.size ());
+
+	vban::write_database_queue write_database_queue (false);
+	auto scoped_write_guard = write_database_queue.wait (vban::writer::testing);
+	ASSERT_EQ (0, write_database_queue.waiters ());
+	ASSERT_FALSE (write_database_queue.process (vban::writer::confirmation_height));
+	ASSERT_EQ (1, write_database_queue.waiters ());
+}
+
+TEST (node, write_group_commit)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::write_database_queue write_database_queue (false, true);
+	vban::keypair key;
+	auto write = [&store, &key] (vban::write_transaction & transaction_a) {
+		store->confirmation_height_put (transaction_a, key.pub, vban::confirmation_height_info (1, vban::block_hash (1)));
+	};
+	// Nothing to append to
+	ASSERT_FALSE (write_database_queue.append (vban::writer::confirmation_height, write));
+	auto scoped_write_guard = write_database_queue.wait (vban::writer::process_batch);
+	auto transaction (store->tx_begin_write ());
+	vban::write_group write_group (write_database_queue, transaction);
+	ASSERT_FALSE (write_database_queue.process (vban::writer::confirmation_height));
+	ASSERT_EQ (1, write_database_queue.waiters ());
+	std::atomic<bool> appended{ false };
+	std::thread follower ([&write_database_queue, &write, &appended] () {
+		ASSERT_TRUE (write_database_queue.append (vban::writer::confirmation_height, write));
+		appended = true;
+	});
+	// Appending gives up the place queued behind the group owner
+	vban::timer<std::chrono::milliseconds> timer (vban::timer_state::started);
+	while (write_database_queue.waiters () != 0 && timer.before_deadline (5s))
+	{
+		std::this_thread::sleep_for (1ms);
+	}
+	ASSERT_EQ (0, write_database_queue.waiters ());
+	// The follower only returns once the shared transaction is committed
+	std::this_thread::sleep_for (50ms);
+	ASSERT_FALSE (appended);
+	ASSERT_EQ (1, write_group.commit ());
+	follower.join ();
+	ASSERT_TRUE (appended);
+	ASSERT_EQ (1, write_database_queue.appended ());
+	ASSERT_TRUE (store->confirmation_height_exists (store->tx_begin_read (), key.pub));
+	scoped_write_guard.release ();
+	ASSERT_FALSE (write_database_queue.append (vban::writer::confirmation_height, write));
+}
+
 TEST (node, block_processor_full)
 {
 	vban::system system;
@@ -3517,6 +3574,144 @@ TEST (node, block_processor_half_full)
 	ASSERT_FALSE (node.block_processor.full ());
 }
 
+// Blocks wait in per source queues which are drained in turns
+TEST (node, block_processor_source_queues)
+{
+	vban::system system;
+	vban::node_flags node_flags;
+	node_flags.force_use_write_database_queue = true;
+	node_flags.block_processor_full_size = 3;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	// Blocks go straight to their queues
+	node_config.block_processor_prevalidation_threads = 0;
+	auto & node = *system.add_node (node_config, node_flags);
+	auto blocks (vban::genesis_send_chain (node, 4));
+	// The write guard prevents block processor doing any writes
+	auto write_guard = node.write_database_queue.wait (vban::writer::testing);
+	for (auto i (0); i < 3; ++i)
+	{
+		node.block_processor.add (vban::unchecked_info (blocks[i], vban::dev_genesis_key.pub, 0, vban::signature_verification::valid), vban::block_source::bootstrap);
+	}
+	// The last block of the chain is queued locally, it's reached before the bootstrap queue is drained
+	node.block_processor.add (vban::unchecked_info (blocks[3], vban::dev_genesis_key.pub, 0, vban::signature_verification::valid), vban::block_source::local);
+	ASSERT_EQ (3, node.block_processor.size (vban::block_source::bootstrap));
+	ASSERT_EQ (1, node.block_processor.size (vban::block_source::local));
+	ASSERT_EQ (0, node.block_processor.size (vban::block_source::live));
+	ASSERT_TRUE (node.block_processor.full (vban::block_source::bootstrap));
+	ASSERT_FALSE (node.block_processor.half_full (vban::block_source::local));
+	ASSERT_FALSE (node.block_processor.full (vban::block_source::live));
+	ASSERT_TIMELY (5s, node.write_database_queue.contains (vban::writer::process_batch));
+	write_guard.release ();
+	ASSERT_TIMELY (5s, node.ledger.block_or_pruned_exists (blocks[3]->hash ()));
+	ASSERT_EQ (3, node.stats.count (vban::stat::type::block_processor, vban::stat::detail::queue_bootstrap));
+	ASSERT_EQ (1, node.stats.count (vban::stat::type::block_processor, vban::stat::detail::queue_local));
+	// The local block had a gap and came back through the unchecked queue
+	ASSERT_EQ (1, node.stats.count (vban::stat::type::block_processor, vban::stat::detail::queue_unchecked));
+	auto bins (node.block_processor.wait_times (vban::block_source::bootstrap));
+	ASSERT_EQ (3, std::accumulate (bins.begin (), bins.end (), uint64_t (0), [] (uint64_t total, auto const & bin) { return total + bin.value; }));
+}
+
+// The live source is bounded, blocks added to its full queue are dropped
+TEST (node, block_processor_source_limit)
+{
+	vban::system system;
+	vban::node_flags node_flags;
+	node_flags.force_use_write_database_queue = true;
+	node_flags.block_processor_full_size = 2;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.block_processor_prevalidation_threads = 0;
+	auto & node = *system.add_node (node_config, node_flags);
+	auto blocks (vban::genesis_send_chain (node, 6));
+	auto write_guard = node.write_database_queue.wait (vban::writer::testing);
+	for (auto i (0); i < 3; ++i)
+	{
+		node.block_processor.add (vban::unchecked_info (blocks[i], vban::dev_genesis_key.pub, 0, vban::signature_verification::valid), vban::block_source::live);
+	}
+	ASSERT_EQ (2, node.block_processor.size (vban::block_source::live));
+	ASSERT_EQ (1, node.stats.count (vban::stat::type::block_processor, vban::stat::detail::overflow));
+	// Local and bootstrap blocks are never dropped, bootstrap does not request them again
+	for (auto i (3); i < 6; ++i)
+	{
+		node.block_processor.add (vban::unchecked_info (blocks[i], vban::dev_genesis_key.pub, 0, vban::signature_verification::valid), vban::block_source::local);
+		node.block_processor.add (vban::unchecked_info (blocks[i], vban::dev_genesis_key.pub, 0, vban::signature_verification::valid), vban::block_source::bootstrap);
+	}
+	ASSERT_EQ (3, node.block_processor.size (vban::block_source::local));
+	ASSERT_EQ (3, node.block_processor.size (vban::block_source::bootstrap));
+	ASSERT_EQ (1, node.stats.count (vban::stat::type::block_processor, vban::stat::detail::overflow));
+	write_guard.release ();
+	ASSERT_TIMELY (5s, node.ledger.block_or_pruned_exists (blocks[1]->hash ()));
+	ASSERT_FALSE (node.ledger.block_or_pruned_exists (blocks[2]->hash ()));
+}
+
+// Prevalidation only delays bulk sources
+TEST (node, block_prevalidation_priority)
+{
+	vban::system system;
+	vban::node_flags node_flags;
+	node_flags.force_use_write_database_queue = true;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.block_processor_prevalidation_threads = 1;
+	auto & node = *system.add_node (node_config, node_flags);
+	auto blocks (vban::genesis_send_chain (node, 4));
+	auto write_guard = node.write_database_queue.wait (vban::writer::testing);
+	for (auto i (0); i < 3; ++i)
+	{
+		node.block_processor.add (vban::unchecked_info (blocks[i], vban::dev_genesis_key.pub, 0, vban::signature_verification::valid), vban::block_source::bootstrap);
+	}
+	// Queued without waiting for the bootstrap blocks ahead of it in prevalidation
+	node.block_processor.add (vban::unchecked_info (blocks[3], vban::dev_genesis_key.pub, 0, vban::signature_verification::valid), vban::block_source::live);
+	ASSERT_EQ (1, node.block_processor.size (vban::block_source::live));
+	ASSERT_TIMELY (5s, node.block_processor.size (vban::block_source::bootstrap) == 3);
+	write_guard.release ();
+	ASSERT_TIMELY (5s, node.ledger.block_or_pruned_exists (blocks[3]->hash ()));
+}
+
+TEST (node, block_prevalidation)
+{
+	vban::system system (1);
+	auto & node (*system.nodes[0]);
+	vban::genesis genesis;
+	auto send = vban::send_block_builder ()
+				.previous (genesis.hash ())
+				.destination (vban::dev_genesis_key.pub)
+				.balance (vban::genesis_amount - 100)
+				.sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				.work (*system.work.generate (genesis.hash ()))
+				.build_shared ();
+	auto forged = vban::send_block_builder ()
+				  .previous (genesis.hash ())
+				  .destination (vban::dev_genesis_key.pub)
+				  .balance (vban::genesis_amount - 200)
+				  .sign (vban::keypair ().prv, vban::dev_genesis_key.pub)
+				  .work (*system.work.generate (genesis.hash ()))
+				  .build_shared ();
+	// Cache hashes before the blocks are shared between worker threads
+	send->hash ();
+	forged->hash ();
+	vban::block_prevalidation prevalidation (node.ledger, 4);
+	vban::mutex mutex;
+	std::vector<vban::unchecked_info> delivered;
+	prevalidation.blocks_prevalidated_callback = [&mutex, &delivered] (std::deque<vban::unchecked_info> & items_a) {
+		vban::lock_guard<vban::mutex> guard (mutex);
+		delivered.insert (delivered.end (), items_a.begin (), items_a.end ());
+	};
+	size_t const count (4 * vban::block_prevalidation::batch_size);
+	for (auto i (0); i < count; ++i)
+	{
+		// The modified field records the order blocks were added in
+		prevalidation.add (vban::unchecked_info (i % 2 == 0 ? send : forged, 0, i));
+	}
+	ASSERT_TIMELY (5s, !prevalidation.is_active () && prevalidation.size () == 0);
+	vban::lock_guard<vban::mutex> guard (mutex);
+	ASSERT_EQ (count, delivered.size ());
+	for (auto i (0); i < count; ++i)
+	{
+		ASSERT_EQ (i, delivered[i].modified);
+		// Legacy signatures are checked against the account owning the previous block, failures are left to the ledger
+		ASSERT_EQ (i % 2 == 0 ? vban::signature_verification::valid : vban::signature_verification::unknown, delivered[i].verified);
+	}
+}
+
 TEST (node, confirm_back)
 {
 	vban::system system (1);
@@ -3690,27 +3885,27 @@ TEST (node, unchecked_cleanup)
 	node.config.unchecked_cutoff_time = std::chrono::seconds (2);
 	{
 		auto transaction (node.store.tx_begin_read ());
-		auto unchecked_count (node.store.unchecked_count (transaction));
+		auto unchecked_count (node.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
-		ASSERT_EQ (unchecked_count, node.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node.unchecked.count (transaction));
 	}
 	std::this_thread::sleep_for (std::chrono::seconds (1));
 	node.unchecked_cleanup ();
 	ASSERT_TRUE (node.network.publish_filter.apply (bytes.data (), bytes.size ()));
 	{
 		auto transaction (node.store.tx_begin_read ());
-		auto unchecked_count (node.store.unchecked_count (transaction));
+		auto unchecked_count (node.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
-		ASSERT_EQ (unchecked_count, node.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node.unchecked.count (transaction));
 	}
 	std::this_thread::sleep_for (std::chrono::seconds (2));
 	node.unchecked_cleanup ();
 	ASSERT_FALSE (node.network.publish_filter.apply (bytes.data (), bytes.size ()));
 	{
 		auto transaction (node.store.tx_begin_read ());
-		auto unchecked_count (node.store.unchecked_count (transaction));
+		auto unchecked_count (node.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
-		ASSERT_EQ (unchecked_count, node.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node.unchecked.count (transaction));
 	}
 }
 
@@ -4322,11 +4517,10 @@ TEST (node, dependency_graph)
 	ASSERT_NO_ERROR (system.poll_until_true (15s, [&] {
 		// Not many blocks should be active simultaneously
 		EXPECT_LT (node.active.size (), 6);
-		vban::lock_guard<vban::mutex> guard (node.active.mutex);
 
 		// Ensure that active blocks have their ancestors confirmed
 		auto error = std::any_of (dependency_graph.cbegin (), dependency_graph.cend (), [&] (auto entry) {
-			if (node.active.blocks.count (entry.first))
+			if (node.active.active (entry.first))
 			{
 				for (auto ancestor : entry.second)
 				{
@@ -1,3 +1,4 @@
+#include <vban/lib/stats.hpp>
 #include <vban/node/signatures.hpp>
 #include <vban/secure/common.hpp>
 
@@ -199,3 +200,68 @@ TEST (signature_checker, boundary_checks)
 		last_size = size;
 	}
 }
+
+TEST (signature_checker, cache)
+{
+	vban::stat stats;
+	vban::signature_cache cache (1024, stats);
+	vban::signature_checker checker (0, &cache);
+	vban::keypair key;
+	vban::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	vban::state_block invalid_block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	invalid_block.signature.bytes[31] ^= 0x1;
+	std::array<vban::block_hash, 2> hashes{ block.hash (), invalid_block.hash () };
+	std::array<unsigned char const *, 2> messages{ hashes[0].bytes.data (), hashes[1].bytes.data () };
+	std::array<size_t, 2> lengths{ sizeof (vban::block_hash), sizeof (vban::block_hash) };
+	std::array<unsigned char const *, 2> pub_keys{ key.pub.bytes.data (), key.pub.bytes.data () };
+	std::array<unsigned char const *, 2> signatures{ block.signature.bytes.data (), invalid_block.signature.bytes.data () };
+	for (auto i (0); i < 2; ++i)
+	{
+		std::array<int, 2> verifications{ -1, -1 };
+		vban::signature_check_set check = { 2, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+		checker.verify (check);
+		ASSERT_EQ (1, verifications[0]);
+		ASSERT_EQ (0, verifications[1]);
+	}
+	// Only the valid signature is cached, the invalid one is verified again
+	ASSERT_EQ (1, cache.size ());
+	ASSERT_EQ (1, cache.hits);
+	ASSERT_EQ (3, cache.misses);
+	ASSERT_EQ (1, stats.count (vban::stat::type::signature_cache, vban::stat::detail::cache_hit));
+	ASSERT_EQ (3, stats.count (vban::stat::type::signature_cache, vban::stat::detail::cache_miss));
+}
+
+TEST (signature_checker, representative_keys)
+{
+	vban::representative_key_cache representative_keys (1);
+	vban::signature_checker checker (0, nullptr, &representative_keys);
+	vban::keypair rep;
+	vban::keypair other;
+	representative_keys.update ({ rep.pub, other.pub });
+	// Only the first key fits
+	ASSERT_EQ (1, representative_keys.size ());
+	vban::state_block block (rep.pub, 0, rep.pub, 0, 0, rep.prv, rep.pub, 0);
+	vban::state_block invalid_block (rep.pub, 0, rep.pub, 0, 0, rep.prv, rep.pub, 0);
+	invalid_block.signature.bytes[31] ^= 0x1;
+	vban::state_block other_block (other.pub, 0, other.pub, 0, 0, other.prv, other.pub, 0);
+	std::array<vban::block_hash, 3> hashes{ block.hash (), invalid_block.hash (), other_block.hash () };
+	std::array<unsigned char const *, 3> messages{ hashes[0].bytes.data (), hashes[1].bytes.data (), hashes[2].bytes.data () };
+	std::array<size_t, 3> lengths{ sizeof (vban::block_hash), sizeof (vban::block_hash), sizeof (vban::block_hash) };
+	std::array<unsigned char const *, 3> pub_keys{ rep.pub.bytes.data (), rep.pub.bytes.data (), other.pub.bytes.data () };
+	std::array<unsigned char const *, 3> signatures{ block.signature.bytes.data (), invalid_block.signature.bytes.data (), other_block.signature.bytes.data () };
+	std::array<int, 3> verifications{ -1, -1, -1 };
+	vban::signature_check_set check = { 3, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+	checker.verify (check);
+	ASSERT_EQ (1, verifications[0]);
+	ASSERT_EQ (0, verifications[1]);
+	ASSERT_EQ (1, verifications[2]);
+	ASSERT_EQ (2, representative_keys.hits);
+	ASSERT_EQ (1, representative_keys.misses);
+	// Points are reused across updates, replacing the key set drops the old ones
+	auto keys_l (representative_keys.keys ());
+	representative_keys.update ({ rep.pub });
+	ASSERT_EQ (keys_l, representative_keys.keys ());
+	representative_keys.update ({ other.pub });
+	ASSERT_EQ (1, representative_keys.size ());
+	ASSERT_EQ (1, representative_keys.keys ()->count (other.pub));
+}
@@ -187,6 +187,18 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_EQ (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_EQ (conf.node.confirm_req_batches_max, defaults.node.confirm_req_batches_max);
+	ASSERT_EQ (conf.node.signature_cache_size, defaults.node.signature_cache_size);
+	ASSERT_EQ (conf.node.account_cache_memory_mb, defaults.node.account_cache_memory_mb);
+	ASSERT_EQ (conf.node.block_cache_size, defaults.node.block_cache_size);
+	ASSERT_EQ (conf.node.vote_processor_threads, defaults.node.vote_processor_threads);
+	ASSERT_EQ (conf.node.block_processor_batch_target_time, defaults.node.block_processor_batch_target_time);
+	ASSERT_EQ (conf.node.block_processor_prevalidation_threads, defaults.node.block_processor_prevalidation_threads);
+	ASSERT_EQ (conf.node.unchecked_memory_mb, defaults.node.unchecked_memory_mb);
+	ASSERT_EQ (conf.node.write_group_commit, defaults.node.write_group_commit);
+	ASSERT_EQ (conf.node.block_filter_bits, defaults.node.block_filter_bits);
+	ASSERT_EQ (conf.node.account_history_index, defaults.node.account_history_index);
+	ASSERT_EQ (conf.node.delegators_index, defaults.node.delegators_index);
+	ASSERT_EQ (conf.node.pending_summary_index, defaults.node.pending_summary_index);
 
 	ASSERT_EQ (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_EQ (conf.node.logging.flush, defaults.node.logging.flush);
@@ -254,6 +266,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_EQ (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_EQ (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_EQ (conf.node.lmdb_config.checkpoint_interval, defaults.node.lmdb_config.checkpoint_interval);
+	ASSERT_EQ (conf.node.lmdb_config.checkpoint_bytes, defaults.node.lmdb_config.checkpoint_bytes);
 
 	ASSERT_EQ (conf.node.rocksdb_config.enable, defaults.node.rocksdb_config.enable);
 	ASSERT_EQ (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
@@ -425,6 +439,18 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	max_work_generate_multiplier = 1.0
 	max_queued_requests = 999
 	frontiers_confirmation = "always"
+	signature_cache_size = 999
+	vote_processor_threads = 3
+	account_cache_memory_mb = 999
+	block_cache_size = 999
+	block_processor_batch_target_time = 99
+	block_processor_prevalidation_threads = 9
+	unchecked_memory_mb = 77
+	write_group_commit = true
+	block_filter_bits = 7
+	account_history_index = true
+	delegators_index = true
+	pending_summary_index = true
 	[node.diagnostics.txn_tracking]
 	enable = true
 	ignore_writes_below_block_processor_max_time = false
@@ -504,6 +530,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	sync = "nosync_safe"
 	max_databases = 999
 	map_size = 999
+	checkpoint_interval = 999
+	checkpoint_bytes = 999
 
 	[node.rocksdb]
 	enable = true
@@ -591,6 +619,18 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_NE (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_EQ (conf.node.confirm_req_batches_max, defaults.node.confirm_req_batches_max);
+	ASSERT_NE (conf.node.signature_cache_size, defaults.node.signature_cache_size);
+	ASSERT_NE (conf.node.account_cache_memory_mb, defaults.node.account_cache_memory_mb);
+	ASSERT_NE (conf.node.block_cache_size, defaults.node.block_cache_size);
+	ASSERT_NE (conf.node.vote_processor_threads, defaults.node.vote_processor_threads);
+	ASSERT_NE (conf.node.block_processor_batch_target_time, defaults.node.block_processor_batch_target_time);
+	ASSERT_NE (conf.node.block_processor_prevalidation_threads, defaults.node.block_processor_prevalidation_threads);
+	ASSERT_NE (conf.node.unchecked_memory_mb, defaults.node.unchecked_memory_mb);
+	ASSERT_NE (conf.node.write_group_commit, defaults.node.write_group_commit);
+	ASSERT_NE (conf.node.block_filter_bits, defaults.node.block_filter_bits);
+	ASSERT_NE (conf.node.account_history_index, defaults.node.account_history_index);
+	ASSERT_NE (conf.node.delegators_index, defaults.node.delegators_index);
+	ASSERT_NE (conf.node.pending_summary_index, defaults.node.pending_summary_index);
 
 	ASSERT_NE (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_NE (conf.node.logging.flush, defaults.node.logging.flush);
@@ -658,6 +698,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_NE (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_NE (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_NE (conf.node.lmdb_config.checkpoint_interval, defaults.node.lmdb_config.checkpoint_interval);
+	ASSERT_NE (conf.node.lmdb_config.checkpoint_bytes, defaults.node.lmdb_config.checkpoint_bytes);
 
 	ASSERT_NE (conf.node.rocksdb_config.enable, defaults.node.rocksdb_config.enable);
 	ASSERT_NE (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
@@ -1,3 +1,4 @@
+#include <vban/crypto_lib/random_pool.hpp>
 #include <vban/secure/common.hpp>
 #include <vban/test_common/testutil.hpp>
 
@@ -500,6 +501,39 @@ TEST (uint512_union, hash)
 	}
 }
 
+TEST (uint256_fixed, arithmetic)
+{
+	vban::uint256_t max (std::numeric_limits<vban::uint256_t>::max ());
+	ASSERT_EQ (max, vban::uint256_fixed (max).number ());
+	ASSERT_EQ (0, vban::uint256_fixed (vban::uint256_t (0)).number ());
+	// Carry and borrow across every limb
+	ASSERT_EQ (vban::uint256_t (1) << 64, (vban::uint256_fixed (std::numeric_limits<uint64_t>::max ()) + vban::uint256_fixed (1)).number ());
+	ASSERT_EQ (0, (vban::uint256_fixed (max) + vban::uint256_fixed (1)).number ());
+	ASSERT_EQ (max, (vban::uint256_fixed (0) - vban::uint256_fixed (1)).number ());
+	ASSERT_TRUE ((vban::uint256_fixed (max) + vban::uint256_fixed (1)).is_zero ());
+	ASSERT_LT (vban::uint256_fixed (std::numeric_limits<uint64_t>::max ()), vban::uint256_fixed (vban::uint256_t (1) << 64));
+	ASSERT_GT (vban::uint256_fixed (max), vban::uint256_fixed (vban::uint256_t (1) << 255));
+	for (auto i (0); i < 1000; ++i)
+	{
+		vban::uint256_union a;
+		vban::uint256_union b;
+		vban::random_pool::generate_block (a.bytes.data (), a.bytes.size ());
+		vban::random_pool::generate_block (b.bytes.data (), b.bytes.size ());
+		vban::uint256_fixed a_fixed (a);
+		vban::uint256_fixed b_fixed (b);
+		ASSERT_EQ (a, a_fixed.to_uint256_union ());
+		ASSERT_EQ (a_fixed, vban::uint256_fixed (a.number ()));
+		ASSERT_EQ (vban::uint256_t (a.number () + b.number ()), (a_fixed + b_fixed).number ());
+		ASSERT_EQ (vban::uint256_t (a.number () - b.number ()), (a_fixed - b_fixed).number ());
+		ASSERT_EQ (a.number () < b.number (), a_fixed < b_fixed);
+		ASSERT_EQ (a.number () >= b.number (), a_fixed >= b_fixed);
+		vban::uint128_union amount (a.qwords[0]);
+		amount.qwords[1] = b.qwords[0];
+		ASSERT_EQ (amount, vban::uint256_fixed (amount).to_uint128_union ());
+		ASSERT_EQ (amount.number (), vban::uint256_fixed (amount).number ());
+	}
+}
+
 namespace
 {
 template <typename Union, typename Bound>
@@ -0,0 +1,135 @@
+#include <vban/lib/logger_mt.hpp>
+#include <vban/node/testing.hpp>
+#include <vban/node/unchecked_map.hpp>
+#include <vban/secure/blockstore.hpp>
+#include <vban/secure/utility.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace
+{
+std::shared_ptr<vban::send_block> make_send (vban::block_hash const & previous_a, uint64_t balance_a)
+{
+	return std::make_shared<vban::send_block> (previous_a, 1, balance_a, vban::keypair ().prv, 4, 5);
+}
+
+vban::unchecked_info make_info (std::shared_ptr<vban::block> const & block_a)
+{
+	return vban::unchecked_info (block_a, block_a->account (), vban::seconds_since_epoch ());
+}
+}
+
+TEST (unchecked_map, spill)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::unchecked_map unchecked (*store, 2 * vban::unchecked_map::entry_size);
+	std::vector<std::shared_ptr<vban::send_block>> blocks;
+	for (auto i (0); i < 4; ++i)
+	{
+		blocks.push_back (make_send (i + 1, i));
+	}
+	auto transaction (store->tx_begin_write ());
+	for (auto & block : blocks)
+	{
+		unchecked.put (transaction, vban::unchecked_key (block->previous (), block->hash ()), make_info (block));
+	}
+	ASSERT_EQ (2, unchecked.memory_size ());
+	ASSERT_TRUE (unchecked.disk_used ());
+	ASSERT_EQ (2, store->unchecked_count (transaction));
+	ASSERT_EQ (4, unchecked.count (transaction));
+	for (auto & block : blocks)
+	{
+		vban::unchecked_key key (block->previous (), block->hash ());
+		ASSERT_TRUE (unchecked.exists (transaction, key));
+		auto found (unchecked.get (transaction, block->previous ()));
+		ASSERT_EQ (1, found.size ());
+		ASSERT_EQ (*block, *found[0].block);
+	}
+	// Iteration merges both halves in key order
+	std::vector<vban::unchecked_key> keys;
+	unchecked.for_each (transaction, vban::unchecked_key{}, [&keys] (vban::unchecked_key const & key_a, vban::unchecked_info const &) {
+		keys.push_back (key_a);
+		return true;
+	});
+	ASSERT_EQ (4, keys.size ());
+	ASSERT_TRUE (std::is_sorted (keys.begin (), keys.end ()));
+	unchecked.del (transaction, keys[0]);
+	unchecked.del (transaction, keys[3]);
+	ASSERT_EQ (2, unchecked.count (transaction));
+	unchecked.clear (transaction);
+	ASSERT_EQ (0, unchecked.count (transaction));
+	ASSERT_FALSE (unchecked.disk_used ());
+}
+
+TEST (unchecked_map, release_chain)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::unchecked_map unchecked (*store, 3 * vban::unchecked_map::entry_size);
+	vban::block_hash missing (1);
+	// missing <- send1 <- send2 <- send3, send2 also has a fork depending on send1
+	auto send1 (make_send (missing, 10));
+	auto send2 (make_send (send1->hash (), 9));
+	auto fork2 (make_send (send1->hash (), 8));
+	auto send3 (make_send (send2->hash (), 7));
+	auto unrelated (make_send (2, 6));
+	auto transaction (store->tx_begin_write ());
+	// Inserted out of order, part of them spilling to disk
+	for (auto const & block : { send3, fork2, send2, unrelated, send1 })
+	{
+		unchecked.put (transaction, vban::unchecked_key (block->previous (), block->hash ()), make_info (block));
+	}
+	ASSERT_EQ (5, unchecked.count (transaction));
+	auto released (unchecked.release (transaction, missing, 16));
+	ASSERT_EQ (4, released.size ());
+	ASSERT_EQ (*send1, *released[0].block);
+	std::unordered_set<vban::block_hash> seen{ missing };
+	for (auto & info : released)
+	{
+		ASSERT_EQ (1, seen.count (info.block->previous ()));
+		seen.insert (info.block->hash ());
+	}
+	ASSERT_EQ (1, unchecked.count (transaction));
+	ASSERT_TRUE (unchecked.exists (transaction, vban::unchecked_key (unrelated->previous (), unrelated->hash ())));
+	ASSERT_TRUE (unchecked.release (transaction, missing, 16).empty ());
+}
+
+TEST (unchecked_map, release_bounded)
+{
+	vban::logger_mt logger;
+	auto store = vban::make_store (logger, vban::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	vban::unchecked_map unchecked (*store, 1024 * vban::unchecked_map::entry_size);
+	vban::block_hash missing (1);
+	// missing <- send1 <- send2 <- send3 <- send4, fork1 also depends on missing
+	auto send1 (make_send (missing, 10));
+	auto fork1 (make_send (missing, 9));
+	auto send2 (make_send (send1->hash (), 8));
+	auto send3 (make_send (send2->hash (), 7));
+	auto send4 (make_send (send3->hash (), 6));
+	auto transaction (store->tx_begin_write ());
+	for (auto const & block : { send1, fork1, send2, send3, send4 })
+	{
+		unchecked.put (transaction, vban::unchecked_key (block->previous (), block->hash ()), make_info (block));
+	}
+	// Direct dependents are released even past the limit, nothing would release them later
+	auto released (unchecked.release (transaction, missing, 1));
+	ASSERT_EQ (2, released.size ());
+	ASSERT_EQ (3, unchecked.count (transaction));
+	// Every dependent of a followed block is released, the rest waits on the last released block
+	released = unchecked.release (transaction, send1->hash (), 2);
+	ASSERT_EQ (2, released.size ());
+	ASSERT_EQ (*send2, *released[0].block);
+	ASSERT_EQ (*send3, *released[1].block);
+	ASSERT_EQ (1, unchecked.count (transaction));
+	released = unchecked.release (transaction, send3->hash (), 2);
+	ASSERT_EQ (1, released.size ());
+	ASSERT_EQ (*send4, *released[0].block);
+	ASSERT_EQ (0, unchecked.count (transaction));
+}
@@ -67,6 +67,32 @@ TEST (vote_processor, flush)
 	ASSERT_TRUE (node.vote_processor.empty ());
 }
 
+TEST (vote_processor, multiple_threads)
+{
+	vban::system system;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.vote_processor_threads = 4;
+	auto & node (*system.add_node (node_config));
+	vban::genesis genesis;
+	genesis.open->sideband_set (vban::block_sideband (vban::genesis_account, 0, vban::genesis_amount, 1, vban::seconds_since_epoch (), vban::epoch::epoch_0, false, false, false, vban::epoch::epoch_0));
+	node.block_confirm (genesis.open);
+	auto election (node.active.election (genesis.open->qualified_root ()));
+	ASSERT_NE (nullptr, election);
+	auto channel (std::make_shared<vban::transport::channel_loopback> (node));
+	size_t const count (256);
+	for (size_t i (0); i < count; ++i)
+	{
+		vban::keypair key;
+		auto vote (std::make_shared<vban::vote> (key.pub, key.prv, 1, std::vector<vban::block_hash>{ genesis.open->hash () }));
+		ASSERT_FALSE (node.vote_processor.vote (vote, channel));
+	}
+	node.vote_processor.flush ();
+	ASSERT_TRUE (node.vote_processor.empty ());
+	ASSERT_EQ (count, node.vote_processor.total_processed);
+	// Every voter is recorded next to the election's initial placeholder vote
+	ASSERT_EQ (count + 1, election->votes ().size ());
+}
+
 TEST (vote_processor, invalid_signature)
 {
 	vban::system system{ 1 };
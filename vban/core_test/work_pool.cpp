@@ -157,6 +157,33 @@ TEST (work, difficulty)
 	ASSERT_GT (result_difficulty2, difficulty2);
 }
 
+TEST (work, cpu_kernels)
+{
+	vban::root root;
+	vban::random_pool::generate_block (root.bytes.data (), root.bytes.size ());
+	for (auto kernel : { vban::cpu_work::kernel::scalar, vban::cpu_work::kernel::sse41, vban::cpu_work::kernel::avx2 })
+	{
+		if (!vban::cpu_work::supported (kernel))
+		{
+			continue;
+		}
+		vban::cpu_work cpu (kernel);
+		ASSERT_EQ (kernel, cpu.kernel_m);
+		ASSERT_LE (cpu.lanes (), vban::cpu_work::max_lanes);
+		std::array<uint64_t, vban::cpu_work::max_lanes> nonces;
+		std::array<uint64_t, vban::cpu_work::max_lanes> values;
+		for (auto i (0); i < 64; ++i)
+		{
+			vban::random_pool::generate_block (reinterpret_cast<uint8_t *> (nonces.data ()), nonces.size () * sizeof (uint64_t));
+			cpu.values (root, nonces.data (), values.data ());
+			for (auto j (0u); j < cpu.lanes (); ++j)
+			{
+				ASSERT_EQ (vban::work_v1::value (root, nonces[j]), values[j]);
+			}
+		}
+	}
+}
+
 TEST (work, eco_pow)
 {
 	auto work_func = [] (std::promise<std::chrono::nanoseconds> & promise, std::chrono::nanoseconds interval) {
@@ -0,0 +1,290 @@
+#include <vban/lib/cpu_work.hpp>
+#include <vban/lib/utility.hpp>
+#include <vban/lib/work.hpp>
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VBAN_CPU_WORK_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#define VBAN_CPU_WORK_TARGET_SSE41
+#define VBAN_CPU_WORK_TARGET_AVX2
+#else
+#include <immintrin.h>
+#define VBAN_CPU_WORK_TARGET_SSE41 __attribute__ ((target ("sse4.1")))
+#define VBAN_CPU_WORK_TARGET_AVX2 __attribute__ ((target ("avx2")))
+#endif
+#endif
+
+#ifdef VBAN_CPU_WORK_X86
+namespace
+{
+/*
+ * The work_1 hash is blake2b-64 over an 8 byte nonce followed by the 32 byte root. The 40 byte input always fits
+ * a single (final) compression block, so each lane runs one compression with the counter fixed at 40 and the final
+ * flag set. Only the nonce word differs between lanes, the root words are broadcast and the padding words are zero.
+ */
+uint64_t constexpr iv[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+// Parameter block for an unkeyed 8 byte digest: depth 1, fanout 1, digest length 8
+uint64_t constexpr h0 = iv[0] ^ 0x01010008ULL;
+uint64_t constexpr input_size = sizeof (uint64_t) + 32;
+uint8_t constexpr sigma[12][16] = {
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+	{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+	{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+	{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+	{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+	{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+	{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+	{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+	{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+// Each kernel runs two independent vector groups side by side so the CPU can overlap their dependency chains
+size_t constexpr groups = 2;
+
+// clang-format off
+#define VBAN_CPU_WORK_G(r, i, a, b, c, d)                                                 \
+	for (size_t k = 0; k < groups; ++k)                                                   \
+	{                                                                                     \
+		v[k][a] = VBAN_ADD (VBAN_ADD (v[k][a], v[k][b]), m[k][sigma[r][2 * i]]);         \
+		v[k][d] = VBAN_ROT32 (VBAN_XOR (v[k][d], v[k][a]));                              \
+		v[k][c] = VBAN_ADD (v[k][c], v[k][d]);                                           \
+		v[k][b] = VBAN_ROT24 (VBAN_XOR (v[k][b], v[k][c]));                              \
+		v[k][a] = VBAN_ADD (VBAN_ADD (v[k][a], v[k][b]), m[k][sigma[r][2 * i + 1]]);     \
+		v[k][d] = VBAN_ROT16 (VBAN_XOR (v[k][d], v[k][a]));                              \
+		v[k][c] = VBAN_ADD (v[k][c], v[k][d]);                                           \
+		v[k][b] = VBAN_ROT63 (VBAN_XOR (v[k][b], v[k][c]));                              \
+	}
+
+#define VBAN_CPU_WORK_ROUND(r)                 \
+	VBAN_CPU_WORK_G (r, 0, 0, 4, 8, 12);      \
+	VBAN_CPU_WORK_G (r, 1, 1, 5, 9, 13);      \
+	VBAN_CPU_WORK_G (r, 2, 2, 6, 10, 14);     \
+	VBAN_CPU_WORK_G (r, 3, 3, 7, 11, 15);     \
+	VBAN_CPU_WORK_G (r, 4, 0, 5, 10, 15);     \
+	VBAN_CPU_WORK_G (r, 5, 1, 6, 11, 12);     \
+	VBAN_CPU_WORK_G (r, 6, 2, 7, 8, 13);      \
+	VBAN_CPU_WORK_G (r, 7, 3, 4, 9, 14);
+
+#define VBAN_CPU_WORK_ROUNDS     \
+	VBAN_CPU_WORK_ROUND (0);    \
+	VBAN_CPU_WORK_ROUND (1);    \
+	VBAN_CPU_WORK_ROUND (2);    \
+	VBAN_CPU_WORK_ROUND (3);    \
+	VBAN_CPU_WORK_ROUND (4);    \
+	VBAN_CPU_WORK_ROUND (5);    \
+	VBAN_CPU_WORK_ROUND (6);    \
+	VBAN_CPU_WORK_ROUND (7);    \
+	VBAN_CPU_WORK_ROUND (8);    \
+	VBAN_CPU_WORK_ROUND (9);    \
+	VBAN_CPU_WORK_ROUND (10);   \
+	VBAN_CPU_WORK_ROUND (11);
+
+// Loads the message and initial state for every group, given VBAN_SET1 and VBAN_LOAD for the vector type
+#define VBAN_CPU_WORK_INIT(lanes_per_group)                                                          \
+	for (size_t k = 0; k < groups; ++k)                                                              \
+	{                                                                                                \
+		m[k][0] = VBAN_LOAD (nonces_a + k * lanes_per_group);                                        \
+		for (size_t j = 1; j < 16; ++j)                                                              \
+		{                                                                                            \
+			m[k][j] = VBAN_SET1 (j <= root_a.size () ? root_a[j - 1] : 0);                           \
+		}                                                                                            \
+		v[k][0] = VBAN_SET1 (h0);                                                                    \
+		for (size_t j = 1; j < 8; ++j)                                                               \
+		{                                                                                            \
+			v[k][j] = VBAN_SET1 (iv[j]);                                                             \
+		}                                                                                            \
+		for (size_t j = 0; j < 8; ++j)                                                               \
+		{                                                                                            \
+			v[k][8 + j] = VBAN_SET1 (iv[j]);                                                         \
+		}                                                                                            \
+		v[k][12] = VBAN_SET1 (iv[4] ^ input_size);                                                   \
+		v[k][14] = VBAN_SET1 (~iv[6]);                                                               \
+	}
+
+// Only the first 8 bytes of the digest are needed: h0 ^ v0 ^ v8
+#define VBAN_CPU_WORK_STORE(lanes_per_group)                                                         \
+	for (size_t k = 0; k < groups; ++k)                                                              \
+	{                                                                                                \
+		VBAN_STORE (values_a + k * lanes_per_group, VBAN_XOR (VBAN_SET1 (h0), VBAN_XOR (v[k][0], v[k][8]))); \
+	}
+// clang-format on
+
+VBAN_CPU_WORK_TARGET_SSE41 void values_sse41 (std::array<uint64_t, 4> const & root_a, uint64_t const * nonces_a, uint64_t * values_a)
+{
+	__m128i const r16 = _mm_setr_epi8 (2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+	__m128i const r24 = _mm_setr_epi8 (3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+#define VBAN_ADD(a, b) _mm_add_epi64 (a, b)
+#define VBAN_XOR(a, b) _mm_xor_si128 (a, b)
+#define VBAN_ROT32(x) _mm_shuffle_epi32 (x, _MM_SHUFFLE (2, 3, 0, 1))
+#define VBAN_ROT24(x) _mm_shuffle_epi8 (x, r24)
+#define VBAN_ROT16(x) _mm_shuffle_epi8 (x, r16)
+#define VBAN_ROT63(x) _mm_xor_si128 (_mm_srli_epi64 (x, 63), _mm_add_epi64 (x, x))
+#define VBAN_SET1(x) _mm_set1_epi64x (static_cast<long long> (x))
+#define VBAN_LOAD(p) _mm_loadu_si128 (reinterpret_cast<__m128i const *> (p))
+#define VBAN_STORE(p, x) _mm_storeu_si128 (reinterpret_cast<__m128i *> (p), x)
+	__m128i m[groups][16];
+	__m128i v[groups][16];
+	VBAN_CPU_WORK_INIT (2);
+	VBAN_CPU_WORK_ROUNDS;
+	VBAN_CPU_WORK_STORE (2);
+#undef VBAN_ADD
+#undef VBAN_XOR
+#undef VBAN_ROT32
+#undef VBAN_ROT24
+#undef VBAN_ROT16
+#undef VBAN_ROT63
+#undef VBAN_SET1
+#undef VBAN_LOAD
+#undef VBAN_STORE
+}
+
+VBAN_CPU_WORK_TARGET_AVX2 void values_avx2 (std::array<uint64_t, 4> const & root_a, uint64_t const * nonces_a, uint64_t * values_a)
+{
+	__m256i const r16 = _mm256_setr_epi8 (2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+	__m256i const r24 = _mm256_setr_epi8 (3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+#define VBAN_ADD(a, b) _mm256_add_epi64 (a, b)
+#define VBAN_XOR(a, b) _mm256_xor_si256 (a, b)
+#define VBAN_ROT32(x) _mm256_shuffle_epi32 (x, _MM_SHUFFLE (2, 3, 0, 1))
+#define VBAN_ROT24(x) _mm256_shuffle_epi8 (x, r24)
+#define VBAN_ROT16(x) _mm256_shuffle_epi8 (x, r16)
+#define VBAN_ROT63(x) _mm256_xor_si256 (_mm256_srli_epi64 (x, 63), _mm256_add_epi64 (x, x))
+#define VBAN_SET1(x) _mm256_set1_epi64x (static_cast<long long> (x))
+#define VBAN_LOAD(p) _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (p))
+#define VBAN_STORE(p, x) _mm256_storeu_si256 (reinterpret_cast<__m256i *> (p), x)
+	__m256i m[groups][16];
+	__m256i v[groups][16];
+	VBAN_CPU_WORK_INIT (4);
+	VBAN_CPU_WORK_ROUNDS;
+	VBAN_CPU_WORK_STORE (4);
+#undef VBAN_ADD
+#undef VBAN_XOR
+#undef VBAN_ROT32
+#undef VBAN_ROT24
+#undef VBAN_ROT16
+#undef VBAN_ROT63
+#undef VBAN_SET1
+#undef VBAN_LOAD
+#undef VBAN_STORE
+}
+
+#undef VBAN_CPU_WORK_G
+#undef VBAN_CPU_WORK_ROUND
+#undef VBAN_CPU_WORK_ROUNDS
+#undef VBAN_CPU_WORK_INIT
+#undef VBAN_CPU_WORK_STORE
+}
+#endif
+
+vban::cpu_work::cpu_work () :
+	cpu_work (detect ())
+{
+}
+
+vban::cpu_work::cpu_work (vban::cpu_work::kernel kernel_a) :
+	kernel_m (supported (kernel_a) ? kernel_a : vban::cpu_work::kernel::scalar)
+{
+}
+
+size_t vban::cpu_work::lanes () const
+{
+	size_t result (1);
+	switch (kernel_m)
+	{
+		case vban::cpu_work::kernel::avx2:
+			result = 8;
+			break;
+		case vban::cpu_work::kernel::sse41:
+			result = 4;
+			break;
+		case vban::cpu_work::kernel::scalar:
+			break;
+	}
+	debug_assert (result <= max_lanes);
+	return result;
+}
+
+void vban::cpu_work::values (vban::root const & root_a, uint64_t const * nonces_a, uint64_t * values_a) const
+{
+#ifdef VBAN_CPU_WORK_X86
+	if (kernel_m != vban::cpu_work::kernel::scalar)
+	{
+		std::array<uint64_t, 4> root_l;
+		static_assert (sizeof (root_l) == sizeof (root_a.bytes), "Root must be four message words");
+		std::memcpy (root_l.data (), root_a.bytes.data (), sizeof (root_l));
+		if (kernel_m == vban::cpu_work::kernel::avx2)
+		{
+			values_avx2 (root_l, nonces_a, values_a);
+		}
+		else
+		{
+			values_sse41 (root_l, nonces_a, values_a);
+		}
+		return;
+	}
+#endif
+	values_a[0] = vban::work_v1::value (root_a, nonces_a[0]);
+}
+
+bool vban::cpu_work::supported (vban::cpu_work::kernel kernel_a)
+{
+	bool result (kernel_a == vban::cpu_work::kernel::scalar);
+#if defined(VBAN_CPU_WORK_X86) && !defined(VBAN_FUZZER_TEST)
+	if (!result)
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid (info, 1);
+		auto sse41 ((info[2] & (1 << 19)) != 0);
+		auto avx_os ((info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv (0) & 0x6) == 0x6);
+		__cpuidex (info, 7, 0);
+		auto avx2 (avx_os && (info[1] & (1 << 5)) != 0);
+#else
+		__builtin_cpu_init ();
+		auto sse41 (__builtin_cpu_supports ("sse4.1") != 0);
+		auto avx2 (__builtin_cpu_supports ("avx2") != 0);
+#endif
+		result = kernel_a == vban::cpu_work::kernel::avx2 ? avx2 : sse41;
+	}
+#endif
+	return result;
+}
+
+vban::cpu_work::kernel vban::cpu_work::detect ()
+{
+	auto result (vban::cpu_work::kernel::scalar);
+	if (supported (vban::cpu_work::kernel::avx2))
+	{
+		result = vban::cpu_work::kernel::avx2;
+	}
+	else if (supported (vban::cpu_work::kernel::sse41))
+	{
+		result = vban::cpu_work::kernel::sse41;
+	}
+	return result;
+}
+
+std::string vban::to_string (vban::cpu_work::kernel kernel_a)
+{
+	std::string result ("scalar");
+	switch (kernel_a)
+	{
+		case vban::cpu_work::kernel::avx2:
+			result = "avx2";
+			break;
+		case vban::cpu_work::kernel::sse41:
+			result = "sse4.1";
+			break;
+		case vban::cpu_work::kernel::scalar:
+			break;
+	}
+	return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vban
+{
+class root;
+/**
+ * Evaluates the work_1 blake2b hash for several nonces at once, using the widest SIMD kernel the host CPU supports.
+ * The kernel is selected once at construction through CPUID; hosts without SSE4.1 fall back to the scalar blake2b path.
+ */
+class cpu_work final
+{
+public:
+	enum class kernel
+	{
+		scalar,
+		sse41,
+		avx2
+	};
+	cpu_work ();
+	explicit cpu_work (vban::cpu_work::kernel);
+	/** Number of nonces evaluated by each call to values () */
+	size_t lanes () const;
+	/** Writes the work value of nonces_a[i] into values_a[i] for every i < lanes () */
+	void values (vban::root const &, uint64_t const * nonces_a, uint64_t * values_a) const;
+	/** Widest kernel supported by the host CPU */
+	static vban::cpu_work::kernel detect ();
+	static bool supported (vban::cpu_work::kernel);
+	static size_t constexpr max_lanes = 8;
+	vban::cpu_work::kernel const kernel_m;
+};
+std::string to_string (vban::cpu_work::kernel);
+}
@@ -21,11 +21,16 @@ vban::error vban::lmdb_config::serialize_toml (vban::tomlconfig & toml) const
 		case vban::lmdb_config::sync_strategy::nosync_unsafe_large_memory:
 			sync_string = "nosync_unsafe_large_memory";
 			break;
+		case vban::lmdb_config::sync_strategy::checkpoint:
+			sync_string = "checkpoint";
+			break;
 	}
 
-	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory}");
+	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory, checkpoint}");
 	toml.put ("max_databases", max_databases, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.vban.org/integration-guides/key-management/).\ntype:uin32");
 	toml.put ("map_size", map_size, "Maximum ledger database map size in bytes.\ntype:uint64");
+	toml.put ("checkpoint_interval", checkpoint_interval.count (), "Maximum time in milliseconds between flushes when the sync strategy is checkpoint.\ntype:milliseconds");
+	toml.put ("checkpoint_bytes", checkpoint_bytes, "Bytes written to the ledger database after which a flush is started early when the sync strategy is checkpoint.\ntype:uint64");
 	return toml.get_error ();
 }
 
@@ -35,6 +40,10 @@ vban::error vban::lmdb_config::deserialize_toml (vban::tomlconfig & toml, bool i
 	auto default_max_databases = max_databases;
 	toml.get_optional<uint32_t> ("max_databases", max_databases);
 	toml.get_optional<size_t> ("map_size", map_size);
+	auto checkpoint_interval_l (checkpoint_interval.count ());
+	toml.get_optional ("checkpoint_interval", checkpoint_interval_l);
+	checkpoint_interval = std::chrono::milliseconds (checkpoint_interval_l);
+	toml.get_optional<size_t> ("checkpoint_bytes", checkpoint_bytes);
 
 	// For now we accept either setting, but not both
 	if (!params.network.is_dev_network () && is_deprecated_lmdb_dbs_used && default_max_databases != max_databases)
@@ -62,6 +71,10 @@ vban::error vban::lmdb_config::deserialize_toml (vban::tomlconfig & toml, bool i
 		{
 			sync = vban::lmdb_config::sync_strategy::nosync_unsafe_large_memory;
 		}
+		else if (sync_string == "checkpoint")
+		{
+			sync = vban::lmdb_config::sync_strategy::checkpoint;
+		}
 		else
 		{
 			toml.get_error ().set (sync_string + " is not a valid sync option");
@@ -2,6 +2,7 @@
 
 #include <vban/lib/errors.hpp>
 
+#include <chrono>
 #include <thread>
 
 namespace vban
@@ -36,7 +37,14 @@ public:
 		 * may be slower.
 		 * @warning Do not use this option if external processes uses the database concurrently.
 		 */
-		nosync_unsafe_large_memory
+		nosync_unsafe_large_memory,
+
+		/**
+		 * Do not flush on commit, a background thread flushes every checkpoint_interval or once checkpoint_bytes
+		 * have been written. A system crash loses the commits made since the last checkpoint and, on filesystems
+		 * without write ordering, has the same risks as nosync_unsafe.
+		 */
+		checkpoint
 	};
 
 	vban::error serialize_toml (vban::tomlconfig & toml_a) const;
@@ -46,5 +54,9 @@ public:
 	sync_strategy sync{ always };
 	uint32_t max_databases{ 128 };
 	size_t map_size{ 256ULL * 1024 * 1024 * 1024 };
+	/** Maximum time between flushes with the checkpoint sync strategy */
+	std::chrono::milliseconds checkpoint_interval{ 1000 };
+	/** Bytes written to the ledger after which a flush is started early with the checkpoint sync strategy */
+	size_t checkpoint_bytes{ 64 * 1024 * 1024 };
 };
 }
@@ -250,8 +250,14 @@ char const * vban::mutex_identifier (mutexes mutex)
 	{
 		case mutexes::active:
 			return "active";
+		case mutexes::active_blocks:
+			return "active_blocks";
+		case mutexes::active_roots:
+			return "active_roots";
 		case mutexes::block_arrival:
 			return "block_arrival";
+		case mutexes::block_prevalidation:
+			return "block_prevalidation";
 		case mutexes::block_processor:
 			return "block_processor";
 		case mutexes::block_uniquer:
@@ -264,16 +270,28 @@ char const * vban::mutex_identifier (mutexes mutex)
 			return "election_winner_details";
 		case mutexes::gap_cache:
 			return "gap_cache";
+		case mutexes::mdb_checkpoint:
+			return "mdb_checkpoint";
 		case mutexes::network_filter:
 			return "network_filter";
 		case mutexes::observer_set:
 			return "observer_set";
+		case mutexes::representative_dictionary:
+			return "representative_dictionary";
+		case mutexes::representative_key_cache:
+			return "representative_key_cache";
 		case mutexes::request_aggregator:
 			return "request_aggregator";
+		case mutexes::signature_cache:
+			return "signature_cache";
 		case mutexes::state_block_signature_verification:
 			return "state_block_signature_verification";
+		case mutexes::store_cache:
+			return "store_cache";
 		case mutexes::telemetry:
 			return "telemetry";
+		case mutexes::unchecked_map:
+			return "unchecked_map";
 		case mutexes::vote_generator:
 			return "vote_generator";
 		case mutexes::vote_processor:
@@ -20,18 +20,27 @@ bool any_filters_registered ();
 enum class mutexes
 {
 	active,
+	active_blocks,
+	active_roots,
 	block_arrival,
+	block_prevalidation,
 	block_processor,
 	block_uniquer,
 	blockstore_cache,
 	confirmation_height_processor,
 	election_winner_details,
 	gap_cache,
+	mdb_checkpoint,
 	network_filter,
 	observer_set,
+	representative_dictionary,
+	representative_key_cache,
 	request_aggregator,
+	signature_cache,
 	state_block_signature_verification,
+	store_cache,
 	telemetry,
+	unchecked_map,
 	vote_generator,
 	vote_processor,
 	vote_uniquer,
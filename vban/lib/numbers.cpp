@@ -9,6 +9,8 @@
 
 #include <crypto/ed25519-donna/ed25519.h>
 
+#include <boost/endian/conversion.hpp>
+
 namespace
 {
 char const * account_lookup ("13456789abcdefghijkmnopqrstuwxyz");
@@ -438,6 +440,22 @@ bool vban::validate_message_batch (const unsigned char ** m, size_t * mlen, cons
 	return true;
 }
 
+bool vban::validate_message_batch (const unsigned char ** m, size_t * mlen, const unsigned char ** pk, ed25519_unpacked_public_key const ** unpacked, const unsigned char ** RS, size_t num, int * valid)
+{
+	for (size_t i{ 0 }; i < num; ++i)
+	{
+		if (unpacked[i] != nullptr)
+		{
+			valid[i] = (0 == ed25519_sign_open_unpacked (m[i], mlen[i], pk[i], unpacked[i], RS[i]));
+		}
+		else
+		{
+			valid[i] = (0 == ed25519_sign_open (m[i], mlen[i], pk[i], RS[i]));
+		}
+	}
+	return true;
+}
+
 vban::uint128_union::uint128_union (std::string const & string_a)
 {
 	auto error (decode_hex (string_a));
@@ -483,6 +501,61 @@ vban::uint256_t vban::uint128_union::number () const
 	return result;
 }
 
+vban::uint256_fixed::uint256_fixed (vban::uint256_t const & number_a)
+{
+	// The fixed width multiprecision backend also stores its limbs least significant first
+	auto const & backend (number_a.backend ());
+	auto constexpr limb_bits (sizeof (boost::multiprecision::limb_type) * 8);
+	for (unsigned i (0); i < backend.size (); ++i)
+	{
+		qwords[i * limb_bits / 64] |= static_cast<uint64_t> (backend.limbs ()[i]) << (i * limb_bits % 64);
+	}
+}
+
+vban::uint256_fixed::uint256_fixed (vban::uint128_union const & value_a) :
+	qwords{ boost::endian::big_to_native (value_a.qwords[1]), boost::endian::big_to_native (value_a.qwords[0]), 0, 0 }
+{
+}
+
+vban::uint256_fixed::uint256_fixed (vban::uint256_union const & value_a) :
+	qwords{ boost::endian::big_to_native (value_a.qwords[3]), boost::endian::big_to_native (value_a.qwords[2]), boost::endian::big_to_native (value_a.qwords[1]), boost::endian::big_to_native (value_a.qwords[0]) }
+{
+}
+
+vban::uint256_t vban::uint256_fixed::number () const
+{
+	vban::uint256_t result;
+	auto & backend (result.backend ());
+	auto constexpr limb_bits (sizeof (boost::multiprecision::limb_type) * 8);
+	auto constexpr limb_count (256 / limb_bits);
+	backend.resize (limb_count, limb_count);
+	for (unsigned i (0); i < limb_count; ++i)
+	{
+		backend.limbs ()[i] = static_cast<boost::multiprecision::limb_type> (qwords[i * limb_bits / 64] >> (i * limb_bits % 64));
+	}
+	backend.normalize ();
+	return result;
+}
+
+vban::uint128_union vban::uint256_fixed::to_uint128_union () const
+{
+	debug_assert (qwords[2] == 0 && qwords[3] == 0);
+	vban::uint128_union result;
+	result.qwords[0] = boost::endian::native_to_big (qwords[1]);
+	result.qwords[1] = boost::endian::native_to_big (qwords[0]);
+	return result;
+}
+
+vban::uint256_union vban::uint256_fixed::to_uint256_union () const
+{
+	vban::uint256_union result;
+	for (auto i (0); i < 4; ++i)
+	{
+		result.qwords[3 - i] = boost::endian::native_to_big (qwords[i]);
+	}
+	return result;
+}
+
 void vban::uint128_union::encode_hex (std::string & text) const
 {
 	debug_assert (text.empty ());
@@ -2,6 +2,8 @@
 
 #include <boost/multiprecision/cpp_int.hpp>
 
+struct ed25519_unpacked_public_key_t;
+
 namespace vban
 {
 using uint128_t = boost::multiprecision::uint128_t;
@@ -235,11 +237,106 @@ public:
 	}
 };
 
+/**
+ * Unsigned 256 bit integer held in four 64 bit limbs, least significant first.
+ * Arithmetic wraps around like vban::uint256_t, without the multiprecision overhead. Used to accumulate balances and
+ * weights on hot paths, convert to vban::uint256_t at API boundaries.
+ */
+class uint256_fixed final
+{
+public:
+	uint256_fixed () = default;
+	uint256_fixed (uint64_t value_a) :
+		qwords{ value_a, 0, 0, 0 }
+	{
+	}
+	uint256_fixed (vban::uint256_t const &);
+	uint256_fixed (vban::uint128_union const &);
+	uint256_fixed (vban::uint256_union const &);
+	vban::uint256_t number () const;
+	vban::uint128_union to_uint128_union () const;
+	vban::uint256_union to_uint256_union () const;
+
+	uint256_fixed & operator+= (vban::uint256_fixed const & other_a)
+	{
+		uint64_t carry (0);
+		for (auto i (0); i < 4; ++i)
+		{
+			auto sum (qwords[i] + carry);
+			carry = sum < carry;
+			auto result (sum + other_a.qwords[i]);
+			carry += result < sum;
+			qwords[i] = result;
+		}
+		return *this;
+	}
+	uint256_fixed & operator-= (vban::uint256_fixed const & other_a)
+	{
+		uint64_t borrow (0);
+		for (auto i (0); i < 4; ++i)
+		{
+			auto subtrahend (other_a.qwords[i] + borrow);
+			auto next_borrow (static_cast<uint64_t> (subtrahend < borrow || qwords[i] < subtrahend));
+			qwords[i] -= subtrahend;
+			borrow = next_borrow;
+		}
+		return *this;
+	}
+	uint256_fixed operator+ (vban::uint256_fixed const & other_a) const
+	{
+		auto result (*this);
+		return result += other_a;
+	}
+	uint256_fixed operator- (vban::uint256_fixed const & other_a) const
+	{
+		auto result (*this);
+		return result -= other_a;
+	}
+	bool operator== (vban::uint256_fixed const & other_a) const
+	{
+		return qwords == other_a.qwords;
+	}
+	bool operator!= (vban::uint256_fixed const & other_a) const
+	{
+		return !(*this == other_a);
+	}
+	bool operator< (vban::uint256_fixed const & other_a) const
+	{
+		for (auto i (3); i >= 0; --i)
+		{
+			if (qwords[i] != other_a.qwords[i])
+			{
+				return qwords[i] < other_a.qwords[i];
+			}
+		}
+		return false;
+	}
+	bool operator> (vban::uint256_fixed const & other_a) const
+	{
+		return other_a < *this;
+	}
+	bool operator<= (vban::uint256_fixed const & other_a) const
+	{
+		return !(other_a < *this);
+	}
+	bool operator>= (vban::uint256_fixed const & other_a) const
+	{
+		return !(*this < other_a);
+	}
+	bool is_zero () const
+	{
+		return (qwords[0] | qwords[1] | qwords[2] | qwords[3]) == 0;
+	}
+	std::array<uint64_t, 4> qwords{};
+};
+
 vban::signature sign_message (vban::raw_key const &, vban::public_key const &, vban::uint256_union const &);
 vban::signature sign_message (vban::raw_key const &, vban::public_key const &, uint8_t const *, size_t);
 bool validate_message (vban::public_key const &, vban::uint256_union const &, vban::signature const &);
 bool validate_message (vban::public_key const &, uint8_t const *, size_t, vban::signature const &);
 bool validate_message_batch (unsigned const char **, size_t *, unsigned const char **, unsigned const char **, size_t, int *);
+/** Same as above, public keys with a non-null entry in \p unpacked_a are verified without decompressing them again */
+bool validate_message_batch (unsigned const char **, size_t *, unsigned const char **, ed25519_unpacked_public_key_t const ** unpacked_a, unsigned const char **, size_t, int *);
 vban::raw_key deterministic_key (vban::raw_key const &, uint32_t);
 vban::public_key pub_key (vban::raw_key const &);
 
@@ -3,20 +3,37 @@
 
 void vban::rep_weights::representation_add (vban::account const & source_rep_a, vban::uint256_t const & amount_a)
 {
-	vban::lock_guard<vban::mutex> guard (mutex);
-	auto source_previous (get (source_rep_a));
-	put (source_rep_a, source_previous + amount_a);
+	auto & shard_l (shards[shard_index (source_rep_a)]);
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	auto source_previous (get (shard_l, source_rep_a));
+	put (shard_l, source_rep_a, source_previous + vban::uint256_fixed (amount_a));
 }
 
 void vban::rep_weights::representation_add_dual (vban::account const & source_rep_1, vban::uint256_t const & amount_1, vban::account const & source_rep_2, vban::uint256_t const & amount_2)
 {
-	if (source_rep_1 != source_rep_2)
+	auto index_1 (shard_index (source_rep_1));
+	auto index_2 (shard_index (source_rep_2));
+	if (source_rep_1 != source_rep_2 && index_1 != index_2)
 	{
-		vban::lock_guard<vban::mutex> guard (mutex);
-		auto source_previous_1 (get (source_rep_1));
-		put (source_rep_1, source_previous_1 + amount_1);
-		auto source_previous_2 (get (source_rep_2));
-		put (source_rep_2, source_previous_2 + amount_2);
+		// Both shards are held so readers never observe the amount leaving one representative before it reaches the other
+		// Locking in shard order avoids deadlocks between concurrent transfers
+		auto & shard_1 (shards[index_1]);
+		auto & shard_2 (shards[index_2]);
+		vban::unique_lock<vban::mutex> lock_first (index_1 < index_2 ? shard_1.mutex : shard_2.mutex);
+		vban::unique_lock<vban::mutex> lock_second (index_1 < index_2 ? shard_2.mutex : shard_1.mutex);
+		auto source_previous_1 (get (shard_1, source_rep_1));
+		put (shard_1, source_rep_1, source_previous_1 + vban::uint256_fixed (amount_1));
+		auto source_previous_2 (get (shard_2, source_rep_2));
+		put (shard_2, source_rep_2, source_previous_2 + vban::uint256_fixed (amount_2));
+	}
+	else if (source_rep_1 != source_rep_2)
+	{
+		auto & shard_l (shards[index_1]);
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		auto source_previous_1 (get (shard_l, source_rep_1));
+		put (shard_l, source_rep_1, source_previous_1 + vban::uint256_fixed (amount_1));
+		auto source_previous_2 (get (shard_l, source_rep_2));
+		put (shard_l, source_rep_2, source_previous_2 + vban::uint256_fixed (amount_2));
 	}
 	else
 	{
@@ -26,70 +43,136 @@ void vban::rep_weights::representation_add_dual (vban::account const & source_re
 
 void vban::rep_weights::representation_put (vban::account const & account_a, vban::uint128_union const & representation_a)
 {
-	vban::lock_guard<vban::mutex> guard (mutex);
-	put (account_a, representation_a);
+	auto & shard_l (shards[shard_index (account_a)]);
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	put (shard_l, account_a, vban::uint256_fixed (representation_a));
 }
 
 vban::uint256_t vban::rep_weights::representation_get (vban::account const & account_a) const
 {
-	vban::lock_guard<vban::mutex> lk (mutex);
-	return get (account_a);
+	auto & shard_l (shards[shard_index (account_a)]);
+	vban::lock_guard<vban::mutex> lk (shard_l.mutex);
+	return get (shard_l, account_a).number ();
+}
+
+vban::uint256_fixed vban::rep_weights::representation_get_fixed (vban::account const & account_a) const
+{
+	auto & shard_l (shards[shard_index (account_a)]);
+	vban::lock_guard<vban::mutex> lk (shard_l.mutex);
+	return get (shard_l, account_a);
 }
 
-/** Makes a copy */
 std::unordered_map<vban::account, vban::uint256_t> vban::rep_weights::get_rep_amounts () const
 {
-	vban::lock_guard<vban::mutex> guard (mutex);
-	return rep_amounts;
+	std::unordered_map<vban::account, vban::uint256_t> result;
+	for (auto const & shard_l : shards)
+	{
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		for (auto const & entry : shard_l.rep_amounts)
+		{
+			result.emplace (entry.first, entry.second.number ());
+		}
+	}
+	return result;
 }
 
 void vban::rep_weights::copy_from (vban::rep_weights & other_a)
 {
-	vban::lock_guard<vban::mutex> guard_this (mutex);
-	vban::lock_guard<vban::mutex> guard_other (other_a.mutex);
-	for (auto const & entry : other_a.rep_amounts)
+	for (size_t i (0); i < shard_count; ++i)
+	{
+		auto & shard_l (shards[i]);
+		auto & other_shard (other_a.shards[i]);
+		vban::lock_guard<vban::mutex> guard_this (shard_l.mutex);
+		vban::lock_guard<vban::mutex> guard_other (other_shard.mutex);
+		for (auto const & entry : other_shard.rep_amounts)
+		{
+			auto prev_amount (get (shard_l, entry.first));
+			put (shard_l, entry.first, prev_amount + entry.second);
+		}
+	}
+}
+
+size_t vban::rep_weights::size () const
+{
+	size_t result (0);
+	for (auto const & shard_l : shards)
+	{
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		result += shard_l.rep_amounts.size ();
+	}
+	return result;
+}
+
+uint64_t vban::rep_weights::epoch () const
+{
+	return epoch_m.load (std::memory_order_acquire);
+}
+
+bool vban::rep_weights::changes (uint64_t epoch_a, uint64_t until_a, std::vector<vban::account> & result_a) const
+{
+	debug_assert (until_a <= epoch_m.load (std::memory_order_relaxed));
+	auto result (epoch_a > until_a);
+	for (auto i (shards.begin ()), n (shards.end ()); i != n && !result; ++i)
 	{
-		auto prev_amount (get (entry.first));
-		put (entry.first, prev_amount + entry.second);
+		// Changes up to until_a were recorded under the shard lock before the epoch was read
+		vban::lock_guard<vban::mutex> guard (i->mutex);
+		result = i->changes_evicted > epoch_a;
+		auto oldest (i->changes_count > changes_size ? i->changes_count - changes_size : 0);
+		// Epochs only grow within a shard, so the scan stops at the first change already seen
+		for (auto j (i->changes_count); !result && j > oldest && i->changes[(j - 1) % changes_size].first > epoch_a; --j)
+		{
+			auto const & change (i->changes[(j - 1) % changes_size]);
+			if (change.first <= until_a)
+			{
+				result_a.push_back (change.second);
+			}
+		}
 	}
+	return result;
 }
 
-void vban::rep_weights::put (vban::account const & account_a, vban::uint128_union const & representation_a)
+size_t vban::rep_weights::shard_index (vban::account const & account_a) const
 {
-	auto it = rep_amounts.find (account_a);
-	auto amount = representation_a.number ();
-	if (it != rep_amounts.end ())
+	// Accounts are public keys, any byte is uniformly distributed
+	return account_a.bytes[0] % shard_count;
+}
+
+void vban::rep_weights::put (shard & shard_a, vban::account const & account_a, vban::uint256_fixed const & amount_a)
+{
+	auto it = shard_a.rep_amounts.find (account_a);
+	if (it != shard_a.rep_amounts.end ())
 	{
-		it->second = amount;
+		it->second = amount_a;
 	}
 	else
 	{
-		rep_amounts.emplace (account_a, amount);
+		shard_a.rep_amounts.emplace (account_a, amount_a);
 	}
+	// Recorded under the shard lock after the weight is written, so a reader seeing the epoch also sees the weight
+	auto epoch_l (epoch_m.fetch_add (1, std::memory_order_acq_rel) + 1);
+	auto & change (shard_a.changes[shard_a.changes_count % changes_size]);
+	shard_a.changes_evicted = change.first;
+	change = std::make_pair (epoch_l, account_a);
+	++shard_a.changes_count;
 }
 
-vban::uint256_t vban::rep_weights::get (vban::account const & account_a) const
+vban::uint256_fixed vban::rep_weights::get (shard const & shard_a, vban::account const & account_a) const
 {
-	auto it = rep_amounts.find (account_a);
-	if (it != rep_amounts.end ())
+	auto it = shard_a.rep_amounts.find (account_a);
+	if (it != shard_a.rep_amounts.end ())
 	{
 		return it->second;
 	}
 	else
 	{
-		return vban::uint256_t{ 0 };
+		return vban::uint256_fixed{ 0 };
 	}
 }
 
 std::unique_ptr<vban::container_info_component> vban::collect_container_info (vban::rep_weights const & rep_weights, std::string const & name)
 {
-	size_t rep_amounts_count;
-
-	{
-		vban::lock_guard<vban::mutex> guard (rep_weights.mutex);
-		rep_amounts_count = rep_weights.rep_amounts.size ();
-	}
-	auto sizeof_element = sizeof (decltype (rep_weights.rep_amounts)::value_type);
+	auto rep_amounts_count (rep_weights.size ());
+	auto sizeof_element = sizeof (decltype (vban::rep_weights::shard::rep_amounts)::value_type);
 	auto composite = std::make_unique<vban::container_info_composite> (name);
 	composite->add_component (std::make_unique<vban::container_info_leaf> (container_info{ "rep_amounts", rep_amounts_count, sizeof_element }));
 	return composite;
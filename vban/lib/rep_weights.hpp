@@ -3,30 +3,64 @@
 #include <vban/lib/numbers.hpp>
 #include <vban/lib/utility.hpp>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace vban
 {
 class block_store;
 class transaction;
 
+/**
+ * Voting weight of each representative.
+ * Weights are spread over independently locked shards by account, so vote tallying and online weight sampling
+ * only contend with ledger writes that touch representatives in the same shard, and only for a single map operation.
+ */
 class rep_weights
 {
 public:
 	void representation_add (vban::account const & source_rep_a, vban::uint256_t const & amount_a);
 	void representation_add_dual (vban::account const & source_rep_1, vban::uint256_t const & amount_1, vban::account const & source_rep_2, vban::uint256_t const & amount_2);
 	vban::uint256_t representation_get (vban::account const & account_a) const;
+	/** Same as representation_get without converting to the multiprecision type */
+	vban::uint256_fixed representation_get_fixed (vban::account const & account_a) const;
 	void representation_put (vban::account const & account_a, vban::uint128_union const & representation_a);
+	/** Makes a copy, shards are copied one at a time */
 	std::unordered_map<vban::account, vban::uint256_t> get_rep_amounts () const;
 	void copy_from (rep_weights & other_a);
+	size_t size () const;
+	/** Incremented after every weight change, lets callers caching weights detect staleness */
+	uint64_t epoch () const;
+	/**
+	 * Adds the representatives whose weight changed after \p epoch_a, up to and including \p until_a, to \p result_a.
+	 * Returns true if the changes are no longer all recorded, callers then have to reload every weight they cache.
+	 */
+	bool changes (uint64_t epoch_a, uint64_t until_a, std::vector<vban::account> & result_a) const;
 
 private:
-	mutable vban::mutex mutex;
-	std::unordered_map<vban::account, vban::uint256_t> rep_amounts;
-	void put (vban::account const & account_a, vban::uint128_union const & representation_a);
-	vban::uint256_t get (vban::account const & account_a) const;
+	/** Changes recorded by each shard, once a shard overwrites a change callers older than it reload every weight */
+	static size_t constexpr changes_size = 1024;
+	class shard final
+	{
+	public:
+		mutable vban::mutex mutex;
+		std::unordered_map<vban::account, vban::uint256_fixed> rep_amounts;
+		/** Most recent changes to this shard with their epoch, the n-th change is at n % changes_size */
+		std::array<std::pair<uint64_t, vban::account>, changes_size> changes;
+		uint64_t changes_count{ 0 };
+		/** Epoch of the last change overwritten */
+		uint64_t changes_evicted{ 0 };
+	};
+	static size_t constexpr shard_count = 16;
+	std::array<shard, shard_count> shards;
+	std::atomic<uint64_t> epoch_m{ 0 };
+	size_t shard_index (vban::account const & account_a) const;
+	void put (shard & shard_a, vban::account const & account_a, vban::uint256_fixed const & amount_a);
+	vban::uint256_fixed get (shard const & shard_a, vban::account const & account_a) const;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (rep_weights const &, const std::string &);
 };
@@ -564,6 +564,12 @@ std::string vban::stat::type_to_string (uint32_t key)
 		case vban::stat::type::vote_generator:
 			res = "vote_generator";
 			break;
+		case vban::stat::type::signature_cache:
+			res = "signature_cache";
+			break;
+		case vban::stat::type::block_processor:
+			res = "block_processor";
+			break;
 	}
 	return res;
 }
@@ -724,6 +730,9 @@ std::string vban::stat::detail_to_string (uint32_t key)
 		case vban::stat::detail::vote_cached:
 			res = "vote_cached";
 			break;
+		case vban::stat::detail::tally_rebuild:
+			res = "tally_rebuild";
+			break;
 		case vban::stat::detail::late_block:
 			res = "late_block";
 			break;
@@ -883,6 +892,45 @@ std::string vban::stat::detail_to_string (uint32_t key)
 		case vban::stat::detail::generator_spacing:
 			res = "generator_spacing";
 			break;
+		case vban::stat::detail::cache_hit:
+			res = "cache_hit";
+			break;
+		case vban::stat::detail::cache_miss:
+			res = "cache_miss";
+			break;
+		case vban::stat::detail::batch_grow:
+			res = "batch_grow";
+			break;
+		case vban::stat::detail::batch_shrink:
+			res = "batch_shrink";
+			break;
+		case vban::stat::detail::batch_hold:
+			res = "batch_hold";
+			break;
+		case vban::stat::detail::batch_blocks:
+			res = "batch_blocks";
+			break;
+		case vban::stat::detail::queue_local:
+			res = "queue_local";
+			break;
+		case vban::stat::detail::queue_live:
+			res = "queue_live";
+			break;
+		case vban::stat::detail::queue_bootstrap:
+			res = "queue_bootstrap";
+			break;
+		case vban::stat::detail::queue_unchecked:
+			res = "queue_unchecked";
+			break;
+		case vban::stat::detail::write_group_appended:
+			res = "write_group_appended";
+			break;
+		case vban::stat::detail::block_filter_negative:
+			res = "block_filter_negative";
+			break;
+		case vban::stat::detail::block_filter_false_positive:
+			res = "block_filter_false_positive";
+			break;
 	}
 	return res;
 }
@@ -242,7 +242,9 @@ public:
 		requests,
 		filter,
 		telemetry,
-		vote_generator
+		vote_generator,
+		signature_cache,
+		block_processor
 	};
 
 	/** Optional detail type */
@@ -313,6 +315,7 @@ public:
 		// election specific
 		vote_new,
 		vote_cached,
+		tally_rebuild,
 		late_block,
 		late_block_seconds,
 		election_start,
@@ -386,7 +389,26 @@ public:
 		generator_broadcasts,
 		generator_replies,
 		generator_replies_discarded,
-		generator_spacing
+		generator_spacing,
+
+		// caches
+		cache_hit,
+		cache_miss,
+
+		// block processor
+		batch_grow,
+		batch_shrink,
+		batch_hold,
+		batch_blocks,
+		queue_local,
+		queue_live,
+		queue_bootstrap,
+		queue_unchecked,
+		write_group_appended,
+
+		// block filter
+		block_filter_negative,
+		block_filter_false_positive
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
@@ -39,6 +39,9 @@ std::string vban::thread_role::get_string (vban::thread_role::name role)
 		case vban::thread_role::name::vote_processing:
 			thread_role_name_string = "Vote processing";
 			break;
+		case vban::thread_role::name::block_prevalidation:
+			thread_role_name_string = "Blck prevalid";
+			break;
 		case vban::thread_role::name::block_processing:
 			thread_role_name_string = "Blck processing";
 			break;
@@ -84,6 +87,9 @@ std::string vban::thread_role::get_string (vban::thread_role::name role)
 		case vban::thread_role::name::db_parallel_traversal:
 			thread_role_name_string = "DB par traversl";
 			break;
+		case vban::thread_role::name::db_checkpoint:
+			thread_role_name_string = "DB checkpoint";
+			break;
 		case vban::thread_role::name::election_scheduler:
 			thread_role_name_string = "Election Sched";
 	}
@@ -24,6 +24,7 @@ namespace thread_role
 		packet_processing,
 		vote_processing,
 		block_processing,
+		block_prevalidation,
 		request_loop,
 		wallet_actions,
 		bootstrap_initiator,
@@ -38,6 +39,7 @@ namespace thread_role
 		state_block_signature_verification,
 		epoch_upgrader,
 		db_parallel_traversal,
+		db_checkpoint,
 		election_scheduler
 	};
 	/*
@@ -5,6 +5,7 @@
 #include <vban/lib/work.hpp>
 #include <vban/node/xorshift.hpp>
 
+#include <array>
 #include <future>
 
 std::string vban::to_string (vban::work_version const version_a)
@@ -202,7 +203,8 @@ vban::work_pool::work_pool (unsigned max_threads_a, std::chrono::nanoseconds pow
 	ticket (0),
 	done (false),
 	pow_rate_limiter (pow_rate_limiter_a),
-	opencl (opencl_a)
+	opencl (opencl_a),
+	cpu ()
 {
 	static_assert (ATOMIC_INT_LOCK_FREE == 2, "Atomic int needed");
 	boost::thread::attributes attrs;
@@ -239,8 +241,9 @@ void vban::work_pool::loop (uint64_t thread)
 	vban::random_pool::generate_block (reinterpret_cast<uint8_t *> (rng.s.data ()), rng.s.size () * sizeof (decltype (rng.s)::value_type));
 	uint64_t work;
 	uint64_t output;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (output));
+	auto const lanes (static_cast<unsigned> (cpu.lanes ()));
+	std::array<uint64_t, vban::cpu_work::max_lanes> nonces;
+	std::array<uint64_t, vban::cpu_work::max_lanes> values;
 	vban::unique_lock<vban::mutex> lock (mutex);
 	auto pow_sleep = pow_rate_limiter;
 	while (!done)
@@ -275,14 +278,20 @@ void vban::work_pool::loop (uint64_t thread)
 					// Don't query main memory every iteration in order to reduce memory bus traffic
 					// All operations here operate on stack memory
 					// Count iterations down to zero since comparing to zero is easier than comparing to another number
-					unsigned iteration (256);
+					// Each round evaluates one nonce per lane of the CPU work engine
+					unsigned iteration (256 / lanes);
 					while (iteration && output < current_l.difficulty)
 					{
-						work = rng.next ();
-						blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work), sizeof (work));
-						blake2b_update (&hash, current_l.item.bytes.data (), current_l.item.bytes.size ());
-						blake2b_final (&hash, reinterpret_cast<uint8_t *> (&output), sizeof (output));
-						blake2b_init (&hash, sizeof (output));
+						for (auto i (0u); i < lanes; ++i)
+						{
+							nonces[i] = rng.next ();
+						}
+						cpu.values (current_l.item, nonces.data (), values.data ());
+						for (auto i (0u); i < lanes && output < current_l.difficulty; ++i)
+						{
+							work = nonces[i];
+							output = values[i];
+						}
 						iteration -= 1;
 					}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vban/lib/config.hpp>
+#include <vban/lib/cpu_work.hpp>
 #include <vban/lib/locks.hpp>
 #include <vban/lib/numbers.hpp>
 #include <vban/lib/utility.hpp>
@@ -79,6 +80,7 @@ public:
 	vban::condition_variable producer_condition;
 	std::chrono::nanoseconds pow_rate_limiter;
 	std::function<boost::optional<uint64_t> (vban::work_version const, vban::root const &, uint64_t, std::atomic<int> &)> opencl;
+	vban::cpu_work const cpu;
 	vban::observer_set<bool> work_observers;
 };
 
@@ -6,6 +6,7 @@
 #include <vban/node/node.hpp>
 #include <vban/node/repcrawler.hpp>
 #include <vban/secure/blockstore.hpp>
+#include <vban/secure/buffer.hpp>
 
 #include <boost/format.hpp>
 #include <boost/variant/get.hpp>
@@ -53,7 +54,7 @@ bool vban::active_transactions::insert_election_from_frontiers_confirmation (std
 {
 	bool inserted{ false };
 	vban::unique_lock<vban::mutex> lock (mutex);
-	if (roots.get<tag_root> ().find (block_a->qualified_root ()) == roots.get<tag_root> ().end ())
+	if (!active (block_a->qualified_root ()))
 	{
 		std::function<void (std::shared_ptr<vban::block> const &)> election_confirmation_cb;
 		if (election_behavior_a == vban::election_behavior::optimistic)
@@ -283,19 +284,14 @@ void vban::active_transactions::block_already_cemented_callback (vban::block_has
 
 int64_t vban::active_transactions::vacancy () const
 {
-	vban::lock_guard<vban::mutex> lock{ mutex };
-	auto result = static_cast<int64_t> (node.config.active_elections_size) - static_cast<int64_t> (roots.size ());
+	auto result = static_cast<int64_t> (node.config.active_elections_size) - static_cast<int64_t> (roots_size.load ());
 	return result;
 }
 
-void vban::active_transactions::request_confirm (vban::unique_lock<vban::mutex> & lock_a)
+void vban::active_transactions::request_confirm ()
 {
-	debug_assert (lock_a.owns_lock ());
-
-	size_t const this_loop_target_l (roots.size ());
-	auto const elections_l{ list_active_impl (this_loop_target_l) };
-
-	lock_a.unlock ();
+	size_t const this_loop_target_l (roots_size);
+	auto const elections_l{ list_active (this_loop_target_l) };
 
 	vban::confirmation_solicitor solicitor (node.network, node.config);
 	solicitor.prepare (node.rep_crawler.principal_representatives (std::numeric_limits<size_t>::max ()));
@@ -342,7 +338,6 @@ void vban::active_transactions::request_confirm (vban::unique_lock<vban::mutex>
 	solicitor.flush ();
 	generator_session.flush ();
 	final_generator_session.flush ();
-	lock_a.lock ();
 
 	if (node.config.logging.timing_logging ())
 	{
@@ -350,24 +345,47 @@ void vban::active_transactions::request_confirm (vban::unique_lock<vban::mutex>
 	}
 }
 
-void vban::active_transactions::cleanup_election (vban::unique_lock<vban::mutex> & lock_a, vban::election const & election)
+void vban::active_transactions::cleanup_election (std::shared_ptr<vban::election> const & election_a)
 {
+	auto const & election (*election_a);
+	decltype (election.blocks ()) blocks_l;
+	{
+		auto & shard_l (roots_shard_for (election.qualified_root));
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		auto & roots_by_root (shard_l.roots.get<tag_root> ());
+		auto existing (roots_by_root.find (election.qualified_root));
+		if (existing == roots_by_root.end () || existing->election != election_a)
+		{
+			// Already erased by another thread
+			return;
+		}
+		roots_by_root.erase (existing);
+		--roots_size;
+		blocks_l = election.blocks ();
+		for (auto const & [hash, block] : blocks_l)
+		{
+			auto & blocks_shard_l (blocks_shard_for (hash));
+			vban::lock_guard<vban::mutex> blocks_guard (blocks_shard_l.mutex);
+			// A block concurrently being published may not have been added yet
+			auto existing_block (blocks_shard_l.blocks.find (hash));
+			if (existing_block != blocks_shard_l.blocks.end () && existing_block->second == election_a)
+			{
+				blocks_shard_l.blocks.erase (existing_block);
+			}
+		}
+	}
 	if (!election.confirmed ())
 	{
 		node.stats.inc (vban::stat::type::election, vban::stat::detail::election_drop_all);
 	}
-
-	auto blocks_l = election.blocks ();
-	for (auto const & [hash, block] : blocks_l)
 	{
-		auto erased (blocks.erase (hash));
-		(void)erased;
-		debug_assert (erased == 1);
-		erase_inactive_votes_cache (hash);
+		vban::lock_guard<vban::mutex> guard (mutex);
+		for (auto const & [hash, block] : blocks_l)
+		{
+			erase_inactive_votes_cache (hash);
+		}
 	}
-	roots.get<tag_root> ().erase (roots.get<tag_root> ().find (election.qualified_root));
 
-	lock_a.unlock ();
 	vacancy_update ();
 	for (auto const & [hash, block] : blocks_l)
 	{
@@ -388,22 +406,24 @@ void vban::active_transactions::cleanup_election (vban::unique_lock<vban::mutex>
 
 std::vector<std::shared_ptr<vban::election>> vban::active_transactions::list_active (size_t max_a)
 {
-	vban::lock_guard<vban::mutex> guard (mutex);
-	return list_active_impl (max_a);
-}
-
-std::vector<std::shared_ptr<vban::election>> vban::active_transactions::list_active_impl (size_t max_a) const
-{
-	std::vector<std::shared_ptr<vban::election>> result_l;
-	result_l.reserve (std::min (max_a, roots.size ()));
+	std::vector<std::pair<uint64_t, std::shared_ptr<vban::election>>> sorted_l;
+	sorted_l.reserve (std::min<size_t> (max_a, roots_size));
+	for (auto & shard_l : roots_shards)
 	{
-		auto & sorted_roots_l (roots.get<tag_random_access> ());
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		// Each shard is in insertion order, only its oldest max_a elections can make the result
+		auto & sequenced_l (shard_l.roots.get<tag_random_access> ());
 		size_t count_l{ 0 };
-		for (auto i = sorted_roots_l.begin (), n = sorted_roots_l.end (); i != n && count_l < max_a; ++i, ++count_l)
+		for (auto i = sequenced_l.begin (), n = sequenced_l.end (); i != n && count_l < max_a; ++i, ++count_l)
 		{
-			result_l.push_back (i->election);
+			sorted_l.emplace_back (i->sequence, i->election);
 		}
 	}
+	auto end_l (sorted_l.begin () + std::min (max_a, sorted_l.size ()));
+	std::partial_sort (sorted_l.begin (), end_l, sorted_l.end (), [] (auto const & left, auto const & right) { return left.first < right.first; });
+	std::vector<std::shared_ptr<vban::election>> result_l;
+	result_l.reserve (std::distance (sorted_l.begin (), end_l));
+	std::transform (sorted_l.begin (), end_l, std::back_inserter (result_l), [] (auto const & item_a) { return item_a.second; });
 	return result_l;
 }
 
@@ -448,7 +468,7 @@ void vban::active_transactions::frontiers_confirmation (vban::unique_lock<vban::
 	// Spend some time prioritizing accounts with the most uncemented blocks to reduce voting traffic
 	auto request_interval = std::chrono::milliseconds (node.network_params.network.request_interval_ms);
 	// Spend longer searching ledger accounts when there is a low amount of elections going on
-	auto low_active = roots.size () < 1000;
+	auto low_active = size () < 1000;
 	auto time_to_spend_prioritizing_ledger_accounts = request_interval / (low_active ? 20 : 100);
 	auto time_to_spend_prioritizing_wallet_accounts = request_interval / 250;
 	auto time_to_spend_confirming_pessimistic_accounts = time_to_spend_prioritizing_ledger_accounts;
@@ -578,11 +598,12 @@ void vban::active_transactions::request_loop ()
 		{
 			node.vote_processor.flush_active ();
 		}
-		lock.lock ();
 
 		const auto stamp_l = std::chrono::steady_clock::now ();
 
-		request_confirm (lock);
+		request_confirm ();
+
+		lock.lock ();
 
 		if (!stopped)
 		{
@@ -787,8 +808,12 @@ void vban::active_transactions::stop ()
 	}
 	generator.stop ();
 	final_generator.stop ();
-	lock.lock ();
-	roots.clear ();
+	for (auto & shard_l : roots_shards)
+	{
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		roots_size -= shard_l.roots.size ();
+		shard_l.roots.clear ();
+	}
 }
 
 vban::election_insertion_result vban::active_transactions::insert_impl (vban::unique_lock<vban::mutex> & lock_a, std::shared_ptr<vban::block> const & block_a, boost::optional<vban::uint256_t> const & previous_balance_a, vban::election_behavior election_behavior_a, std::function<void (std::shared_ptr<vban::block> const &)> const & confirmation_action_a)
@@ -799,8 +824,10 @@ vban::election_insertion_result vban::active_transactions::insert_impl (vban::un
 	if (!stopped)
 	{
 		auto root (block_a->qualified_root ());
-		auto existing (roots.get<tag_root> ().find (root));
-		if (existing == roots.get<tag_root> ().end ())
+		auto & shard_l (roots_shard_for (root));
+		vban::unique_lock<vban::mutex> shard_lock (shard_l.mutex);
+		auto existing (shard_l.roots.get<tag_root> ().find (root));
+		if (existing == shard_l.roots.get<tag_root> ().end ())
 		{
 			if (recently_confirmed.get<tag_root> ().find (root) == recently_confirmed.get<tag_root> ().end ())
 			{
@@ -823,8 +850,15 @@ vban::election_insertion_result vban::active_transactions::insert_impl (vban::un
 					node.online_reps.observe (rep_a);
 				},
 				election_behavior_a);
-				roots.get<tag_root> ().emplace (vban::active_transactions::conflict_info{ root, result.election, epoch, previous_balance });
-				blocks.emplace (hash, result.election);
+				shard_l.roots.get<tag_root> ().emplace (vban::active_transactions::conflict_info{ root, result.election, epoch, previous_balance, next_sequence++ });
+				++roots_size;
+				{
+					auto & blocks_shard_l (blocks_shard_for (hash));
+					vban::lock_guard<vban::mutex> blocks_guard (blocks_shard_l.mutex);
+					blocks_shard_l.blocks.emplace (hash, result.election);
+				}
+				shard_lock.unlock ();
+				// Votes missing the block are cached under mutex, which is still held so none are lost in between
 				auto const cache = find_inactive_votes_cache_impl (hash);
 				lock_a.unlock ();
 				result.election->insert_inactive_votes_cache (cache);
@@ -837,6 +871,10 @@ vban::election_insertion_result vban::active_transactions::insert_impl (vban::un
 			result.election = existing->election;
 		}
 
+		if (shard_lock.owns_lock ())
+		{
+			shard_lock.unlock ();
+		}
 		if (lock_a.owns_lock ())
 		{
 			lock_a.unlock ();
@@ -858,44 +896,51 @@ vban::vote_code vban::active_transactions::vote (std::shared_ptr<vban::vote> con
 	// If all hashes were recently confirmed then it is a replay
 	unsigned recently_confirmed_counter (0);
 	std::vector<std::pair<std::shared_ptr<vban::election>, vban::block_hash>> process;
+	// Votes for blocks without an election, the block is only set if the vote contains it
+	std::vector<std::pair<vban::block_hash, std::shared_ptr<vban::block>>> inactive;
+	auto find_election = [this] (vban::block_hash const & hash_a, std::shared_ptr<vban::block> const & block_a) {
+		return block_a != nullptr ? election (block_a->qualified_root ()) : election_by_hash (hash_a);
+	};
+	for (auto vote_block : vote_a->blocks)
+	{
+		std::shared_ptr<vban::block> block;
+		vban::block_hash hash;
+		if (vote_block.which ())
+		{
+			hash = boost::get<vban::block_hash> (vote_block);
+		}
+		else
+		{
+			block = boost::get<std::shared_ptr<vban::block>> (vote_block);
+			hash = block->hash ();
+		}
+		if (auto election_l = find_election (hash, block))
+		{
+			process.emplace_back (election_l, hash);
+		}
+		else
+		{
+			inactive.emplace_back (hash, block);
+		}
+	}
+	if (!inactive.empty ())
 	{
 		vban::unique_lock<vban::mutex> lock (mutex);
-		for (auto vote_block : vote_a->blocks)
+		auto & recently_confirmed_by_hash (recently_confirmed.get<tag_hash> ());
+		for (auto const & [hash, block] : inactive)
 		{
-			auto & recently_confirmed_by_hash (recently_confirmed.get<tag_hash> ());
-			if (vote_block.which ())
+			// An election may have started since the lookup, elections read the inactive votes cache while holding mutex
+			if (auto election_l = find_election (hash, block))
 			{
-				auto const & block_hash (boost::get<vban::block_hash> (vote_block));
-				auto existing (blocks.find (block_hash));
-				if (existing != blocks.end ())
-				{
-					process.emplace_back (existing->second, block_hash);
-				}
-				else if (recently_confirmed_by_hash.count (block_hash) == 0)
-				{
-					add_inactive_votes_cache (lock, block_hash, vote_a->account, vote_a->timestamp);
-				}
-				else
-				{
-					++recently_confirmed_counter;
-				}
+				process.emplace_back (election_l, hash);
+			}
+			else if (recently_confirmed_by_hash.count (hash) == 0)
+			{
+				add_inactive_votes_cache (lock, hash, vote_a->account, vote_a->timestamp);
 			}
 			else
 			{
-				auto block (boost::get<std::shared_ptr<vban::block>> (vote_block));
-				auto existing (roots.get<tag_root> ().find (block->qualified_root ()));
-				if (existing != roots.get<tag_root> ().end ())
-				{
-					process.emplace_back (existing->election, block->hash ());
-				}
-				else if (recently_confirmed_by_hash.count (block->hash ()) == 0)
-				{
-					add_inactive_votes_cache (lock, block->hash (), vote_a->account, vote_a->timestamp);
-				}
-				else
-				{
-					++recently_confirmed_counter;
-				}
+				++recently_confirmed_counter;
 			}
 		}
 	}
@@ -931,38 +976,56 @@ vban::vote_code vban::active_transactions::vote (std::shared_ptr<vban::vote> con
 
 bool vban::active_transactions::active (vban::qualified_root const & root_a)
 {
-	vban::lock_guard<vban::mutex> lock (mutex);
-	return roots.get<tag_root> ().find (root_a) != roots.get<tag_root> ().end ();
+	auto & shard_l (roots_shard_for (root_a));
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	return shard_l.roots.get<tag_root> ().find (root_a) != shard_l.roots.get<tag_root> ().end ();
 }
 
 bool vban::active_transactions::active (vban::block const & block_a)
 {
-	vban::lock_guard<vban::mutex> guard (mutex);
-	return roots.get<tag_root> ().find (block_a.qualified_root ()) != roots.get<tag_root> ().end () && blocks.find (block_a.hash ()) != blocks.end ();
+	return active (block_a.qualified_root ()) && active (block_a.hash ());
+}
+
+bool vban::active_transactions::active (vban::block_hash const & hash_a)
+{
+	auto & shard_l (blocks_shard_for (hash_a));
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	return shard_l.blocks.find (hash_a) != shard_l.blocks.end ();
 }
 
 std::shared_ptr<vban::election> vban::active_transactions::election (vban::qualified_root const & root_a) const
 {
 	std::shared_ptr<vban::election> result;
-	vban::lock_guard<vban::mutex> lock (mutex);
-	auto existing = roots.get<tag_root> ().find (root_a);
-	if (existing != roots.get<tag_root> ().end ())
+	auto & shard_l (roots_shard_for (root_a));
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	auto existing = shard_l.roots.get<tag_root> ().find (root_a);
+	if (existing != shard_l.roots.get<tag_root> ().end ())
 	{
 		result = existing->election;
 	}
 	return result;
 }
 
+std::shared_ptr<vban::election> vban::active_transactions::election_by_hash (vban::block_hash const & hash_a) const
+{
+	std::shared_ptr<vban::election> result;
+	auto & shard_l (blocks_shard_for (hash_a));
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	auto existing = shard_l.blocks.find (hash_a);
+	if (existing != shard_l.blocks.end ())
+	{
+		result = existing->second;
+	}
+	return result;
+}
+
 std::shared_ptr<vban::block> vban::active_transactions::winner (vban::block_hash const & hash_a) const
 {
 	std::shared_ptr<vban::block> result;
-	vban::unique_lock<vban::mutex> lock (mutex);
-	auto existing = blocks.find (hash_a);
-	if (existing != blocks.end ())
+	auto election_l (election_by_hash (hash_a));
+	if (election_l != nullptr)
 	{
-		auto election = existing->second;
-		lock.unlock ();
-		result = election->winner ();
+		result = election_l->winner ();
 	}
 	return result;
 }
@@ -977,6 +1040,17 @@ void vban::active_transactions::restart (vban::transaction const & transaction_a
 		{
 			// Re-writing the block is necessary to avoid the same work being received later to force restarting the election
 			// The existing block is re-written, not the arriving block, as that one might not have gone through a full signature check
+			// Blocks from the store may be shared with other readers, so the upgrade is applied to a private copy
+			std::vector<uint8_t> bytes;
+			{
+				vban::vectorstream stream (bytes);
+				ledger_block->serialize (stream);
+			}
+			vban::bufferstream stream (bytes.data (), bytes.size ());
+			auto sideband (ledger_block->sideband ());
+			ledger_block = vban::deserialize_block (stream, ledger_block->type ());
+			release_assert (ledger_block != nullptr);
+			ledger_block->sideband_set (sideband);
 			ledger_block->block_work_set (block_a->block_work ());
 
 			// Deferred write
@@ -1034,58 +1108,85 @@ void vban::active_transactions::erase (vban::block const & block_a)
 
 void vban::active_transactions::erase (vban::qualified_root const & root_a)
 {
-	vban::unique_lock<vban::mutex> lock (mutex);
-	auto root_it (roots.get<tag_root> ().find (root_a));
-	if (root_it != roots.get<tag_root> ().end ())
+	auto election_l (election (root_a));
+	if (election_l != nullptr)
 	{
-		cleanup_election (lock, *root_it->election);
+		cleanup_election (election_l);
 	}
 }
 
 void vban::active_transactions::erase_hash (vban::block_hash const & hash_a)
 {
-	vban::unique_lock<vban::mutex> lock (mutex);
-	[[maybe_unused]] auto erased (blocks.erase (hash_a));
+	auto & shard_l (blocks_shard_for (hash_a));
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	[[maybe_unused]] auto erased (shard_l.blocks.erase (hash_a));
 	debug_assert (erased == 1);
 }
 
 void vban::active_transactions::erase_oldest ()
 {
-	vban::unique_lock<vban::mutex> lock (mutex);
-	if (!roots.empty ())
+	std::shared_ptr<vban::election> oldest;
+	uint64_t oldest_sequence (std::numeric_limits<uint64_t>::max ());
+	for (auto & shard_l : roots_shards)
+	{
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		auto & sequenced_l (shard_l.roots.get<tag_random_access> ());
+		if (!sequenced_l.empty () && sequenced_l.front ().sequence < oldest_sequence)
+		{
+			oldest_sequence = sequenced_l.front ().sequence;
+			oldest = sequenced_l.front ().election;
+		}
+	}
+	if (oldest != nullptr)
 	{
 		node.stats.inc (vban::stat::type::election, vban::stat::detail::election_drop_overflow);
-		auto item = roots.get<tag_random_access> ().front ();
-		cleanup_election (lock, *item.election);
+		cleanup_election (oldest);
 	}
 }
 
 bool vban::active_transactions::empty ()
 {
-	vban::lock_guard<vban::mutex> lock (mutex);
-	return roots.empty ();
+	return roots_size == 0;
 }
 
 size_t vban::active_transactions::size ()
 {
-	vban::lock_guard<vban::mutex> lock (mutex);
-	return roots.size ();
+	return roots_size;
+}
+
+size_t vban::active_transactions::blocks_size () const
+{
+	size_t result (0);
+	for (auto & shard_l : blocks_shards)
+	{
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		result += shard_l.blocks.size ();
+	}
+	return result;
 }
 
 bool vban::active_transactions::publish (std::shared_ptr<vban::block> const & block_a)
 {
-	vban::unique_lock<vban::mutex> lock (mutex);
-	auto existing (roots.get<tag_root> ().find (block_a->qualified_root ()));
+	auto election (this->election (block_a->qualified_root ()));
 	auto result (true);
-	if (existing != roots.get<tag_root> ().end ())
+	if (election != nullptr)
 	{
-		auto election (existing->election);
-		lock.unlock ();
 		result = election->publish (block_a);
 		if (!result)
 		{
-			lock.lock ();
-			blocks.emplace (block_a->hash (), election);
+			vban::unique_lock<vban::mutex> lock (mutex);
+			{
+				// The election may have been erased while publishing, its blocks must not outlive it
+				auto & shard_l (roots_shard_for (block_a->qualified_root ()));
+				vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+				auto existing (shard_l.roots.get<tag_root> ().find (block_a->qualified_root ()));
+				if (existing != shard_l.roots.get<tag_root> ().end () && existing->election == election)
+				{
+					auto & blocks_shard_l (blocks_shard_for (block_a->hash ()));
+					vban::lock_guard<vban::mutex> blocks_guard (blocks_shard_l.mutex);
+					blocks_shard_l.blocks.emplace (block_a->hash (), election);
+				}
+			}
 			auto const cache = find_inactive_votes_cache_impl (block_a->hash ());
 			lock.unlock ();
 			election->insert_inactive_votes_cache (cache);
@@ -1099,18 +1200,16 @@ bool vban::active_transactions::publish (std::shared_ptr<vban::block> const & bl
 boost::optional<vban::election_status_type> vban::active_transactions::confirm_block (vban::transaction const & transaction_a, std::shared_ptr<vban::block> const & block_a)
 {
 	auto hash (block_a->hash ());
-	vban::unique_lock<vban::mutex> lock (mutex);
-	auto existing (blocks.find (hash));
+	auto existing (election_by_hash (hash));
 	boost::optional<vban::election_status_type> status_type;
-	if (existing != blocks.end ())
+	if (existing != nullptr)
 	{
-		lock.unlock ();
-		vban::unique_lock<vban::mutex> election_lock (existing->second->mutex);
-		if (existing->second->status.winner && existing->second->status.winner->hash () == hash)
+		vban::unique_lock<vban::mutex> election_lock (existing->mutex);
+		if (existing->status.winner && existing->status.winner->hash () == hash)
 		{
-			if (!existing->second->confirmed ())
+			if (!existing->confirmed ())
 			{
-				existing->second->confirm_once (election_lock, vban::election_status_type::active_confirmation_height);
+				existing->confirm_once (election_lock, vban::election_status_type::active_confirmation_height);
 				status_type = vban::election_status_type::active_confirmation_height;
 			}
 			else
@@ -1329,6 +1428,27 @@ bool vban::purge_singleton_inactive_votes_cache_pool_memory ()
 	return boost::singleton_pool<boost::fast_pool_allocator_tag, sizeof (vban::active_transactions::ordered_cache::node_type)>::purge_memory ();
 }
 
+vban::active_transactions::roots_shard & vban::active_transactions::roots_shard_for (vban::qualified_root const & root_a)
+{
+	// Roots are block hashes or accounts, any byte is uniformly distributed
+	return roots_shards[root_a.bytes[0] % shard_count];
+}
+
+vban::active_transactions::roots_shard const & vban::active_transactions::roots_shard_for (vban::qualified_root const & root_a) const
+{
+	return roots_shards[root_a.bytes[0] % shard_count];
+}
+
+vban::active_transactions::blocks_shard & vban::active_transactions::blocks_shard_for (vban::block_hash const & hash_a)
+{
+	return blocks_shards[hash_a.bytes[0] % shard_count];
+}
+
+vban::active_transactions::blocks_shard const & vban::active_transactions::blocks_shard_for (vban::block_hash const & hash_a) const
+{
+	return blocks_shards[hash_a.bytes[0] % shard_count];
+}
+
 size_t vban::active_transactions::election_winner_details_size ()
 {
 	vban::lock_guard<vban::mutex> guard (election_winner_details_mutex);
@@ -1353,22 +1473,20 @@ bool vban::frontiers_confirmation_info::can_start_elections () const
 
 std::unique_ptr<vban::container_info_component> vban::collect_container_info (active_transactions & active_transactions, std::string const & name)
 {
-	size_t roots_count;
-	size_t blocks_count;
+	size_t roots_count (active_transactions.size ());
+	size_t blocks_count (active_transactions.blocks_size ());
 	size_t recently_confirmed_count;
 	size_t recently_cemented_count;
 
 	{
 		vban::lock_guard<vban::mutex> guard (active_transactions.mutex);
-		roots_count = active_transactions.roots.size ();
-		blocks_count = active_transactions.blocks.size ();
 		recently_confirmed_count = active_transactions.recently_confirmed.size ();
 		recently_cemented_count = active_transactions.recently_cemented.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "roots", roots_count, sizeof (decltype (active_transactions.roots)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (active_transactions.blocks)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "roots", roots_count, sizeof (vban::active_transactions::ordered_roots::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (vban::active_transactions::blocks_shard::blocks)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "election_winner_details", active_transactions.election_winner_details_size (), sizeof (decltype (active_transactions.election_winner_details)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "recently_confirmed", recently_confirmed_count, sizeof (decltype (active_transactions.recently_confirmed)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "recently_cemented", recently_cemented_count, sizeof (decltype (active_transactions.recently_cemented)::value_type) }));
@@ -15,6 +15,7 @@
 #include <boost/optional.hpp>
 #include <boost/thread/thread.hpp>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <deque>
@@ -125,6 +126,8 @@ class active_transactions final
 		std::shared_ptr<vban::election> election;
 		vban::epoch epoch;
 		vban::uint256_t previous_balance;
+		// Insertion order over all shards, lower is older
+		uint64_t sequence;
 	};
 
 	friend class vban::election;
@@ -149,8 +152,6 @@ public:
 		mi::hashed_unique<mi::tag<tag_root>,
 			mi::member<conflict_info, vban::qualified_root, &conflict_info::root>>>>;
 	// clang-format on
-	ordered_roots roots;
-	using roots_iterator = active_transactions::ordered_roots::index_iterator<tag_root>::type;
 
 	explicit active_transactions (vban::node &, vban::confirmation_height_processor &);
 	~active_transactions ();
@@ -159,6 +160,8 @@ public:
 	// Is the root of this block in the roots container
 	bool active (vban::block const &);
 	bool active (vban::qualified_root const &);
+	// Is this block part of an active election
+	bool active (vban::block_hash const &);
 	std::shared_ptr<vban::election> election (vban::qualified_root const &) const;
 	std::shared_ptr<vban::block> winner (vban::block_hash const &) const;
 	// Returns false if the election was restarted
@@ -179,7 +182,6 @@ public:
 	int64_t vacancy () const;
 	std::function<void ()> vacancy_update{ [] () {} };
 
-	std::unordered_map<vban::block_hash, std::shared_ptr<vban::election>> blocks;
 	std::deque<vban::election_status> list_recently_cemented ();
 	std::deque<vban::election_status> recently_cemented;
 
@@ -194,7 +196,9 @@ public:
 	vban::election_scheduler & scheduler;
 	vban::confirmation_height_processor & confirmation_height_processor;
 	vban::node & node;
+	/** Guards the inactive votes cache, recently confirmed and cemented lists and frontier confirmation state. Elections are held in shards with their own locks */
 	mutable vban::mutex mutex{ mutex_identifier (mutexes::active) };
+	size_t blocks_size () const;
 	size_t priority_cementable_frontiers_size ();
 	size_t priority_wallet_cementable_frontiers_size ();
 	size_t inactive_votes_cache_size ();
@@ -225,17 +229,42 @@ private:
 
 	std::unordered_map<vban::block_hash, std::shared_ptr<vban::election>> election_winner_details;
 
+	/*
+	 * Elections are sharded by qualified root and their blocks by hash so votes, insertions and the request loop only contend on a shard.
+	 * Lock order is mutex, then a roots shard, then a blocks shard. Only one shard of each kind is held at a time.
+	 */
+	class roots_shard final
+	{
+	public:
+		mutable vban::mutex mutex{ mutex_identifier (mutexes::active_roots) };
+		ordered_roots roots;
+	};
+	class blocks_shard final
+	{
+	public:
+		mutable vban::mutex mutex{ mutex_identifier (mutexes::active_blocks) };
+		std::unordered_map<vban::block_hash, std::shared_ptr<vban::election>> blocks;
+	};
+	static size_t constexpr shard_count = 16;
+	std::array<roots_shard, shard_count> roots_shards;
+	std::array<blocks_shard, shard_count> blocks_shards;
+	std::atomic<size_t> roots_size{ 0 };
+	std::atomic<uint64_t> next_sequence{ 0 };
+	roots_shard & roots_shard_for (vban::qualified_root const &);
+	roots_shard const & roots_shard_for (vban::qualified_root const &) const;
+	blocks_shard & blocks_shard_for (vban::block_hash const &);
+	blocks_shard const & blocks_shard_for (vban::block_hash const &) const;
+	std::shared_ptr<vban::election> election_by_hash (vban::block_hash const &) const;
+
 	// Call action with confirmed block, may be different than what we started with
 	// clang-format off
 	vban::election_insertion_result insert_impl (vban::unique_lock<vban::mutex> &, std::shared_ptr<vban::block> const&, boost::optional<vban::uint256_t> const & = boost::none, vban::election_behavior = vban::election_behavior::normal, std::function<void(std::shared_ptr<vban::block>const&)> const & = nullptr);
 	// clang-format on
 	void request_loop ();
-	void request_confirm (vban::unique_lock<vban::mutex> &);
+	void request_confirm ();
 	void erase (vban::qualified_root const &);
 	// Erase all blocks from active and, if not confirmed, clear digests from network filters
-	void cleanup_election (vban::unique_lock<vban::mutex> & lock_a, vban::election const &);
-	// Returns a list of elections sorted by difficulty, mutex must be locked
-	std::vector<std::shared_ptr<vban::election>> list_active_impl (size_t) const;
+	void cleanup_election (std::shared_ptr<vban::election> const &);
 
 	vban::condition_variable condition;
 	bool started{ false };
@@ -0,0 +1,160 @@
+#include <vban/lib/threading.hpp>
+#include <vban/node/block_prevalidation.hpp>
+#include <vban/secure/blockstore.hpp>
+#include <vban/secure/ledger.hpp>
+
+size_t constexpr vban::block_prevalidation::batch_size;
+
+vban::block_prevalidation::block_prevalidation (vban::ledger & ledger_a, unsigned thread_count_a) :
+	ledger (ledger_a)
+{
+	for (auto i (0u); i < thread_count_a; ++i)
+	{
+		threads.emplace_back ([this] () {
+			vban::thread_role::set (vban::thread_role::name::block_prevalidation);
+			this->run ();
+		});
+	}
+}
+
+vban::block_prevalidation::~block_prevalidation ()
+{
+	stop ();
+}
+
+void vban::block_prevalidation::stop ()
+{
+	{
+		vban::lock_guard<vban::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	for (auto & thread : threads)
+	{
+		if (thread.joinable ())
+		{
+			thread.join ();
+		}
+	}
+}
+
+bool vban::block_prevalidation::enabled () const
+{
+	return !threads.empty ();
+}
+
+void vban::block_prevalidation::add (vban::unchecked_info const & info_a)
+{
+	debug_assert (enabled ());
+	{
+		vban::lock_guard<vban::mutex> guard (mutex);
+		blocks.push_back (info_a);
+	}
+	condition.notify_all ();
+}
+
+size_t vban::block_prevalidation::size ()
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	return blocks.size ();
+}
+
+bool vban::block_prevalidation::is_active ()
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	return active != 0;
+}
+
+void vban::block_prevalidation::run ()
+{
+	vban::unique_lock<vban::mutex> lk (mutex);
+	while (!stopped)
+	{
+		if (!blocks.empty ())
+		{
+			std::deque<vban::unchecked_info> items;
+			if (blocks.size () <= batch_size)
+			{
+				items.swap (blocks);
+			}
+			else
+			{
+				items.insert (items.end (), std::make_move_iterator (blocks.begin ()), std::make_move_iterator (blocks.begin () + batch_size));
+				blocks.erase (blocks.begin (), blocks.begin () + batch_size);
+			}
+			auto ticket (next_ticket++);
+			++active;
+			lk.unlock ();
+			prevalidate (items);
+			lk.lock ();
+			// Batches are delivered in the order they were taken, other workers keep prefetching meanwhile
+			condition.wait (lk, [this, ticket] { return stopped || delivered_ticket == ticket; });
+			if (!stopped)
+			{
+				lk.unlock ();
+				blocks_prevalidated_callback (items);
+				lk.lock ();
+			}
+			++delivered_ticket;
+			--active;
+			auto inactive (active == 0 && blocks.empty ());
+			condition.notify_all ();
+			if (inactive && transition_inactive_callback)
+			{
+				lk.unlock ();
+				transition_inactive_callback ();
+				lk.lock ();
+			}
+		}
+		else
+		{
+			condition.wait (lk);
+		}
+	}
+}
+
+void vban::block_prevalidation::prevalidate (std::deque<vban::unchecked_info> & items)
+{
+	auto & store (ledger.store);
+	auto transaction (store.tx_begin_read ());
+	for (auto & info : items)
+	{
+		auto const & block (*info.block);
+		auto hash (block.hash ());
+		store.block_exists (transaction, hash);
+		vban::account account (block.account ());
+		auto previous (block.previous ());
+		if (!previous.is_zero ())
+		{
+			auto previous_block (store.block_get (transaction, previous));
+			if (previous_block != nullptr && account.is_zero ())
+			{
+				// A block hash always belongs to the same account, so this holds whenever the ledger gets to the block
+				account = previous_block->account ().is_zero () ? previous_block->sideband ().account : previous_block->account ();
+			}
+		}
+		if (!account.is_zero ())
+		{
+			vban::account_info account_info;
+			store.account_get (transaction, account, account_info);
+			vban::block_hash source (block.type () == vban::block_type::state ? (ledger.is_epoch_link (block.link ()) ? vban::block_hash (0) : block.link ().as_block_hash ()) : block.source ());
+			if (!source.is_zero ())
+			{
+				vban::pending_info pending;
+				store.pending_get (transaction, vban::pending_key (account, source), pending);
+			}
+			// State blocks and blocks with a known account were verified in batches already
+			if (info.verified == vban::signature_verification::unknown && block.type () != vban::block_type::state && !vban::validate_message (account, hash, block.block_signature ()))
+			{
+				info.verified = vban::signature_verification::valid;
+			}
+		}
+	}
+}
+
+std::unique_ptr<vban::container_info_component> vban::collect_container_info (block_prevalidation & block_prevalidation, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", block_prevalidation.size (), sizeof (vban::unchecked_info) }));
+	return composite;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vban/lib/locks.hpp>
+#include <vban/secure/common.hpp>
+
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace vban
+{
+class ledger;
+
+/**
+ * Read-only stage between signature verification and the block processor queues.
+ * Worker threads check legacy block signatures against the account owning their previous block and read everything
+ * the ledger processor will look up (existing block, previous block, account info, pending entry) through a read
+ * transaction, so the single writer finds it in the store caches and page cache instead of waiting on IO while
+ * holding the write lock. Results are speculative: only positive signature checks are kept and the ledger still
+ * performs every check, batches are delivered in the order they were added so account chains stay in sequence.
+ * Only bootstrap and unchecked blocks are prevalidated, local and live blocks skip it to keep their queue priority.
+ */
+class block_prevalidation final
+{
+public:
+	block_prevalidation (vban::ledger &, unsigned);
+	~block_prevalidation ();
+	void add (vban::unchecked_info const &);
+	void stop ();
+	size_t size ();
+	bool is_active ();
+	/** False when configured with no threads, blocks should then skip this stage */
+	bool enabled () const;
+
+	std::function<void (std::deque<vban::unchecked_info> &)> blocks_prevalidated_callback;
+	std::function<void ()> transition_inactive_callback;
+	static size_t constexpr batch_size = 256;
+
+private:
+	void run ();
+	void prevalidate (std::deque<vban::unchecked_info> &);
+
+	vban::ledger & ledger;
+	vban::mutex mutex{ mutex_identifier (mutexes::block_prevalidation) };
+	vban::condition_variable condition;
+	bool stopped{ false };
+	std::deque<vban::unchecked_info> blocks;
+	/** Number of batches taken but not yet delivered */
+	unsigned active{ 0 };
+	uint64_t next_ticket{ 0 };
+	uint64_t delivered_ticket{ 0 };
+	std::vector<std::thread> threads;
+};
+
+std::unique_ptr<vban::container_info_component> collect_container_info (block_prevalidation & block_prevalidation, std::string const & name);
+}
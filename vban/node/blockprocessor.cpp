@@ -9,6 +9,9 @@
 #include <boost/format.hpp>
 
 std::chrono::milliseconds constexpr vban::block_processor::confirmation_request_delay;
+size_t constexpr vban::block_processor::source_count;
+// Indexed by vban::block_source: local, live, bootstrap, unchecked
+std::array<unsigned, vban::block_processor::source_count> const vban::block_processor::weights{ 8, 4, 1, 2 };
 
 vban::block_post_events::block_post_events (std::function<vban::read_transaction ()> && get_transaction_a) :
 	get_transaction (std::move (get_transaction_a))
@@ -25,16 +28,65 @@ vban::block_post_events::~block_post_events ()
 	}
 }
 
+vban::block_processor_batch_controller::block_processor_batch_controller (std::chrono::milliseconds target_a, size_t min_a, size_t max_a) :
+	target (target_a),
+	min (std::min (min_a, max_a)),
+	max (max_a),
+	current (min)
+{
+	debug_assert (min > 0);
+}
+
+size_t vban::block_processor_batch_controller::size () const
+{
+	return current;
+}
+
+std::chrono::microseconds vban::block_processor_batch_controller::commit_average () const
+{
+	return std::chrono::microseconds (commit_average_m.load ());
+}
+
+auto vban::block_processor_batch_controller::update (size_t processed_a, std::chrono::microseconds hold_a, std::chrono::microseconds commit_a, size_t queued_a, size_t waiters_a) -> decision
+{
+	auto result (decision::hold);
+	// Exponentially weighted so a single slow fsync doesn't dominate
+	auto commit_average_l ((commit_average_m * 3 + commit_a.count ()) / 4);
+	commit_average_m = commit_average_l;
+	size_t current_l (current);
+	if (waiters_a > 0 || hold_a > target)
+	{
+		if (current_l > min)
+		{
+			current = std::max (min, current_l / 2);
+			result = decision::shrink;
+		}
+	}
+	else if (processed_a >= current_l && queued_a > 0 && current_l < max)
+	{
+		// Only grow if a batch twice as large is still projected to finish within the target
+		auto per_block ((hold_a - commit_a).count () / static_cast<double> (processed_a));
+		auto projected (per_block * current_l * 2 + commit_average_l);
+		if (projected <= std::chrono::duration_cast<std::chrono::microseconds> (target).count ())
+		{
+			current = std::min (max, current_l * 2);
+			result = decision::grow;
+		}
+	}
+	return result;
+}
+
 vban::block_processor::block_processor (vban::node & node_a, vban::write_database_queue & write_database_queue_a) :
 	next_log (std::chrono::steady_clock::now ()),
 	node (node_a),
 	write_database_queue (write_database_queue_a),
-	state_block_signature_verification (node.checker, node.ledger.network_params.ledger.epochs, node.config, node.logger, node.flags.block_processor_verification_size)
+	state_block_signature_verification (node.checker, node.ledger.network_params.ledger.epochs, node.config, node.logger, node.flags.block_processor_verification_size),
+	block_prevalidation (node.ledger, node.config.block_processor_prevalidation_threads)
 {
 	state_block_signature_verification.blocks_verified_callback = [this] (std::deque<vban::unchecked_info> & items, std::vector<int> const & verifications, std::vector<vban::block_hash> const & hashes, std::vector<vban::signature> const & blocks_signatures) {
 		this->process_verified_state_blocks (items, verifications, hashes, blocks_signatures);
 	};
-	state_block_signature_verification.transition_inactive_callback = [this] () {
+	auto transition_inactive = [this] () {
 		if (this->flushing)
 		{
 			{
@@ -44,6 +96,23 @@ vban::block_processor::block_processor (vban::node & node_a, vban::write_databas
 			this->condition.notify_all ();
 		}
 	};
+	state_block_signature_verification.transition_inactive_callback = transition_inactive;
+	block_prevalidation.blocks_prevalidated_callback = [this] (std::deque<vban::unchecked_info> & items) {
+		{
+			vban::lock_guard<vban::mutex> guard (this->mutex);
+			for (auto const & item : items)
+			{
+				this->enqueue (item);
+			}
+		}
+		this->condition.notify_all ();
+	};
+	block_prevalidation.transition_inactive_callback = transition_inactive;
+	// An explicit batch size from the command line keeps fixed batches
+	if (node.config.block_processor_batch_target_time.count () != 0 && node.flags.block_processor_batch_size == 0)
+	{
+		batch_controller = std::make_unique<vban::block_processor_batch_controller> (node.config.block_processor_batch_target_time, 64, std::min<size_t> (node.store.max_block_write_batch_num (), 256 * 1024));
+	}
 	processing_thread = std::thread ([this] () {
 		vban::thread_role::set (vban::thread_role::name::block_processing);
 		this->process_blocks ();
@@ -53,10 +122,6 @@ vban::block_processor::block_processor (vban::node & node_a, vban::write_databas
 vban::block_processor::~block_processor ()
 {
 	stop ();
-	if (processing_thread.joinable ())
-	{
-		processing_thread.join ();
-	}
 }
 
 void vban::block_processor::stop ()
@@ -67,6 +132,11 @@ void vban::block_processor::stop ()
 	}
 	condition.notify_all ();
 	state_block_signature_verification.stop ();
+	block_prevalidation.stop ();
+	if (processing_thread.joinable ())
+	{
+		processing_thread.join ();
+	}
 }
 
 void vban::block_processor::flush ()
@@ -74,7 +144,7 @@ void vban::block_processor::flush ()
 	node.checker.flush ();
 	flushing = true;
 	vban::unique_lock<vban::mutex> lock (mutex);
-	while (!stopped && (have_blocks () || active || state_block_signature_verification.is_active ()))
+	while (!stopped && (have_blocks () || active || state_block_signature_verification.is_active () || block_prevalidation.is_active ()))
 	{
 		condition.wait (lock);
 	}
@@ -84,7 +154,14 @@ void vban::block_processor::flush ()
 size_t vban::block_processor::size ()
 {
 	vban::unique_lock<vban::mutex> lock (mutex);
-	return (blocks.size () + state_block_signature_verification.size () + forced.size ());
+	return (queued_blocks () + state_block_signature_verification.size () + block_prevalidation.size () + forced.size ());
+}
+
+size_t vban::block_processor::size (vban::block_source source_a)
+{
+	auto & queue (queues[static_cast<size_t> (source_a)]);
+	vban::unique_lock<vban::mutex> lock (mutex);
+	return queue.blocks.size () + queue.pending;
 }
 
 bool vban::block_processor::full ()
@@ -97,25 +174,48 @@ bool vban::block_processor::half_full ()
 	return size () >= node.flags.block_processor_full_size / 2;
 }
 
+bool vban::block_processor::full (vban::block_source source_a)
+{
+	return size (source_a) >= node.flags.block_processor_full_size;
+}
+
+bool vban::block_processor::half_full (vban::block_source source_a)
+{
+	return size (source_a) >= node.flags.block_processor_full_size / 2;
+}
+
+std::vector<vban::stat_histogram::bin> vban::block_processor::wait_times (vban::block_source source_a)
+{
+	return queues[static_cast<size_t> (source_a)].wait_times.get_bins ();
+}
+
 void vban::block_processor::add (std::shared_ptr<vban::block> const & block_a, uint64_t origination)
 {
 	vban::unchecked_info info (block_a, 0, origination, vban::signature_verification::unknown);
 	add (info);
 }
 
-void vban::block_processor::add (vban::unchecked_info const & info_a)
+void vban::block_processor::add (vban::unchecked_info const & info_a, vban::block_source const source_a)
 {
 	debug_assert (!vban::work_validate_entry (*info_a.block));
-	bool quarter_full (size () > node.flags.block_processor_full_size / 4);
-	if (info_a.verified == vban::signature_verification::unknown && (info_a.block->type () == vban::block_type::state || info_a.block->type () == vban::block_type::open || !info_a.account.is_zero ()))
+	// Live blocks are published again if dropped. Bootstrap has already recorded its pulls and is throttled by half_full instead, unchecked blocks are only released by blocks already processed
+	if (source_a == vban::block_source::live && full (source_a))
+	{
+		node.stats.inc (vban::stat::type::block_processor, vban::stat::detail::overflow);
+		return;
+	}
+	vban::unchecked_info info_l (info_a);
+	info_l.source = source_a;
+	++queues[static_cast<size_t> (source_a)].pending;
+	if (info_l.verified == vban::signature_verification::unknown && (info_l.block->type () == vban::block_type::state || info_l.block->type () == vban::block_type::open || !info_l.account.is_zero ()))
 	{
-		state_block_signature_verification.add (info_a);
+		state_block_signature_verification.add (info_l);
 	}
 	else
 	{
 		{
 			vban::lock_guard<vban::mutex> guard (mutex);
-			blocks.emplace_back (info_a);
+			prevalidate_or_enqueue (info_l);
 		}
 		condition.notify_all ();
 	}
@@ -125,7 +225,10 @@ void vban::block_processor::add_local (vban::unchecked_info const & info_a)
 {
 	release_assert (info_a.verified == vban::signature_verification::unknown && (info_a.block->type () == vban::block_type::state || !info_a.account.is_zero ()));
 	debug_assert (!vban::work_validate_entry (*info_a.block));
-	state_block_signature_verification.add (info_a);
+	vban::unchecked_info info_l (info_a);
+	info_l.source = vban::block_source::local;
+	++queues[static_cast<size_t> (vban::block_source::local)].pending;
+	state_block_signature_verification.add (info_l);
 }
 
 void vban::block_processor::force (std::shared_ptr<vban::block> const & block_a)
@@ -188,13 +291,13 @@ bool vban::block_processor::should_log ()
 bool vban::block_processor::have_blocks_ready ()
 {
 	debug_assert (!mutex.try_lock ());
-	return !blocks.empty () || !forced.empty () || !updates.empty ();
+	return queued_blocks () != 0 || !forced.empty () || !updates.empty ();
 }
 
 bool vban::block_processor::have_blocks ()
 {
 	debug_assert (!mutex.try_lock ());
-	return have_blocks_ready () || state_block_signature_verification.size () != 0;
+	return have_blocks_ready () || state_block_signature_verification.size () != 0 || block_prevalidation.size () != 0;
 }
 
 void vban::block_processor::process_verified_state_blocks (std::deque<vban::unchecked_info> & items, std::vector<int> const & verifications, std::vector<vban::block_hash> const & hashes, std::vector<vban::signature> const & blocks_signatures)
@@ -211,23 +314,24 @@ void vban::block_processor::process_verified_state_blocks (std::deque<vban::unch
 				if (verifications[i] == 1)
 				{
 					item.verified = vban::signature_verification::valid_epoch;
-					blocks.emplace_back (std::move (item));
+					prevalidate_or_enqueue (item);
 				}
 				else
 				{
 					// Possible regular state blocks with epoch link (send subtype)
 					item.verified = vban::signature_verification::unknown;
-					blocks.emplace_back (std::move (item));
+					prevalidate_or_enqueue (item);
 				}
 			}
 			else if (verifications[i] == 1)
 			{
 				// Non epoch blocks
 				item.verified = vban::signature_verification::valid;
-				blocks.emplace_back (std::move (item));
+				prevalidate_or_enqueue (item);
 			}
 			else
 			{
+				--queues[static_cast<size_t> (item.source)].pending;
 				requeue_invalid (hashes[i], item);
 			}
 			items.pop_front ();
@@ -239,8 +343,10 @@ void vban::block_processor::process_verified_state_blocks (std::deque<vban::unch
 void vban::block_processor::process_batch (vban::unique_lock<vban::mutex> & lock_a)
 {
 	auto scoped_write_guard = write_database_queue.wait (vban::writer::process_batch);
+	auto hold_start (std::chrono::steady_clock::now ());
 	block_post_events post_events ([&store = node.store] { return store.tx_begin_read (); });
-	auto transaction (node.store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::unchecked }));
+	auto transaction (node.store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending, tables::pending_summary, tables::representatives, tables::unchecked }));
+	vban::write_group write_group (write_database_queue, transaction);
 	vban::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
@@ -249,11 +355,12 @@ void vban::block_processor::process_batch (vban::unique_lock<vban::mutex> & lock
 	auto deadline_reached = [&timer_l, deadline = node.config.block_processor_batch_max_time] { return timer_l.after_deadline (deadline); };
 	auto processor_batch_reached = [&number_of_blocks_processed, max = node.flags.block_processor_batch_size] { return number_of_blocks_processed >= max; };
 	auto store_batch_reached = [&number_of_blocks_processed, max = node.store.max_block_write_batch_num ()] { return number_of_blocks_processed >= max; };
-	while (have_blocks_ready () && (!deadline_reached () || !processor_batch_reached ()) && !awaiting_write && !store_batch_reached ())
+	auto adaptive_batch_reached = [&number_of_blocks_processed, max = batch_controller != nullptr ? batch_controller->size () : std::numeric_limits<size_t>::max ()] { return number_of_blocks_processed >= max; };
+	while (have_blocks_ready () && (!deadline_reached () || !processor_batch_reached ()) && !awaiting_write && !store_batch_reached () && !adaptive_batch_reached ())
 	{
-		if ((blocks.size () + state_block_signature_verification.size () + forced.size () + updates.size () > 64) && should_log ())
+		if ((queued_blocks () + state_block_signature_verification.size () + forced.size () + updates.size () > 64) && should_log ())
 		{
-			node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% state blocks) (+ %3% forced, %4% updates) in processing queue") % blocks.size () % state_block_signature_verification.size () % forced.size () % updates.size ()));
+			node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% state blocks) (+ %3% forced, %4% updates) in processing queue") % queued_blocks () % state_block_signature_verification.size () % forced.size () % updates.size ()));
 		}
 		if (!updates.empty ())
 		{
@@ -274,8 +381,7 @@ void vban::block_processor::process_batch (vban::unique_lock<vban::mutex> & lock
 			bool force (false);
 			if (forced.empty ())
 			{
-				info = blocks.front ();
-				blocks.pop_front ();
+				info = next_block ();
 				hash = info.block->hash ();
 			}
 			else
@@ -324,8 +430,35 @@ void vban::block_processor::process_batch (vban::unique_lock<vban::mutex> & lock
 		lock_a.lock ();
 	}
 	awaiting_write = false;
+	auto queued (queued_blocks () + forced.size ());
 	lock_a.unlock ();
 
+	vban::timer<std::chrono::microseconds> commit_timer (vban::timer_state::started);
+	auto appended (write_group.commit ());
+	auto commit_time (commit_timer.stop ());
+	if (appended != 0)
+	{
+		node.stats.add (vban::stat::type::block_processor, vban::stat::detail::write_group_appended, vban::stat::dir::in, appended);
+	}
+
+	if (batch_controller != nullptr && number_of_blocks_processed != 0)
+	{
+		auto hold_time (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - hold_start));
+		switch (batch_controller->update (number_of_blocks_processed, hold_time, commit_time, queued, write_database_queue.waiters ()))
+		{
+			case vban::block_processor_batch_controller::decision::grow:
+				node.stats.inc (vban::stat::type::block_processor, vban::stat::detail::batch_grow);
+				break;
+			case vban::block_processor_batch_controller::decision::shrink:
+				node.stats.inc (vban::stat::type::block_processor, vban::stat::detail::batch_shrink);
+				break;
+			case vban::block_processor_batch_controller::decision::hold:
+				node.stats.inc (vban::stat::type::block_processor, vban::stat::detail::batch_hold);
+				break;
+		}
+		node.stats.add (vban::stat::type::block_processor, vban::stat::detail::batch_blocks, vban::stat::dir::in, number_of_blocks_processed);
+	}
+
 	if (node.config.logging.timing_logging () && number_of_blocks_processed != 0 && timer_l.stop () > std::chrono::milliseconds (100))
 	{
 		node.logger.always_log (boost::str (boost::format ("Processed %1% blocks (%2% blocks were forced) in %3% %4%") % number_of_blocks_processed % number_of_forced_processed % timer_l.value ().count () % timer_l.unit ()));
@@ -403,7 +536,7 @@ vban::process_return vban::block_processor::process_one (vban::write_transaction
 			}
 
 			vban::unchecked_key unchecked_key (block->previous (), hash);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
+			node.unchecked.put (transaction_a, unchecked_key, info_a);
 
 			events_a.events.emplace_back ([this, hash] (vban::transaction const & /* unused */) { this->node.gap_cache.add (hash); });
 
@@ -423,7 +556,7 @@ vban::process_return vban::block_processor::process_one (vban::write_transaction
 			}
 
 			vban::unchecked_key unchecked_key (node.ledger.block_source (transaction_a, *(block)), hash);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
+			node.unchecked.put (transaction_a, unchecked_key, info_a);
 
 			events_a.events.emplace_back ([this, hash] (vban::transaction const & /* unused */) { this->node.gap_cache.add (hash); });
 
@@ -443,7 +576,7 @@ vban::process_return vban::block_processor::process_one (vban::write_transaction
 			}
 
 			vban::unchecked_key unchecked_key (block->account (), hash); // Specific unchecked key starting with epoch open block account public key
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
+			node.unchecked.put (transaction_a, unchecked_key, info_a);
 
 			node.stats.inc (vban::stat::type::ledger, vban::stat::detail::gap_source);
 			break;
@@ -548,18 +681,103 @@ void vban::block_processor::process_old (vban::transaction const & transaction_a
 
 void vban::block_processor::queue_unchecked (vban::write_transaction const & transaction_a, vban::hash_or_account const & hash_or_account_a)
 {
-	auto unchecked_blocks (node.store.unchecked_get (transaction_a, hash_or_account_a.hash));
-	for (auto & info : unchecked_blocks)
+	if (!node.flags.disable_block_processor_unchecked_deletion)
+	{
+		// Dependent chains are queued a batch at once, dependencies first, instead of one block each time its dependency is written
+		// Bounded by the room left in the unchecked queue and by a write batch, the last released blocks release the rest once written
+		auto queued (size (vban::block_source::unchecked));
+		auto room (queued < node.flags.block_processor_full_size ? node.flags.block_processor_full_size - queued : 0);
+		auto batch (batch_controller != nullptr ? batch_controller->size () : node.store.max_block_write_batch_num ());
+		for (auto & info : node.unchecked.release (transaction_a, hash_or_account_a, std::min<size_t> (room, batch)))
+		{
+			add (info, vban::block_source::unchecked);
+		}
+	}
+	else
 	{
-		if (!node.flags.disable_block_processor_unchecked_deletion)
+		for (auto & info : node.unchecked.get (transaction_a, hash_or_account_a.hash))
 		{
-			node.store.unchecked_del (transaction_a, vban::unchecked_key (hash_or_account_a, info.block->hash ()));
+			add (info, vban::block_source::unchecked);
 		}
-		add (info);
 	}
 	node.gap_cache.erase (hash_or_account_a.hash);
 }
 
+vban::block_processor::queue::queue () :
+	wait_times ({ 0, 1, 10, 100, 1000, 10000, std::numeric_limits<uint64_t>::max () })
+{
+}
+
+vban::stat::detail vban::block_processor::queue_detail (vban::block_source source_a)
+{
+	switch (source_a)
+	{
+		case vban::block_source::local:
+			return vban::stat::detail::queue_local;
+		case vban::block_source::live:
+			return vban::stat::detail::queue_live;
+		case vban::block_source::bootstrap:
+			return vban::stat::detail::queue_bootstrap;
+		case vban::block_source::unchecked:
+			return vban::stat::detail::queue_unchecked;
+	}
+	debug_assert (false);
+	return vban::stat::detail::all;
+}
+
+void vban::block_processor::enqueue (vban::unchecked_info const & info_a)
+{
+	debug_assert (!mutex.try_lock ());
+	auto & queue (queues[static_cast<size_t> (info_a.source)]);
+	--queue.pending;
+	queue.blocks.emplace_back (info_a, std::chrono::steady_clock::now ());
+}
+
+void vban::block_processor::prevalidate_or_enqueue (vban::unchecked_info const & info_a)
+{
+	debug_assert (!mutex.try_lock ());
+	// Local and live blocks go straight to their queues so they are not held behind the bootstrap backlog
+	auto bulk (info_a.source == vban::block_source::bootstrap || info_a.source == vban::block_source::unchecked);
+	if (bulk && block_prevalidation.enabled ())
+	{
+		block_prevalidation.add (info_a);
+	}
+	else
+	{
+		enqueue (info_a);
+	}
+}
+
+size_t vban::block_processor::queued_blocks () const
+{
+	size_t result (0);
+	for (auto const & queue : queues)
+	{
+		result += queue.blocks.size ();
+	}
+	return result;
+}
+
+vban::unchecked_info vban::block_processor::next_block ()
+{
+	debug_assert (!mutex.try_lock ());
+	debug_assert (queued_blocks () != 0);
+	// Take up to weight blocks from a queue before moving on, empty queues give up their turn
+	while (drain_credit == 0 || queues[drain_index].blocks.empty ())
+	{
+		drain_index = (drain_index + 1) % queues.size ();
+		drain_credit = weights[drain_index];
+	}
+	--drain_credit;
+	auto & queue (queues[drain_index]);
+	auto result (std::move (queue.blocks.front ().first));
+	auto waited (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - queue.blocks.front ().second));
+	queue.blocks.pop_front ();
+	queue.wait_times.add (waited.count (), 1);
+	node.stats.inc (vban::stat::type::block_processor, queue_detail (result.source));
+	return result;
+}
+
 void vban::block_processor::requeue_invalid (vban::block_hash const & hash_a, vban::unchecked_info const & info_a)
 {
 	debug_assert (hash_a == info_a.block->hash ());
@@ -568,18 +786,39 @@ void vban::block_processor::requeue_invalid (vban::block_hash const & hash_a, vb
 
 std::unique_ptr<vban::container_info_component> vban::collect_container_info (block_processor & block_processor, std::string const & name)
 {
-	size_t blocks_count;
+	std::array<size_t, vban::block_processor::source_count> queue_counts;
 	size_t forced_count;
 
 	{
 		vban::lock_guard<vban::mutex> guard (block_processor.mutex);
-		blocks_count = block_processor.blocks.size ();
+		for (size_t i (0); i < queue_counts.size (); ++i)
+		{
+			queue_counts[i] = block_processor.queues[i].blocks.size ();
+		}
 		forced_count = block_processor.forced.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (collect_container_info (block_processor.state_block_signature_verification, "state_block_signature_verification"));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (block_processor.blocks)::value_type) }));
+	composite->add_component (collect_container_info (block_processor.block_prevalidation, "block_prevalidation"));
+	std::array<char const *, vban::block_processor::source_count> const queue_names{ "local", "live", "bootstrap", "unchecked" };
+	for (size_t i (0); i < queue_counts.size (); ++i)
+	{
+		auto & queue (block_processor.queues[i]);
+		auto queue_composite = std::make_unique<container_info_composite> (queue_names[i]);
+		queue_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", queue_counts[i], sizeof (decltype (queue.blocks)::value_type) }));
+		queue_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pending", queue.pending, 0 }));
+		// Bins are reported as wait_<from>ms, the last one is open ended
+		for (auto const & bin : queue.wait_times.get_bins ())
+		{
+			queue_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "wait_" + std::to_string (bin.start_inclusive) + "ms", bin.value, 0 }));
+		}
+		composite->add_component (std::move (queue_composite));
+	}
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "forced", forced_count, sizeof (decltype (block_processor.forced)::value_type) }));
+	if (block_processor.batch_controller != nullptr)
+	{
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "batch_size", block_processor.batch_controller->size (), 0 }));
+	}
 	return composite;
 }
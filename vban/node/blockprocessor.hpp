@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vban/lib/blocks.hpp>
+#include <vban/lib/stats.hpp>
+#include <vban/node/block_prevalidation.hpp>
 #include <vban/node/state_block_signature_verification.hpp>
 #include <vban/secure/common.hpp>
 
@@ -10,6 +12,8 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -40,9 +44,49 @@ private:
 	std::function<vban::read_transaction ()> get_transaction;
 };
 
+/**
+ * Sizes block processor write batches from how recent batches went.
+ * Batches grow while blocks keep queueing and the projected write lock hold time stays within the target, amortizing
+ * commits and fsyncs during bootstrap. They shrink as soon as another writer waits on the write queue or a batch overruns
+ * the target, so confirmation height writes are not stalled behind live traffic.
+ */
+class block_processor_batch_controller final
+{
+public:
+	enum class decision
+	{
+		hold,
+		grow,
+		shrink
+	};
+	block_processor_batch_controller (std::chrono::milliseconds target_a, size_t min_a, size_t max_a);
+	/** Maximum number of blocks in the next batch */
+	size_t size () const;
+	/** Smoothed time spent committing and syncing a batch */
+	std::chrono::microseconds commit_average () const;
+	/**
+	 * Adjusts the next batch size after a batch was committed
+	 * @param processed_a Number of blocks written by the batch
+	 * @param hold_a Time the write lock was held, including the commit
+	 * @param commit_a Time the commit took
+	 * @param queued_a Number of blocks still waiting to be processed
+	 * @param waiters_a Number of other writers waiting on the write queue
+	 */
+	decision update (size_t processed_a, std::chrono::microseconds hold_a, std::chrono::microseconds commit_a, size_t queued_a, size_t waiters_a);
+	std::chrono::microseconds const target;
+	size_t const min;
+	size_t const max;
+
+private:
+	std::atomic<size_t> current;
+	std::atomic<uint64_t> commit_average_m{ 0 };
+};
+
 /**
  * Processing blocks is a potentially long IO operation.
- * This class isolates block insertion from other operations like servicing network operations
+ * This class isolates block insertion from other operations like servicing network operations.
+ * Blocks wait in one queue per vban::block_source, drained by weighted round robin so a bootstrap flood cannot delay
+ * wallet and live blocks by more than a few bootstrap blocks each turn.
  */
 class block_processor final
 {
@@ -52,10 +96,18 @@ public:
 	void stop ();
 	void flush ();
 	size_t size ();
+	/** Blocks from \p source_a waiting in signature verification, pre-validation or their queue */
+	size_t size (vban::block_source source_a);
 	bool full ();
 	bool half_full ();
+	/** Per source backpressure, producers should back off or drop once their own queue is full */
+	bool full (vban::block_source source_a);
+	bool half_full (vban::block_source source_a);
+	/** Distribution of the milliseconds blocks from \p source_a waited in their queue */
+	std::vector<vban::stat_histogram::bin> wait_times (vban::block_source source_a);
 	void add_local (vban::unchecked_info const & info_a);
-	void add (vban::unchecked_info const &);
+	/** Live blocks are dropped once their source is full, blocks from every other source are always queued */
+	void add (vban::unchecked_info const &, vban::block_source const = vban::block_source::live);
 	void add (std::shared_ptr<vban::block> const &, uint64_t = 0);
 	void force (std::shared_ptr<vban::block> const &);
 	void update (std::shared_ptr<vban::block> const &);
@@ -77,11 +129,30 @@ private:
 	void process_old (vban::transaction const &, std::shared_ptr<vban::block> const &, vban::block_origin const);
 	void requeue_invalid (vban::block_hash const &, vban::unchecked_info const &);
 	void process_verified_state_blocks (std::deque<vban::unchecked_info> &, std::vector<int> const &, std::vector<vban::block_hash> const &, std::vector<vban::signature> const &);
+	void enqueue (vban::unchecked_info const &);
+	void prevalidate_or_enqueue (vban::unchecked_info const &);
+	vban::unchecked_info next_block ();
+	size_t queued_blocks () const;
+	class queue final
+	{
+	public:
+		queue ();
+		std::deque<std::pair<vban::unchecked_info, std::chrono::steady_clock::time_point>> blocks;
+		/** Blocks from this source still in signature verification or pre-validation */
+		std::atomic<size_t> pending{ 0 };
+		vban::stat_histogram wait_times;
+	};
+	static size_t constexpr source_count = 4;
+	/** Number of consecutive blocks taken from a queue before moving on to the next */
+	static std::array<unsigned, source_count> const weights;
+	static vban::stat::detail queue_detail (vban::block_source);
+	std::array<queue, source_count> queues;
+	size_t drain_index{ 0 };
+	unsigned drain_credit{ 0 };
 	bool stopped{ false };
 	bool active{ false };
 	bool awaiting_write{ false };
 	std::chrono::steady_clock::time_point next_log;
-	std::deque<vban::unchecked_info> blocks;
 	std::deque<std::shared_ptr<vban::block>> forced;
 	std::deque<std::shared_ptr<vban::block>> updates;
 	vban::condition_variable condition;
@@ -89,6 +160,9 @@ private:
 	vban::write_database_queue & write_database_queue;
 	vban::mutex mutex{ mutex_identifier (mutexes::block_processor) };
 	vban::state_block_signature_verification state_block_signature_verification;
+	vban::block_prevalidation block_prevalidation;
+	/** Null when batches are bounded by fixed limits only */
+	std::unique_ptr<vban::block_processor_batch_controller> batch_controller;
 	std::thread processing_thread;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (block_processor & block_processor, std::string const & name);
@@ -145,7 +145,7 @@ bool vban::bootstrap_attempt::process_block (std::shared_ptr<vban::block> const
 	else
 	{
 		vban::unchecked_info info (block_a, known_account_a, 0, vban::signature_verification::unknown);
-		node->block_processor.add (info);
+		node->block_processor.add (info, vban::block_source::bootstrap);
 	}
 	return stop_pull;
 }
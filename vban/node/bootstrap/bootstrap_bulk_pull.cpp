@@ -103,7 +103,7 @@ void vban::bulk_pull_client::request ()
 void vban::bulk_pull_client::throttled_receive_block ()
 {
 	debug_assert (!network_error);
-	if (!connection->node->block_processor.half_full () && !connection->node->block_processor.flushing)
+	if (!connection->node->block_processor.half_full (vban::block_source::bootstrap) && !connection->node->block_processor.flushing)
 	{
 		receive_block ();
 	}
@@ -481,19 +481,26 @@ void vban::bulk_pull_server::set_current_end ()
 
 void vban::bulk_pull_server::send_next ()
 {
-	auto block (get_next ());
-	if (block != nullptr)
+	std::vector<uint8_t> send_buffer;
 	{
-		std::vector<uint8_t> send_buffer;
+		// Stored blocks are forwarded as they are, without decoding them
+		auto transaction (connection->node->store.tx_begin_read ());
+		auto block (get_next (transaction));
+		if (block)
 		{
-			vban::vectorstream stream (send_buffer);
-			vban::serialize_block (stream, *block);
+			{
+				vban::vectorstream stream (send_buffer);
+				block.serialize (stream);
+			}
+			if (connection->node->config.logging.bulk_pull_logging ())
+			{
+				connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block.hash ().to_string ()));
+			}
 		}
+	}
+	if (!send_buffer.empty ())
+	{
 		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
-		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
-		}
 		connection->socket->async_write (vban::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, size_t size_a) {
 			this_l->sent_action (ec, size_a);
 		});
@@ -506,7 +513,14 @@ void vban::bulk_pull_server::send_next ()
 
 std::shared_ptr<vban::block> vban::bulk_pull_server::get_next ()
 {
-	std::shared_ptr<vban::block> result;
+	auto transaction (connection->node->store.tx_begin_read ());
+	auto block (get_next (transaction));
+	return block ? block.block () : nullptr;
+}
+
+vban::block_view vban::bulk_pull_server::get_next (vban::transaction const & transaction_a)
+{
+	vban::block_view result;
 	bool send_current = false, set_current_to_end = false;
 
 	/*
@@ -545,10 +559,10 @@ std::shared_ptr<vban::block> vban::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		result = connection->node->block (current);
-		if (result != nullptr && set_current_to_end == false)
+		result = connection->node->store.block_get_view (transaction_a, current);
+		if (result && set_current_to_end == false)
 		{
-			auto previous (result->previous ());
+			auto previous (result.previous ());
 			if (!previous.is_zero ())
 			{
 				current = previous;
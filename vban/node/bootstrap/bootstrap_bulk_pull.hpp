@@ -7,6 +7,7 @@
 
 namespace vban
 {
+class block_view;
 class bootstrap_attempt;
 class pull_info
 {
@@ -65,6 +66,7 @@ public:
 	bulk_pull_server (std::shared_ptr<vban::bootstrap_server> const &, std::unique_ptr<vban::bulk_pull>);
 	void set_current_end ();
 	std::shared_ptr<vban::block> get_next ();
+	vban::block_view get_next (vban::transaction const &);
 	void send_next ();
 	void sent_action (boost::system::error_code const &, size_t);
 	void send_finished ();
@@ -269,7 +269,7 @@ bool vban::bootstrap_attempt_lazy::process_block_lazy (std::shared_ptr<vban::blo
 		lazy_block_state_backlog_check (block_a, hash);
 		lock.unlock ();
 		vban::unchecked_info info (block_a, known_account_a, 0, vban::signature_verification::unknown, retry_limit > node->network_params.bootstrap.lazy_retry_limit);
-		node->block_processor.add (info);
+		node->block_processor.add (info, vban::block_source::bootstrap);
 	}
 	// Force drop lazy bootstrap connection for long bulk_pull
 	if (pull_blocks_processed > max_blocks)
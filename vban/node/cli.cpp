@@ -59,6 +59,7 @@ void vban::add_node_options (boost::program_options::options_description & descr
 	("final_vote_clear", "Clear final votes")
 	("rebuild_database", "Rebuild LMDB database with vacuum for best compaction")
 	("migrate_database_lmdb_to_rocksdb", "Migrates LMDB database to RocksDB")
+	("rebuild_account_history_index", "Build the index of blocks by account and height used by account_history when the account_history_index node option is enabled")
 	("diagnostics", "Run internal diagnostics")
 	("generate_config", boost::program_options::value<std::string> (), "Write configuration to stdout, populated with defaults suitable for this system. Pass the configuration type node or rpc. See also use_defaults.")
 	("key_create", "Generates a adhoc random keypair and prints it to stdout")
@@ -220,7 +221,7 @@ bool copy_database (boost::filesystem::path const & data_path, boost::program_op
 		auto & store (node.node->store);
 		if (vm.count ("unchecked_clear"))
 		{
-			node.node->store.unchecked_clear (store.tx_begin_write ());
+			node.node->unchecked.clear (store.tx_begin_write ());
 		}
 		if (vm.count ("clear_send_ids"))
 		{
@@ -491,7 +492,7 @@ std::error_code vban::handle_node_options (boost::program_options::variables_map
 		if (!node.node->init_error ())
 		{
 			auto transaction (node.node->store.tx_begin_write ());
-			node.node->store.unchecked_clear (transaction);
+			node.node->unchecked.clear (transaction);
 			std::cout << "Unchecked blocks deleted" << std::endl;
 		}
 		else
@@ -650,6 +651,28 @@ std::error_code vban::handle_node_options (boost::program_options::variables_map
 			database_write_lock_error (ec);
 		}
 	}
+	else if (vm.count ("rebuild_account_history_index"))
+	{
+		boost::filesystem::path data_path = vm.count ("data_path") ? boost::filesystem::path (vm["data_path"].as<std::string> ()) : vban::working_path ();
+		auto node_flags = vban::inactive_node_flag_defaults ();
+		node_flags.read_only = false;
+		vban::update_flags (node_flags, vm);
+		vban::inactive_node node (data_path, node_flags);
+		if (!node.node->init_error ())
+		{
+			std::cout << "Rebuilding account history index, this may take a while..." << std::endl;
+			auto entries (node.node->ledger.account_heights_rebuild ());
+			std::cout << boost::str (boost::format ("Account history index rebuilt with %1% entries") % entries) << std::endl;
+			if (!node.node->config.account_history_index)
+			{
+				std::cout << "The index is only used and kept up to date once account_history_index is enabled in the node config, starting the node with it disabled clears the index" << std::endl;
+			}
+		}
+		else
+		{
+			database_write_lock_error (ec);
+		}
+	}
 	else if (vm.count ("generate_config"))
 	{
 		auto type = vm["generate_config"].as<std::string> ();
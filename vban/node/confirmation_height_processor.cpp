@@ -109,6 +109,7 @@ void vban::confirmation_height_processor::run (confirmation_height_mode mode_a)
 				else if (!unbounded_processor.pending_empty ())
 				{
 					debug_assert (bounded_processor.pending_empty ());
+					if (!unbounded_processor.cement_blocks_appended ())
 					{
 						auto scoped_write_guard = write_database_queue.wait (vban::writer::confirmation_height);
 						unbounded_processor.cement_blocks (scoped_write_guard);
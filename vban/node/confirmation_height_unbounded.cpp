@@ -176,6 +176,10 @@ void vban::confirmation_height_unbounded::process (std::shared_ptr<vban::block>
 				auto scoped_write_guard = write_database_queue.pop ();
 				cement_blocks (scoped_write_guard);
 			}
+			else if (cement_blocks_appended ())
+			{
+				// Written along with the current writer's transaction
+			}
 			else if (force_write)
 			{
 				// Unbounded processor has grown too large, force a write
@@ -361,9 +365,6 @@ void vban::confirmation_height_unbounded::prepare_iterated_blocks_for_cementing
 	}
 }
 
-/*
- * Returns true if there was an error in finding one of the blocks to write a confirmation height for, false otherwise
- */
 void vban::confirmation_height_unbounded::cement_blocks (vban::write_guard & scoped_write_guard_a)
 {
 	vban::timer<std::chrono::milliseconds> cemented_batch_timer;
@@ -372,54 +373,7 @@ void vban::confirmation_height_unbounded::cement_blocks (vban::write_guard & sco
 	{
 		auto transaction (ledger.store.tx_begin_write ({}, { vban::tables::confirmation_height }));
 		cemented_batch_timer.start ();
-		while (!pending_writes.empty ())
-		{
-			auto & pending = pending_writes.front ();
-			vban::confirmation_height_info confirmation_height_info;
-			ledger.store.confirmation_height_get (transaction, pending.account, confirmation_height_info);
-			auto confirmation_height = confirmation_height_info.height;
-			if (pending.height > confirmation_height)
-			{
-				auto block = ledger.store.block_get (transaction, pending.hash);
-				debug_assert (network_params.network.is_dev_network () || ledger.pruning || block != nullptr);
-				debug_assert (network_params.network.is_dev_network () || ledger.pruning || block->sideband ().height == pending.height);
-
-				if (!block)
-				{
-					if (ledger.pruning && ledger.store.pruned_exists (transaction, pending.hash))
-					{
-						pending_writes.erase (pending_writes.begin ());
-						--pending_writes_size;
-						continue;
-					}
-					else
-					{
-						auto error_str = (boost::format ("Failed to write confirmation height for block %1% (unbounded processor)") % pending.hash.to_string ()).str ();
-						logger.always_log (error_str);
-						std::cerr << error_str << std::endl;
-						error = true;
-						break;
-					}
-				}
-				ledger.stats.add (vban::stat::type::confirmation_height, vban::stat::detail::blocks_confirmed, vban::stat::dir::in, pending.height - confirmation_height);
-				ledger.stats.add (vban::stat::type::confirmation_height, vban::stat::detail::blocks_confirmed_unbounded, vban::stat::dir::in, pending.height - confirmation_height);
-				debug_assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
-				confirmation_height = pending.height;
-				ledger.cache.cemented_count += pending.num_blocks_confirmed;
-				ledger.store.confirmation_height_put (transaction, pending.account, { confirmation_height, pending.hash });
-
-				// Reverse it so that the callbacks start from the lowest newly cemented block and move upwards
-				std::reverse (pending.block_callback_data.begin (), pending.block_callback_data.end ());
-
-				vban::lock_guard<vban::mutex> guard (block_cache_mutex);
-				std::transform (pending.block_callback_data.begin (), pending.block_callback_data.end (), std::back_inserter (cemented_blocks), [&block_cache = block_cache] (auto const & hash_a) {
-					debug_assert (block_cache.count (hash_a) == 1);
-					return block_cache.at (hash_a);
-				});
-			}
-			pending_writes.erase (pending_writes.begin ());
-			--pending_writes_size;
-		}
+		error = write_pending (transaction, cemented_blocks);
 	}
 
 	auto time_spent_cementing = cemented_batch_timer.since_start ().count ();
@@ -437,6 +391,82 @@ void vban::confirmation_height_unbounded::cement_blocks (vban::write_guard & sco
 	timer.restart ();
 }
 
+bool vban::confirmation_height_unbounded::cement_blocks_appended ()
+{
+	std::vector<std::shared_ptr<vban::block>> cemented_blocks;
+	auto error = false;
+	auto appended (write_database_queue.append (vban::writer::confirmation_height, [this, &cemented_blocks, &error] (vban::write_transaction & transaction_a) {
+		error = write_pending (transaction_a, cemented_blocks);
+	}));
+	if (appended)
+	{
+		notify_observers_callback (cemented_blocks);
+		release_assert (!error);
+
+		debug_assert (pending_writes.empty ());
+		debug_assert (pending_writes_size == 0);
+		timer.restart ();
+	}
+	return appended;
+}
+
+/*
+ * Returns true if there was an error in finding one of the blocks to write a confirmation height for, false otherwise
+ */
+bool vban::confirmation_height_unbounded::write_pending (vban::write_transaction const & transaction, std::vector<std::shared_ptr<vban::block>> & cemented_blocks)
+{
+	auto error = false;
+	while (!pending_writes.empty ())
+	{
+		auto & pending = pending_writes.front ();
+		vban::confirmation_height_info confirmation_height_info;
+		ledger.store.confirmation_height_get (transaction, pending.account, confirmation_height_info);
+		auto confirmation_height = confirmation_height_info.height;
+		if (pending.height > confirmation_height)
+		{
+			auto block = ledger.store.block_get (transaction, pending.hash);
+			debug_assert (network_params.network.is_dev_network () || ledger.pruning || block != nullptr);
+			debug_assert (network_params.network.is_dev_network () || ledger.pruning || block->sideband ().height == pending.height);
+
+			if (!block)
+			{
+				if (ledger.pruning && ledger.store.pruned_exists (transaction, pending.hash))
+				{
+					pending_writes.erase (pending_writes.begin ());
+					--pending_writes_size;
+					continue;
+				}
+				else
+				{
+					auto error_str = (boost::format ("Failed to write confirmation height for block %1% (unbounded processor)") % pending.hash.to_string ()).str ();
+					logger.always_log (error_str);
+					std::cerr << error_str << std::endl;
+					error = true;
+					break;
+				}
+			}
+			ledger.stats.add (vban::stat::type::confirmation_height, vban::stat::detail::blocks_confirmed, vban::stat::dir::in, pending.height - confirmation_height);
+			ledger.stats.add (vban::stat::type::confirmation_height, vban::stat::detail::blocks_confirmed_unbounded, vban::stat::dir::in, pending.height - confirmation_height);
+			debug_assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
+			confirmation_height = pending.height;
+			ledger.cache.cemented_count += pending.num_blocks_confirmed;
+			ledger.store.confirmation_height_put (transaction, pending.account, { confirmation_height, pending.hash });
+
+			// Reverse it so that the callbacks start from the lowest newly cemented block and move upwards
+			std::reverse (pending.block_callback_data.begin (), pending.block_callback_data.end ());
+
+			vban::lock_guard<vban::mutex> guard (block_cache_mutex);
+			std::transform (pending.block_callback_data.begin (), pending.block_callback_data.end (), std::back_inserter (cemented_blocks), [&block_cache = block_cache] (auto const & hash_a) {
+				debug_assert (block_cache.count (hash_a) == 1);
+				return block_cache.at (hash_a);
+			});
+		}
+		pending_writes.erase (pending_writes.begin ());
+		--pending_writes_size;
+	}
+	return error;
+}
+
 std::shared_ptr<vban::block> vban::confirmation_height_unbounded::get_block_and_sideband (vban::block_hash const & hash_a, vban::transaction const & transaction_a)
 {
 	vban::lock_guard<vban::mutex> guard (block_cache_mutex);
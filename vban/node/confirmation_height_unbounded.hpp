@@ -25,6 +25,8 @@ public:
 	void clear_process_vars ();
 	void process (std::shared_ptr<vban::block> original_block);
 	void cement_blocks (vban::write_guard &);
+	/** Cements pending writes in the transaction of the writer currently holding the database queue, returns false if it did not accept them */
+	bool cement_blocks_appended ();
 	bool has_iterated_over_block (vban::block_hash const &) const;
 
 private:
@@ -94,6 +96,8 @@ private:
 
 	void collect_unconfirmed_receive_and_sources_for_account (uint64_t, uint64_t, std::shared_ptr<vban::block> const &, vban::block_hash const &, vban::account const &, vban::read_transaction const &, std::vector<receive_source_pair> &, std::vector<vban::block_hash> &, std::vector<vban::block_hash> &, std::shared_ptr<vban::block> original_block);
 	void prepare_iterated_blocks_for_cementing (preparation_data &);
+	/** Returns true if one of the blocks to cement could not be found */
+	bool write_pending (vban::write_transaction const &, std::vector<std::shared_ptr<vban::block>> &);
 
 	vban::network_params network_params;
 	vban::ledger & ledger;
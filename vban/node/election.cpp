@@ -232,40 +232,140 @@ vban::tally_t vban::election::tally () const
 
 vban::tally_t vban::election::tally_impl () const
 {
-	std::unordered_map<vban::block_hash, vban::uint256_t> block_weights;
-	std::unordered_map<vban::block_hash, vban::uint256_t> final_weights_l;
-	for (auto const & [account, info] : last_votes)
+	auto epoch (node.ledger.cache.rep_weights.epoch ());
+	if (!tally_valid || voter_weights.size () != last_votes.size ())
 	{
-		auto rep_weight (node.ledger.weight (account));
-		block_weights[info.hash] += rep_weight;
-		if (info.timestamp == std::numeric_limits<uint64_t>::max ())
-		{
-			final_weights_l[info.hash] += rep_weight;
-		}
+		tally_rebuild (epoch);
 	}
-	last_tally = block_weights;
+	else if (epoch != tally_epoch)
+	{
+		tally_refresh (epoch);
+	}
+	last_tally.clear ();
 	vban::tally_t result;
-	for (auto const & [hash, amount] : block_weights)
+	for (auto const & [hash, tally] : block_tallies)
 	{
+		auto amount_l (tally.weight.number ());
+		last_tally.emplace (hash, amount_l);
 		auto block (last_blocks.find (hash));
 		if (block != last_blocks.end ())
 		{
-			result.emplace (amount, block->second);
+			result.emplace (amount_l, block->second);
 		}
 	}
 	// Calculate final votes sum for winner
-	if (!final_weights_l.empty () && !result.empty ())
+	if (!result.empty ())
 	{
-		auto winner_hash (result.begin ()->second->hash ());
-		auto find_final (final_weights_l.find (winner_hash));
-		if (find_final != final_weights_l.end ())
+		auto find_final (block_tallies.find (result.begin ()->second->hash ()));
+		if (find_final != block_tallies.end () && find_final->second.final_voters > 0)
 		{
-			final_weight = find_final->second;
+			final_weight = find_final->second.final_weight.number ();
 		}
 	}
 	return result;
 }
 
+void vban::election::tally_rebuild (uint64_t epoch_a) const
+{
+	// The epoch is read before any weight so a change racing with the rebuild triggers another one
+	node.stats.inc (vban::stat::type::election, vban::stat::detail::tally_rebuild);
+	block_tallies.clear ();
+	voter_weights.clear ();
+	for (auto const & [account, info] : last_votes)
+	{
+		auto rep_weight (node.ledger.weight_fixed (account));
+		voter_weights.emplace (account, rep_weight);
+		auto & tally (block_tallies[info.hash]);
+		tally.weight += rep_weight;
+		++tally.voters;
+		if (info.timestamp == std::numeric_limits<uint64_t>::max ())
+		{
+			tally.final_weight += rep_weight;
+			++tally.final_voters;
+		}
+	}
+	tally_epoch = epoch_a;
+	tally_valid = true;
+}
+
+void vban::election::tally_refresh (uint64_t epoch_a) const
+{
+	// Weights change on every processed block, usually for representatives which are not voting in this election
+	std::vector<vban::account> changed;
+	if (node.ledger.cache.rep_weights.changes (tally_epoch, epoch_a, changed))
+	{
+		tally_rebuild (epoch_a);
+	}
+	else
+	{
+		for (auto const & account : changed)
+		{
+			auto existing_weight (voter_weights.find (account));
+			if (existing_weight != voter_weights.end ())
+			{
+				auto const & info (last_votes.find (account)->second);
+				auto & tally (block_tallies[info.hash]);
+				auto rep_weight (node.ledger.weight_fixed (account));
+				tally.weight -= existing_weight->second;
+				tally.weight += rep_weight;
+				if (info.timestamp == std::numeric_limits<uint64_t>::max ())
+				{
+					tally.final_weight -= existing_weight->second;
+					tally.final_weight += rep_weight;
+				}
+				existing_weight->second = rep_weight;
+			}
+		}
+		tally_epoch = epoch_a;
+	}
+}
+
+void vban::election::tally_insert (vban::account const & account_a, vban::vote_info const & info_a)
+{
+	debug_assert (!mutex.try_lock ());
+	if (tally_valid)
+	{
+		auto rep_weight (node.ledger.weight_fixed (account_a));
+		debug_assert (voter_weights.count (account_a) == 0);
+		voter_weights.emplace (account_a, rep_weight);
+		auto & tally (block_tallies[info_a.hash]);
+		tally.weight += rep_weight;
+		++tally.voters;
+		if (info_a.timestamp == std::numeric_limits<uint64_t>::max ())
+		{
+			tally.final_weight += rep_weight;
+			++tally.final_voters;
+		}
+	}
+}
+
+void vban::election::tally_erase (vban::account const & account_a, vban::vote_info const & info_a)
+{
+	debug_assert (!mutex.try_lock ());
+	auto existing_weight (voter_weights.find (account_a));
+	auto existing_tally (block_tallies.find (info_a.hash));
+	if (tally_valid && existing_weight != voter_weights.end () && existing_tally != block_tallies.end ())
+	{
+		auto & tally (existing_tally->second);
+		tally.weight -= existing_weight->second;
+		--tally.voters;
+		if (info_a.timestamp == std::numeric_limits<uint64_t>::max ())
+		{
+			tally.final_weight -= existing_weight->second;
+			--tally.final_voters;
+		}
+		if (tally.voters == 0)
+		{
+			block_tallies.erase (existing_tally);
+		}
+		voter_weights.erase (existing_weight);
+	}
+	else
+	{
+		tally_valid = false;
+	}
+}
+
 void vban::election::confirm_if_quorum (vban::unique_lock<vban::mutex> & lock_a)
 {
 	debug_assert (lock_a.owns_lock ());
@@ -384,7 +484,17 @@ vban::election_vote_result vban::election::vote (vban::account const & rep, uint
 		if (should_process)
 		{
 			node.stats.inc (vban::stat::type::election, vban::stat::detail::vote_new);
-			last_votes[rep] = { std::chrono::steady_clock::now (), timestamp_a, block_hash_a };
+			vban::vote_info info_l{ std::chrono::steady_clock::now (), timestamp_a, block_hash_a };
+			if (last_vote_it != last_votes.end ())
+			{
+				tally_erase (rep, last_vote_it->second);
+				last_vote_it->second = info_l;
+			}
+			else
+			{
+				last_votes.emplace (rep, info_l);
+			}
+			tally_insert (rep, info_l);
 			live_vote_action (rep);
 			if (!confirmed ())
 			{
@@ -445,6 +555,7 @@ size_t vban::election::insert_inactive_votes_cache (vban::inactive_cache_informa
 		auto inserted (last_votes.emplace (rep, vban::vote_info{ std::chrono::steady_clock::time_point::min (), timestamp, cache_a.hash }));
 		if (inserted.second)
 		{
+			tally_insert (rep, inserted.first->second);
 			node.stats.inc (vban::stat::type::election, vban::stat::detail::vote_cached);
 		}
 	}
@@ -517,7 +628,11 @@ void vban::election::remove_votes (vban::block_hash const & hash_a)
 		auto list_generated_votes (node.history.votes (root, hash_a));
 		for (auto const & vote : list_generated_votes)
 		{
-			last_votes.erase (vote->account);
+			if (auto existing = last_votes.find (vote->account); existing != last_votes.end ())
+			{
+				tally_erase (existing->first, existing->second);
+				last_votes.erase (existing);
+			}
 		}
 		// Clear votes cache
 		node.history.erase (root);
@@ -535,6 +650,7 @@ void vban::election::remove_block (vban::block_hash const & hash_a)
 			{
 				if (i->second.hash == hash_a)
 				{
+					tally_erase (i->first, i->second);
 					i = last_votes.erase (i);
 				}
 				else
@@ -118,6 +118,11 @@ public: // Information
 
 private:
 	vban::tally_t tally_impl () const;
+	// Sums are kept up to date as votes and representative weights change, and rebuilt from last_votes when changes were missed
+	void tally_rebuild (uint64_t) const;
+	void tally_refresh (uint64_t) const;
+	void tally_insert (vban::account const &, vban::vote_info const &);
+	void tally_erase (vban::account const &, vban::vote_info const &);
 	// lock_a does not own the mutex on return
 	void confirm_once (vban::unique_lock<vban::mutex> & lock_a, vban::election_status_type = vban::election_status_type::active_confirmed_quorum);
 	void broadcast_block (vban::confirmation_solicitor &);
@@ -134,6 +139,19 @@ private:
 	std::atomic<bool> is_quorum{ false };
 	mutable vban::uint256_t final_weight{ 0 };
 	mutable std::unordered_map<vban::block_hash, vban::uint256_t> last_tally;
+	class block_tally final
+	{
+	public:
+		vban::uint256_fixed weight{ 0 };
+		vban::uint256_fixed final_weight{ 0 };
+		size_t voters{ 0 };
+		size_t final_voters{ 0 };
+	};
+	mutable std::unordered_map<vban::block_hash, block_tally> block_tallies;
+	// Weight each voter contributed to block_tallies
+	mutable std::unordered_map<vban::account, vban::uint256_fixed> voter_weights;
+	mutable uint64_t tally_epoch{ 0 };
+	mutable bool tally_valid{ false };
 
 	vban::election_behavior const behavior{ vban::election_behavior::normal };
 	std::chrono::steady_clock::time_point const election_start = { std::chrono::steady_clock::now () };
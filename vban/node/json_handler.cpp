@@ -956,32 +956,35 @@ void vban::json_handler::accounts_pending ()
 		if (!ec)
 		{
 			boost::property_tree::ptree peers_l;
-			for (auto i (node.store.pending_begin (transaction, vban::pending_key (account, 0))), n (node.store.pending_end ()); i != n && vban::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+			if (!node.ledger.pending_summary_excludes (transaction, account, threshold))
 			{
-				vban::pending_key const & key (i->first);
-				if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+				for (auto i (node.store.pending_begin (transaction, account)), n (node.store.pending_end ()); i != n && vban::pending_key (i->first).account == account && peers_l.size () < count; ++i)
 				{
-					if (simple)
+					vban::pending_key const & key (i->first);
+					if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 					{
-						boost::property_tree::ptree entry;
-						entry.put ("", key.hash.to_string ());
-						peers_l.push_back (std::make_pair ("", entry));
-					}
-					else
-					{
-						vban::pending_info const & info (i->second);
-						if (info.amount.number () >= threshold.number ())
+						if (simple)
 						{
-							if (source)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								pending_tree.put ("source", info.source.to_account ());
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
+							boost::property_tree::ptree entry;
+							entry.put ("", key.hash.to_string ());
+							peers_l.push_back (std::make_pair ("", entry));
+						}
+						else
+						{
+							vban::pending_info const & info (i->second);
+							if (info.amount.number () >= threshold.number ())
 							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
+								if (source)
+								{
+									boost::property_tree::ptree pending_tree;
+									pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+									pending_tree.put ("source", info.source.to_account ());
+									peers_l.add_child (key.hash.to_string (), pending_tree);
+								}
+								else
+								{
+									peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
+								}
 							}
 						}
 					}
@@ -1313,7 +1316,7 @@ void vban::json_handler::block_account ()
 void vban::json_handler::block_count ()
 {
 	response_l.put ("count", std::to_string (node.ledger.cache.block_count));
-	response_l.put ("unchecked", std::to_string (node.store.unchecked_count (node.store.tx_begin_read ())));
+	response_l.put ("unchecked", std::to_string (node.unchecked.count (node.store.tx_begin_read ())));
 	response_l.put ("cemented", std::to_string (node.ledger.cache.cemented_count));
 	if (node.flags.enable_pruning)
 	{
@@ -2021,6 +2024,39 @@ void vban::json_handler::confirmation_quorum ()
 	response_errors ();
 }
 
+void vban::json_handler::database_checkpoint ()
+{
+	uint64_t timeout (5000);
+	boost::optional<std::string> timeout_text (request.get_optional<std::string> ("timeout"));
+	if (timeout_text.is_initialized () && decode_unsigned (timeout_text.get (), timeout))
+	{
+		ec = vban::error_rpc::bad_timeout;
+	}
+	// Bounds how long a request can hold a worker thread
+	timeout = std::min<uint64_t> (timeout, 60 * 1000);
+	if (!ec)
+	{
+		// Waiting for a flush can take a while on slow disks, so it is done off the io threads
+		node.workers.push_task (create_worker_task ([timeout] (std::shared_ptr<vban::json_handler> const & rpc_l) {
+			if (rpc_l->request.get<bool> ("wait", false))
+			{
+				auto timed_out (rpc_l->node.store.checkpoint_wait (std::chrono::milliseconds (timeout)));
+				rpc_l->response_l.put ("timed_out", timed_out ? "1" : "0");
+			}
+			auto checkpoint (rpc_l->node.store.checkpoint_get ());
+			rpc_l->response_l.put ("enabled", checkpoint.enabled ? "1" : "0");
+			rpc_l->response_l.put ("committed", checkpoint.committed);
+			rpc_l->response_l.put ("durable", checkpoint.durable);
+			rpc_l->response_l.put ("time", std::chrono::duration_cast<std::chrono::milliseconds> (checkpoint.time.time_since_epoch ()).count ());
+			rpc_l->response_errors ();
+		}));
+	}
+	else
+	{
+		response_errors ();
+	}
+}
+
 void vban::json_handler::database_txn_tracker ()
 {
 	boost::property_tree::ptree json;
@@ -2068,20 +2104,46 @@ void vban::json_handler::database_txn_tracker ()
 
 void vban::json_handler::delegators ()
 {
-	auto account (account_impl ());
+	auto representative (account_impl ());
+	auto count (count_optional_impl ());
+	// Paging resumes after the last delegator of the previous page
+	auto start_text (request.get_optional<std::string> ("start"));
+	vban::account start (0);
+	if (!ec && start_text.is_initialized ())
+	{
+		start = account_impl (start_text.get ());
+	}
 	if (!ec)
 	{
 		boost::property_tree::ptree delegators;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.accounts_begin (transaction)), n (node.store.accounts_end ()); i != n; ++i)
+		auto add_delegator = [&delegators] (vban::account const & account_a, vban::account_info const & info_a) {
+			std::string balance;
+			vban::uint128_union (info_a.balance).encode_dec (balance);
+			delegators.put (account_a.to_account (), balance);
+		};
+		// The index is used once complete in this snapshot, it is built in the background after enabling it
+		if (node.ledger.delegators_enabled && node.store.delegators_complete (transaction))
+		{
+			for (auto i (node.store.delegators_begin (transaction, vban::delegator_key (representative, start))), n (node.store.delegators_end ()); i != n && i->first.representative == representative && delegators.size () < count; ++i)
+			{
+				vban::account const & account (i->first.account);
+				vban::account_info info;
+				if ((!start_text.is_initialized () || account != start) && !node.store.account_get (transaction, account, info))
+				{
+					add_delegator (account, info);
+				}
+			}
+		}
+		else
 		{
-			vban::account_info const & info (i->second);
-			if (info.representative == account)
+			for (auto i (node.store.accounts_begin (transaction, start)), n (node.store.accounts_end ()); i != n && delegators.size () < count; ++i)
 			{
-				std::string balance;
-				vban::uint128_union (info.balance).encode_dec (balance);
-				vban::account const & account (i->first);
-				delegators.put (account.to_account (), balance);
+				vban::account_info const & info (i->second);
+				if (info.representative == representative && (!start_text.is_initialized () || i->first != start))
+				{
+					add_delegator (i->first, info);
+				}
 			}
 		}
 		response_l.add_child ("delegators", delegators);
@@ -2096,14 +2158,24 @@ void vban::json_handler::delegators_count ()
 	{
 		uint64_t count (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.accounts_begin (transaction)), n (node.store.accounts_end ()); i != n; ++i)
+		if (node.ledger.delegators_enabled && node.store.delegators_complete (transaction))
 		{
-			vban::account_info const & info (i->second);
-			if (info.representative == account)
+			for (auto i (node.store.delegators_begin (transaction, vban::delegator_key (account, vban::account (0)))), n (node.store.delegators_end ()); i != n && i->first.representative == account; ++i)
 			{
 				++count;
 			}
 		}
+		else
+		{
+			for (auto i (node.store.accounts_begin (transaction)), n (node.store.accounts_end ()); i != n; ++i)
+			{
+				vban::account_info const & info (i->second);
+				if (info.representative == account)
+				{
+					++count;
+				}
+			}
+		}
 		response_l.put ("count", std::to_string (count));
 	}
 	response_errors ();
@@ -2497,6 +2569,16 @@ void vban::json_handler::account_history ()
 		bool output_raw (request.get_optional<bool> ("raw") == true);
 		response_l.put ("account", account.to_account ());
 		auto block (node.store.block_get (transaction, hash));
+		auto indexed (node.ledger.account_heights_enabled);
+		if (indexed && block != nullptr && offset > 0)
+		{
+			// Skip straight to the first block of the page instead of walking the offset
+			auto height (block->sideband ().height);
+			auto target (reverse ? height + offset : (height > offset ? height - offset : 0));
+			hash = target != 0 ? node.store.account_height_get (transaction, account, target) : vban::block_hash (0);
+			block = !hash.is_zero () ? node.store.block_get (transaction, hash) : nullptr;
+			offset = 0;
+		}
 		while (block != nullptr && count > 0)
 		{
 			if (offset > 0)
@@ -2522,7 +2604,14 @@ void vban::json_handler::account_history ()
 					--count;
 				}
 			}
-			hash = reverse ? node.store.block_successor (transaction, hash) : block->previous ();
+			if (reverse)
+			{
+				hash = indexed ? node.store.account_height_get (transaction, account, block->sideband ().height + 1) : node.store.block_successor (transaction, hash);
+			}
+			else
+			{
+				hash = block->previous ();
+			}
 			block = node.store.block_get (transaction, hash);
 		}
 		response_l.add_child ("history", history);
@@ -2871,7 +2960,7 @@ void vban::json_handler::pending ()
 		// The ptree container is used if there are any children nodes (e.g source/min_version) otherwise the amount container is used.
 		std::vector<std::pair<std::string, boost::property_tree::ptree>> hash_ptree_pairs;
 		std::vector<std::pair<std::string, vban::uint256_t>> hash_amount_pairs;
-		for (auto i (node.store.pending_begin (transaction, vban::pending_key (account, 0))), n (node.store.pending_end ()); i != n && vban::pending_key (i->first).account == account && (should_sort || peers_l.size () < count); ++i)
+		for (auto i (node.store.pending_begin (transaction, account)), n (node.store.pending_end ()); i != n && vban::pending_key (i->first).account == account && (should_sort || peers_l.size () < count); ++i)
 		{
 			vban::pending_key const & key (i->first);
 			if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
@@ -3936,9 +4025,7 @@ void vban::json_handler::unchecked ()
 	{
 		boost::property_tree::ptree unchecked;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
-			vban::unchecked_info const & info (i->second);
+		node.unchecked.for_each (transaction, vban::unchecked_key{}, [&unchecked, json_block_l, count] (vban::unchecked_key const &, vban::unchecked_info const & info) {
 			if (json_block_l)
 			{
 				boost::property_tree::ptree block_node_l;
@@ -3951,7 +4038,8 @@ void vban::json_handler::unchecked ()
 				info.block->serialize_json (contents);
 				unchecked.put (info.block->hash ().to_string (), contents);
 			}
-		}
+			return unchecked.size () < count;
+		});
 		response_l.add_child ("blocks", unchecked);
 	}
 	response_errors ();
@@ -3961,7 +4049,7 @@ void vban::json_handler::unchecked_clear ()
 {
 	node.workers.push_task (create_worker_task ([] (std::shared_ptr<vban::json_handler> const & rpc_l) {
 		auto transaction (rpc_l->node.store.tx_begin_write ({ tables::unchecked }));
-		rpc_l->node.store.unchecked_clear (transaction);
+		rpc_l->node.unchecked.clear (transaction);
 		rpc_l->response_l.put ("success", "");
 		rpc_l->response_errors ();
 	}));
@@ -3974,12 +4062,10 @@ void vban::json_handler::unchecked_get ()
 	if (!ec)
 	{
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n; ++i)
-		{
-			vban::unchecked_key const & key (i->first);
-			if (key.hash == hash)
+		node.unchecked.for_each (transaction, vban::unchecked_key{}, [this, &hash, json_block_l] (vban::unchecked_key const & key, vban::unchecked_info const & info) {
+			auto found (key.hash == hash);
+			if (found)
 			{
-				vban::unchecked_info const & info (i->second);
 				response_l.put ("modified_timestamp", std::to_string (info.modified));
 
 				if (json_block_l)
@@ -3994,9 +4080,9 @@ void vban::json_handler::unchecked_get ()
 					info.block->serialize_json (contents);
 					response_l.put ("contents", contents);
 				}
-				break;
 			}
-		}
+			return !found;
+		});
 		if (response_l.empty ())
 		{
 			ec = vban::error_blocks::not_found;
@@ -4022,11 +4108,9 @@ void vban::json_handler::unchecked_keys ()
 	{
 		boost::property_tree::ptree unchecked;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction, vban::unchecked_key (key, 0))), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
+		node.unchecked.for_each (transaction, vban::unchecked_key (key, 0), [&unchecked, json_block_l, count] (vban::unchecked_key const & unchecked_key, vban::unchecked_info const & info) {
 			boost::property_tree::ptree entry;
-			vban::unchecked_info const & info (i->second);
-			entry.put ("key", i->first.key ().to_string ());
+			entry.put ("key", unchecked_key.key ().to_string ());
 			entry.put ("hash", info.block->hash ().to_string ());
 			entry.put ("modified_timestamp", std::to_string (info.modified));
 			if (json_block_l)
@@ -4042,7 +4126,8 @@ void vban::json_handler::unchecked_keys ()
 				entry.put ("contents", contents);
 			}
 			unchecked.push_back (std::make_pair ("", entry));
-		}
+			return unchecked.size () < count;
+		});
 		response_l.add_child ("unchecked", unchecked);
 	}
 	response_errors ();
@@ -4574,39 +4659,42 @@ void vban::json_handler::wallet_pending ()
 		{
 			vban::account const & account (i->first);
 			boost::property_tree::ptree peers_l;
-			for (auto ii (node.store.pending_begin (block_transaction, vban::pending_key (account, 0))), nn (node.store.pending_end ()); ii != nn && vban::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
+			if (!node.ledger.pending_summary_excludes (block_transaction, account, threshold))
 			{
-				vban::pending_key key (ii->first);
-				if (block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
+				for (auto ii (node.store.pending_begin (block_transaction, account)), nn (node.store.pending_end ()); ii != nn && vban::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
 				{
-					if (threshold.is_zero () && !source)
-					{
-						boost::property_tree::ptree entry;
-						entry.put ("", key.hash.to_string ());
-						peers_l.push_back (std::make_pair ("", entry));
-					}
-					else
+					vban::pending_key key (ii->first);
+					if (block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
 					{
-						vban::pending_info info (ii->second);
-						if (info.amount.number () >= threshold.number ())
+						if (threshold.is_zero () && !source)
+						{
+							boost::property_tree::ptree entry;
+							entry.put ("", key.hash.to_string ());
+							peers_l.push_back (std::make_pair ("", entry));
+						}
+						else
 						{
-							if (source || min_version)
+							vban::pending_info info (ii->second);
+							if (info.amount.number () >= threshold.number ())
 							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								if (source)
+								if (source || min_version)
 								{
-									pending_tree.put ("source", info.source.to_account ());
+									boost::property_tree::ptree pending_tree;
+									pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+									if (source)
+									{
+										pending_tree.put ("source", info.source.to_account ());
+									}
+									if (min_version)
+									{
+										pending_tree.put ("min_version", epoch_as_string (info.epoch));
+									}
+									peers_l.add_child (key.hash.to_string (), pending_tree);
 								}
-								if (min_version)
+								else
 								{
-									pending_tree.put ("min_version", epoch_as_string (info.epoch));
+									peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 								}
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 							}
 						}
 					}
@@ -5095,6 +5183,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("confirmation_history", &vban::json_handler::confirmation_history);
 	no_arg_funcs.emplace ("confirmation_info", &vban::json_handler::confirmation_info);
 	no_arg_funcs.emplace ("confirmation_quorum", &vban::json_handler::confirmation_quorum);
+	no_arg_funcs.emplace ("database_checkpoint", &vban::json_handler::database_checkpoint);
 	no_arg_funcs.emplace ("database_txn_tracker", &vban::json_handler::database_txn_tracker);
 	no_arg_funcs.emplace ("delegators", &vban::json_handler::delegators);
 	no_arg_funcs.emplace ("delegators_count", &vban::json_handler::delegators_count);
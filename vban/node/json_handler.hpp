@@ -63,6 +63,7 @@ public:
 	void confirmation_info ();
 	void confirmation_quorum ();
 	void confirmation_height_currently_processing ();
+	void database_checkpoint ();
 	void database_txn_tracker ();
 	void delegators ();
 	void delegators_count ();
@@ -87,6 +87,11 @@ vban::mdb_store::mdb_store (vban::logger_mt & logger_a, boost::filesystem::path
 					error |= do_upgrades (transaction, needs_vacuuming);
 				}
 			}
+			// Commits are only counted by the checkpoint once it runs, so the upgrade is made durable here
+			if (lmdb_config_a.sync == vban::lmdb_config::sync_strategy::checkpoint)
+			{
+				mdb_env_sync (env.environment, 1);
+			}
 
 			if (needs_vacuuming && !network_constants.is_dev_network ())
 			{
@@ -100,6 +105,15 @@ vban::mdb_store::mdb_store (vban::logger_mt & logger_a, boost::filesystem::path
 			auto transaction (tx_begin_read ());
 			open_databases (error, transaction, 0);
 		}
+		if (!error)
+		{
+			auto transaction (tx_begin_read ());
+			representatives_load (transaction);
+		}
+		if (lmdb_config_a.sync == vban::lmdb_config::sync_strategy::checkpoint)
+		{
+			checkpoint = std::make_unique<vban::mdb_checkpoint> (env, lmdb_config_a.checkpoint_interval, lmdb_config_a.checkpoint_bytes);
+		}
 	}
 }
 
@@ -183,9 +197,25 @@ vban::mdb_txn_callbacks vban::mdb_store::create_txn_callbacks () const
 			mdb_txn_tracker.erase (transaction_impl);
 		});
 	}
+	if (checkpoint != nullptr)
+	{
+		mdb_txn_callbacks.txn_committed = ([&checkpoint = *checkpoint] () {
+			checkpoint.committed ();
+		});
+	}
 	return mdb_txn_callbacks;
 }
 
+vban::store_checkpoint vban::mdb_store::checkpoint_get ()
+{
+	return checkpoint != nullptr ? checkpoint->get () : vban::store_checkpoint{};
+}
+
+bool vban::mdb_store::checkpoint_wait (std::chrono::milliseconds timeout_a)
+{
+	return checkpoint != nullptr && checkpoint->wait (timeout_a);
+}
+
 void vban::mdb_store::open_databases (bool & error_a, vban::transaction const & transaction_a, unsigned flags)
 {
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "frontiers", flags, &frontiers) != 0;
@@ -200,6 +230,10 @@ void vban::mdb_store::open_databases (bool & error_a, vban::transaction const &
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending", flags, &pending_v0) != 0;
 	pending = pending_v0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "final_votes", flags, &final_votes) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "account_heights", flags, &account_heights) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "delegators", flags, &delegators) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending_summary", flags, &pending_summary) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "representatives", flags, &representatives) != 0;
 
 	auto version_l = version_get (transaction_a);
 	if (version_l < 19)
@@ -284,6 +318,19 @@ bool vban::mdb_store::do_upgrades (vban::write_transaction & transaction_a, bool
 			upgrade_v20_to_v21 (transaction_a);
 			[[fallthrough]];
 		case 21:
+			upgrade_v21_to_v22 (transaction_a);
+			[[fallthrough]];
+		case 22:
+			upgrade_v22_to_v23 (transaction_a);
+			[[fallthrough]];
+		case 23:
+			upgrade_v23_to_v24 (transaction_a);
+			[[fallthrough]];
+		case 24:
+			upgrade_v24_to_v25 (transaction_a);
+			needs_vacuuming = true;
+			[[fallthrough]];
+		case 25:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -757,6 +804,64 @@ void vban::mdb_store::upgrade_v20_to_v21 (vban::write_transaction const & transa
 	logger.always_log ("Finished creating new final_vote table");
 }
 
+void vban::mdb_store::upgrade_v21_to_v22 (vban::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v21 to v22 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "account_heights", MDB_CREATE, &account_heights);
+	version_put (transaction_a, 22);
+	logger.always_log ("Finished creating new account_heights table");
+}
+
+void vban::mdb_store::upgrade_v22_to_v23 (vban::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v22 to v23 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "delegators", MDB_CREATE, &delegators);
+	version_put (transaction_a, 23);
+	logger.always_log ("Finished creating new delegators table");
+}
+
+void vban::mdb_store::upgrade_v23_to_v24 (vban::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v23 to v24 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "pending_summary", MDB_CREATE, &pending_summary);
+	version_put (transaction_a, 24);
+	logger.always_log ("Finished creating new pending_summary table");
+}
+
+void vban::mdb_store::upgrade_v24_to_v25 (vban::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v24 to v25 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "representatives", MDB_CREATE, &representatives);
+	representative_ids.clear ();
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), blocks, &cursor));
+	release_assert (status == MDB_SUCCESS);
+	uint64_t count_l (0);
+	std::vector<uint8_t> data;
+	std::vector<uint8_t> compact;
+	vban::mdb_val key;
+	vban::mdb_val value;
+	for (status = mdb_cursor_get (cursor, &key.value, &value.value, MDB_FIRST); status == MDB_SUCCESS; status = mdb_cursor_get (cursor, &key.value, &value.value, MDB_NEXT))
+	{
+		// Copied out as the entry is overwritten in place
+		data.assign (static_cast<uint8_t *> (value.data ()), static_cast<uint8_t *> (value.data ()) + value.size ());
+		if (block_entry_compact (transaction_a, data, compact))
+		{
+			vban::mdb_val compact_value (compact.size (), compact.data ());
+			auto status_put (mdb_cursor_put (cursor, &key.value, &compact_value.value, MDB_CURRENT));
+			release_assert (status_put == MDB_SUCCESS);
+			if (++count_l % 1000000 == 0)
+			{
+				logger.always_log (boost::str (boost::format ("%1% state blocks compacted") % count_l));
+			}
+		}
+	}
+	release_assert (status == MDB_NOTFOUND);
+	mdb_cursor_close (cursor);
+	version_put (transaction_a, 25);
+	logger.always_log (boost::str (boost::format ("Finished compacting %1% state blocks with %2% representatives") % count_l % representative_ids.next ()));
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void vban::mdb_store::create_backup_file (vban::mdb_env & env_a, boost::filesystem::path const & filepath_a, vban::logger_mt & logger_a)
 {
@@ -822,11 +927,19 @@ int vban::mdb_store::get (vban::transaction const & transaction_a, tables table_
 
 int vban::mdb_store::put (vban::write_transaction const & transaction_a, tables table_a, vban::mdb_val const & key_a, const vban::mdb_val & value_a) const
 {
+	if (checkpoint != nullptr)
+	{
+		checkpoint->written (key_a.size () + value_a.size ());
+	}
 	return (mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0));
 }
 
 int vban::mdb_store::del (vban::write_transaction const & transaction_a, tables table_a, vban::mdb_val const & key_a) const
 {
+	if (checkpoint != nullptr)
+	{
+		checkpoint->written (key_a.size ());
+	}
 	return (mdb_del (env.tx (transaction_a), table_to_dbi (table_a), key_a, nullptr));
 }
 
@@ -879,6 +992,14 @@ MDB_dbi vban::mdb_store::table_to_dbi (tables table_a) const
 			return confirmation_height;
 		case tables::final_votes:
 			return final_votes;
+		case tables::account_heights:
+			return account_heights;
+		case tables::delegators:
+			return delegators;
+		case tables::pending_summary:
+			return pending_summary;
+		case tables::representatives:
+			return representatives;
 		default:
 			release_assert (false);
 			return peers;
@@ -4,6 +4,7 @@
 #include <vban/lib/lmdbconfig.hpp>
 #include <vban/lib/logger_mt.hpp>
 #include <vban/lib/numbers.hpp>
+#include <vban/node/lmdb/lmdb_checkpoint.hpp>
 #include <vban/node/lmdb/lmdb_env.hpp>
 #include <vban/node/lmdb/lmdb_iterator.hpp>
 #include <vban/node/lmdb/lmdb_txn.hpp>
@@ -47,6 +48,9 @@ public:
 
 	void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds) override;
 
+	vban::store_checkpoint checkpoint_get () override;
+	bool checkpoint_wait (std::chrono::milliseconds) override;
+
 	static void create_backup_file (vban::mdb_env &, boost::filesystem::path const &, vban::logger_mt &);
 
 	void serialize_memory_stats (boost::property_tree::ptree &) override;
@@ -198,6 +202,30 @@ public:
 	 */
 	MDB_dbi final_votes{ 0 };
 
+	/**
+	 * Blocks of each account by height, optional index used for paging account history.
+	 * vban::account_height_key -> vban::block_hash
+	 */
+	MDB_dbi account_heights{ 0 };
+
+	/**
+	 * Accounts delegating to each representative, optional index used by the delegators RPCs.
+	 * vban::delegator_key -> none
+	 */
+	MDB_dbi delegators{ 0 };
+
+	/**
+	 * Number, total and range of the amounts pending for each account, optional index used to skip pending lookups.
+	 * vban::account -> vban::pending_summary
+	 */
+	MDB_dbi pending_summary{ 0 };
+
+	/**
+	 * Representatives of the state blocks stored in the compact format, by dictionary id.
+	 * uint64_t -> vban::account
+	 */
+	MDB_dbi representatives{ 0 };
+
 	bool exists (vban::transaction const & transaction_a, tables table_a, vban::mdb_val const & key_a) const;
 	std::vector<vban::unchecked_info> unchecked_get (vban::transaction const & transaction_a, vban::block_hash const & hash_a) override;
 
@@ -211,13 +239,20 @@ public:
 	template <typename Key, typename Value>
 	vban::store_iterator<Key, Value> make_iterator (vban::transaction const & transaction_a, tables table_a, bool const direction_asc) const
 	{
-		return vban::store_iterator<Key, Value> (std::make_unique<vban::mdb_iterator<Key, Value>> (transaction_a, table_to_dbi (table_a), vban::mdb_val{}, direction_asc));
+		return vban::store_iterator<Key, Value> (std::make_unique<vban::mdb_iterator<Key, Value>> (transaction_a, table_to_dbi (table_a), vban::mdb_val{}, direction_asc, block_dictionary (table_a)));
 	}
 
 	template <typename Key, typename Value>
 	vban::store_iterator<Key, Value> make_iterator (vban::transaction const & transaction_a, tables table_a, vban::mdb_val const & key) const
 	{
-		return vban::store_iterator<Key, Value> (std::make_unique<vban::mdb_iterator<Key, Value>> (transaction_a, table_to_dbi (table_a), key));
+		return vban::store_iterator<Key, Value> (std::make_unique<vban::mdb_iterator<Key, Value>> (transaction_a, table_to_dbi (table_a), key, true, block_dictionary (table_a)));
+	}
+
+	/** Prefix filters are not used by LMDB, the iterator continues past the prefix */
+	template <typename Key, typename Value>
+	vban::store_iterator<Key, Value> make_prefix_iterator (vban::transaction const & transaction_a, tables table_a, vban::mdb_val const & key) const
+	{
+		return make_iterator<Key, Value> (transaction_a, table_a, key);
 	}
 
 	bool init_error () const override;
@@ -241,6 +276,10 @@ private:
 	void upgrade_v18_to_v19 (vban::write_transaction const &);
 	void upgrade_v19_to_v20 (vban::write_transaction const &);
 	void upgrade_v20_to_v21 (vban::write_transaction const &);
+	void upgrade_v21_to_v22 (vban::write_transaction const &);
+	void upgrade_v22_to_v23 (vban::write_transaction const &);
+	void upgrade_v23_to_v24 (vban::write_transaction const &);
+	void upgrade_v24_to_v25 (vban::write_transaction const &);
 
 	std::shared_ptr<vban::block> block_get_v18 (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const;
 	vban::mdb_val block_raw_get_v18 (vban::transaction const & transaction_a, vban::block_hash const & hash_a, vban::block_type & type_a) const;
@@ -266,6 +305,9 @@ private:
 
 	bool vacuum_after_upgrade (boost::filesystem::path const & path_a, vban::lmdb_config const & lmdb_config_a);
 
+	/** Background flushing with the checkpoint sync strategy, destroyed before the environment */
+	std::unique_ptr<vban::mdb_checkpoint> checkpoint;
+
 	class upgrade_counters
 	{
 	public:
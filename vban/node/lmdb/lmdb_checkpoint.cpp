@@ -0,0 +1,108 @@
+#include <vban/lib/threading.hpp>
+#include <vban/node/lmdb/lmdb_checkpoint.hpp>
+#include <vban/node/lmdb/lmdb_env.hpp>
+
+vban::mdb_checkpoint::mdb_checkpoint (vban::mdb_env & env_a, std::chrono::milliseconds interval_a, size_t bytes_a) :
+	env (env_a),
+	interval (interval_a),
+	bytes (bytes_a),
+	thread ([this] () {
+		vban::thread_role::set (vban::thread_role::name::db_checkpoint);
+		run ();
+	})
+{
+}
+
+vban::mdb_checkpoint::~mdb_checkpoint ()
+{
+	stop ();
+}
+
+void vban::mdb_checkpoint::stop ()
+{
+	{
+		vban::lock_guard<vban::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+	// The environment is opened with MDB_NOSYNC, closing it does not flush the commits made since the last checkpoint
+	vban::lock_guard<vban::mutex> guard (mutex);
+	uint64_t sequence (committed_m);
+	if (sequence != durable)
+	{
+		auto status (mdb_env_sync (env, 1));
+		release_assert (status == MDB_SUCCESS, mdb_strerror (status));
+		durable = sequence;
+		time = std::chrono::system_clock::now ();
+		condition.notify_all ();
+	}
+}
+
+void vban::mdb_checkpoint::written (size_t bytes_a)
+{
+	written_m += bytes_a;
+}
+
+void vban::mdb_checkpoint::committed ()
+{
+	++committed_m;
+	if (written_m >= bytes)
+	{
+		{
+			vban::lock_guard<vban::mutex> guard (mutex);
+			requested = true;
+		}
+		condition.notify_all ();
+	}
+}
+
+vban::store_checkpoint vban::mdb_checkpoint::get ()
+{
+	vban::store_checkpoint result;
+	result.enabled = true;
+	result.committed = committed_m;
+	vban::lock_guard<vban::mutex> guard (mutex);
+	result.durable = durable;
+	result.time = time;
+	return result;
+}
+
+bool vban::mdb_checkpoint::wait (std::chrono::milliseconds timeout_a)
+{
+	uint64_t target (committed_m);
+	vban::unique_lock<vban::mutex> lk (mutex);
+	if (durable < target)
+	{
+		requested = true;
+		condition.notify_all ();
+		condition.wait_for (lk, timeout_a, [this, target] () { return stopped || durable >= target; });
+	}
+	return durable < target;
+}
+
+void vban::mdb_checkpoint::run ()
+{
+	vban::unique_lock<vban::mutex> lk (mutex);
+	while (!stopped)
+	{
+		condition.wait_for (lk, interval, [this] () { return stopped || requested; });
+		requested = false;
+		uint64_t sequence (committed_m);
+		if (!stopped && sequence != durable)
+		{
+			// Commits counted before the sync are fully written to the environment, so all of them become durable
+			written_m = 0;
+			lk.unlock ();
+			auto status (mdb_env_sync (env, 1));
+			release_assert (status == MDB_SUCCESS, mdb_strerror (status));
+			lk.lock ();
+			durable = sequence;
+			time = std::chrono::system_clock::now ();
+			condition.notify_all ();
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vban/lib/locks.hpp>
+#include <vban/secure/blockstore.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace vban
+{
+class mdb_env;
+
+/**
+ * Flushes an environment opened with MDB_NOSYNC from a background thread, every interval or once enough bytes have been written.
+ * Each flush makes durable all the commits observed before it started, so commits no longer wait on fsync.
+ */
+class mdb_checkpoint final
+{
+public:
+	mdb_checkpoint (vban::mdb_env &, std::chrono::milliseconds interval_a, size_t bytes_a);
+	~mdb_checkpoint ();
+	/** Stops the background thread and flushes the commits it has not made durable yet */
+	void stop ();
+	/** Accounts for bytes written by a write transaction which has not committed yet */
+	void written (size_t bytes_a);
+	/** Called after each write transaction commit */
+	void committed ();
+	vban::store_checkpoint get ();
+	/** Requests a flush and waits until every commit made before the call is durable, returns true on timeout */
+	bool wait (std::chrono::milliseconds timeout_a);
+
+private:
+	void run ();
+
+	vban::mdb_env & env;
+	std::chrono::milliseconds const interval;
+	size_t const bytes;
+	std::atomic<uint64_t> committed_m{ 0 };
+	/** Bytes written since the last flush started */
+	std::atomic<size_t> written_m{ 0 };
+	uint64_t durable{ 0 };
+	std::chrono::system_clock::time_point time;
+	bool requested{ false };
+	bool stopped{ false };
+	vban::condition_variable condition;
+	vban::mutex mutex{ mutex_identifier (mutexes::mdb_checkpoint) };
+	std::thread thread;
+};
+}
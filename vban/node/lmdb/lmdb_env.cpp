@@ -38,7 +38,7 @@ void vban::mdb_env::init (bool & error_a, boost::filesystem::path const & path_a
 			{
 				environment_flags |= MDB_NOMETASYNC;
 			}
-			else if (options_a.config.sync == vban::lmdb_config::sync_strategy::nosync_unsafe)
+			else if (options_a.config.sync == vban::lmdb_config::sync_strategy::nosync_unsafe || options_a.config.sync == vban::lmdb_config::sync_strategy::checkpoint)
 			{
 				environment_flags |= MDB_NOSYNC;
 			}
@@ -10,7 +10,9 @@ template <typename T, typename U>
 class mdb_iterator : public store_iterator_impl<T, U>
 {
 public:
-	mdb_iterator (vban::transaction const & transaction_a, MDB_dbi db_a, MDB_val const & val_a = MDB_val{}, bool const direction_asc = true)
+	/** Values are decoded with \p dictionary_a when it is set, which is only the case for the blocks table */
+	mdb_iterator (vban::transaction const & transaction_a, MDB_dbi db_a, MDB_val const & val_a = MDB_val{}, bool const direction_asc = true, vban::representative_dictionary const * dictionary_a = nullptr) :
+		dictionary (dictionary_a)
 	{
 		auto status (mdb_cursor_open (tx (transaction_a), db_a, &cursor));
 		release_assert (status == 0);
@@ -47,6 +49,7 @@ public:
 		cursor = other_a.cursor;
 		other_a.cursor = nullptr;
 		current = other_a.current;
+		dictionary = other_a.dictionary;
 	}
 
 	mdb_iterator (vban::mdb_iterator<T, U> const &) = delete;
@@ -120,7 +123,11 @@ public:
 		{
 			value_a.first = T ();
 		}
-		if (current.second.size () != 0)
+		if (current.second.size () != 0 && dictionary != nullptr)
+		{
+			value_a.second = vban::block_entry_converter<U>::convert (current.second, *dictionary);
+		}
+		else if (current.second.size () != 0)
 		{
 			value_a.second = static_cast<U> (current.second);
 		}
@@ -145,6 +152,7 @@ public:
 		cursor = other_a.cursor;
 		other_a.cursor = nullptr;
 		current = other_a.current;
+		dictionary = other_a.dictionary;
 		other_a.clear ();
 		return *this;
 	}
@@ -154,6 +162,8 @@ public:
 	std::pair<vban::db_val<MDB_val>, vban::db_val<MDB_val>> current;
 
 private:
+	vban::representative_dictionary const * dictionary{ nullptr };
+
 	MDB_txn * tx (vban::transaction const & transaction_a) const
 	{
 		return static_cast<MDB_txn *> (transaction_a.get_handle ());
@@ -102,6 +102,7 @@ void vban::write_mdb_txn::commit ()
 		auto status (mdb_txn_commit (handle));
 		release_assert (status == MDB_SUCCESS, mdb_strerror (status));
 		txn_callbacks.txn_end (this);
+		txn_callbacks.txn_committed ();
 		active = false;
 	}
 }
@@ -22,6 +22,8 @@ class mdb_txn_callbacks
 public:
 	std::function<void (const vban::transaction_impl *)> txn_start{ [] (const vban::transaction_impl *) {} };
 	std::function<void (const vban::transaction_impl *)> txn_end{ [] (const vban::transaction_impl *) {} };
+	/** Called once a write transaction has been committed successfully */
+	std::function<void ()> txn_committed{ [] () {} };
 };
 
 class read_mdb_txn final : public read_transaction_impl
@@ -405,7 +405,7 @@ public:
 			node.logger.try_log (boost::str (boost::format ("Publish message from %1% for %2%") % channel->to_string () % message_a.block->hash ().to_string ()));
 		}
 		node.stats.inc (vban::stat::type::message, vban::stat::detail::publish, vban::stat::dir::in);
-		if (!node.block_processor.full ())
+		if (!node.block_processor.full (vban::block_source::live))
 		{
 			node.process_active (message_a.block);
 		}
@@ -458,7 +458,7 @@ public:
 					if (!vote_block.which ())
 					{
 						auto const & block (boost::get<std::shared_ptr<vban::block>> (vote_block));
-						if (!node.block_processor.full ())
+						if (!node.block_processor.full (vban::block_source::live))
 						{
 							node.process_active (block);
 						}
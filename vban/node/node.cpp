@@ -85,7 +85,7 @@ vban::node::node (boost::asio::io_context & io_ctx_a, uint16_t peering_port_a, b
 }
 
 vban::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path const & application_path_a, vban::node_config const & config_a, vban::work_pool & work_a, vban::node_flags flags_a, unsigned seq) :
-	write_database_queue (!flags_a.force_use_write_database_queue && (config_a.rocksdb_config.enable || vban::using_rocksdb_in_tests ())),
+	write_database_queue (!flags_a.force_use_write_database_queue && (config_a.rocksdb_config.enable || vban::using_rocksdb_in_tests ()), config_a.write_group_commit),
 	io_ctx (io_ctx_a),
 	node_initialized_latch (1),
 	config (config_a),
@@ -101,7 +101,9 @@ vban::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 	wallets_store (*wallets_store_impl),
 	gap_cache (*this),
 	ledger (store, stats, flags_a.generate_cache),
-	checker (config.signature_checker_threads),
+	unchecked (store, config.unchecked_memory_mb * 1024 * 1024),
+	signature_cache (config.signature_cache_size, stats),
+	checker (config.signature_checker_threads, &signature_cache, &representative_keys),
 	network (*this, config.peering_port),
 	telemetry (std::make_shared<vban::telemetry> (network, workers, observers.telemetry, stats, network_params, flags.disable_ongoing_telemetry_requests)),
 	bootstrap_initiator (*this),
@@ -129,6 +131,9 @@ vban::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 
 		active.vacancy_update = [this] () { scheduler.notify (); };
 
+		store.account_cache_memory_set (config.account_cache_memory_mb * 1024 * 1024);
+		store.block_cache_size_set (config.block_cache_size);
+
 		if (config.websocket_config.enabled)
 		{
 			auto endpoint_l (vban::tcp_endpoint (boost::asio::ip::make_address_v6 (config.websocket_config.address), config.websocket_config.port));
@@ -347,11 +352,95 @@ vban::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 		vban::genesis genesis;
 		if (!is_initialized && !flags.read_only)
 		{
-			auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers }));
+			auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers, tables::representatives }));
 			// Store was empty meaning we just created it, add the genesis block
 			store.initialize (transaction, genesis, ledger.cache);
 		}
 
+		if (ledger.cache_snapshot_loaded)
+		{
+			logger.always_log ("Ledger cache restored from snapshot");
+		}
+		if (!flags.read_only)
+		{
+			// The snapshot is only valid until the ledger is modified, a new one is written on clean shutdown
+			auto transaction (store.tx_begin_write ({ tables::meta }));
+			store.cache_snapshot_del (transaction);
+		}
+
+		auto account_heights_complete (store.account_heights_complete (store.tx_begin_read ()));
+		if (config.account_history_index && !account_heights_complete)
+		{
+			if (!is_initialized && !flags.read_only)
+			{
+				// Only the genesis block needs indexing
+				ledger.account_heights_rebuild ();
+				account_heights_complete = true;
+			}
+			else
+			{
+				logger.always_log ("Account history index is enabled but incomplete, it is not used until built with --rebuild_account_history_index");
+			}
+		}
+		else if (!config.account_history_index && account_heights_complete && !flags.read_only && !flags.inactive_node)
+		{
+			// The index stops being maintained, so it can no longer be trusted
+			auto transaction (store.tx_begin_write ({ tables::account_heights, tables::meta }));
+			store.account_heights_complete_set (transaction, false);
+			store.account_heights_clear (transaction);
+			account_heights_complete = false;
+		}
+		ledger.account_heights_enabled = config.account_history_index && account_heights_complete;
+
+		auto delegators_complete (store.delegators_complete (store.tx_begin_read ()));
+		auto delegators_maintained (delegators_complete);
+		if (config.delegators_index && !delegators_complete)
+		{
+			if (!flags.read_only && !flags.inactive_node)
+			{
+				// Maintained from now on and built in the background once the node starts, RPCs only use it once it is complete
+				delegators_maintained = true;
+			}
+			else
+			{
+				logger.always_log ("Delegators index is enabled but incomplete, it is built on the next start of the node");
+			}
+		}
+		else if (!config.delegators_index && delegators_complete && !flags.read_only && !flags.inactive_node)
+		{
+			// The index stops being maintained, so it can no longer be trusted
+			auto transaction (store.tx_begin_write ({ tables::delegators, tables::meta }));
+			store.delegators_complete_set (transaction, false);
+			store.delegators_clear (transaction);
+			delegators_maintained = false;
+		}
+		ledger.delegators_enabled = config.delegators_index && delegators_maintained;
+
+		auto pending_summary_complete (store.pending_summary_complete (store.tx_begin_read ()));
+		if (config.pending_summary_index && !pending_summary_complete)
+		{
+			if (!flags.read_only && !flags.inactive_node)
+			{
+				logger.always_log ("Building pending summary index...");
+				auto entries (ledger.pending_summary_rebuild ());
+				logger.always_log (boost::str (boost::format ("Pending summary index built with %1% accounts") % entries));
+				pending_summary_complete = true;
+			}
+			else
+			{
+				logger.always_log ("Pending summary index is enabled but incomplete, it is built on the next start of the node");
+			}
+		}
+		else if (!config.pending_summary_index && pending_summary_complete && !flags.read_only && !flags.inactive_node)
+		{
+			// The index stops being maintained, so it can no longer be trusted
+			auto transaction (store.tx_begin_write ({ tables::meta, tables::pending_summary }));
+			store.pending_summary_complete_set (transaction, false);
+			store.pending_summary_clear (transaction);
+			pending_summary_complete = false;
+		}
+		ledger.pending_summary_enabled = config.pending_summary_index && pending_summary_complete;
+
 		if (!ledger.block_or_pruned_exists (genesis.hash ()))
 		{
 			std::stringstream ss;
@@ -406,7 +495,7 @@ vban::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 			if (!flags.disable_unchecked_drop && !use_bootstrap_weight && !flags.read_only)
 			{
 				auto transaction (store.tx_begin_write ({ tables::unchecked }));
-				store.unchecked_clear (transaction);
+				unchecked.clear (transaction);
 				logger.always_log ("Dropping unchecked blocks");
 			}
 		}
@@ -441,6 +530,12 @@ vban::node::~node ()
 		logger.always_log ("Destructing node");
 	}
 	stop ();
+	if (!flags.read_only && !flags.inactive_node && !store.init_error ())
+	{
+		// Block processing and cementing have finished, so the ledger cache is final. CLI commands may edit tables directly and never leave a snapshot
+		auto transaction (store.tx_begin_write ({ tables::meta }));
+		ledger.cache_snapshot_write (transaction);
+	}
 }
 
 void vban::node::do_rpc_callback (boost::asio::ip::tcp::resolver::iterator i_a, std::string const & address, uint16_t port, std::shared_ptr<std::string> const & target, std::shared_ptr<std::string> const & body, std::shared_ptr<boost::asio::ip::tcp::resolver> const & resolver)
@@ -526,6 +621,7 @@ std::unique_ptr<vban::container_info_component> vban::collect_container_info (no
 	composite->add_component (collect_container_info (node.work, "work"));
 	composite->add_component (collect_container_info (node.gap_cache, "gap_cache"));
 	composite->add_component (collect_container_info (node.ledger, "ledger"));
+	composite->add_component (node.store.collect_cache_info ("store_cache"));
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (collect_container_info (node.bootstrap_initiator, "bootstrap_initiator"));
 	composite->add_component (collect_container_info (node.bootstrap, "bootstrap"));
@@ -538,8 +634,11 @@ std::unique_ptr<vban::container_info_component> vban::collect_container_info (no
 	composite->add_component (collect_container_info (node.observers, "observers"));
 	composite->add_component (collect_container_info (node.wallets, "wallets"));
 	composite->add_component (collect_container_info (node.vote_processor, "vote_processor"));
+	composite->add_component (collect_container_info (node.signature_cache, "signature_cache"));
+	composite->add_component (collect_container_info (node.representative_keys, "representative_keys"));
 	composite->add_component (collect_container_info (node.rep_crawler, "rep_crawler"));
 	composite->add_component (collect_container_info (node.block_processor, "block_processor"));
+	composite->add_component (collect_container_info (node.unchecked, "unchecked"));
 	composite->add_component (collect_container_info (node.block_arrival, "block_arrival"));
 	composite->add_component (collect_container_info (node.online_reps, "online_reps"));
 	composite->add_component (collect_container_info (node.history, "history"));
@@ -559,7 +658,7 @@ void vban::node::process_active (std::shared_ptr<vban::block> const & incoming)
 
 vban::process_return vban::node::process (vban::block & block_a)
 {
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
+	auto transaction (store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending, tables::pending_summary, tables::representatives }));
 	auto result (ledger.process (transaction, block_a));
 	return result;
 }
@@ -574,7 +673,7 @@ vban::process_return vban::node::process_local (std::shared_ptr<vban::block> con
 	block_processor.wait_write ();
 	// Process block
 	block_post_events post_events ([&store = store] { return store.tx_begin_read (); });
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
+	auto transaction (store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending, tables::pending_summary, tables::representatives }));
 	return block_processor.process_one (transaction, post_events, info, false, vban::block_origin::local);
 }
 
@@ -590,6 +689,23 @@ void vban::node::process_local_async (std::shared_ptr<vban::block> const & block
 void vban::node::start ()
 {
 	long_inactivity_cleanup ();
+	if (ledger.delegators_enabled && !store.delegators_complete (store.tx_begin_read ()))
+	{
+		auto this_l (shared ());
+		workers.push_task ([this_l] () {
+			this_l->logger.always_log ("Building delegators index...");
+			auto entries (this_l->ledger.delegators_rebuild ());
+			this_l->logger.always_log (boost::str (boost::format ("Delegators index built with %1% entries") % entries));
+		});
+	}
+	if (config.block_filter_bits != 0)
+	{
+		// Only running nodes look up unknown blocks often enough to need it. Blocks written while it fills are recorded, so it is built off the startup path
+		auto this_l (shared ());
+		workers.push_task ([this_l] () {
+			this_l->store.block_filter_build (this_l->config.block_filter_bits, this_l->stopped);
+		});
+	}
 	network.start ();
 	add_initial_peers ();
 	if (!flags.disable_legacy_bootstrap && !flags.disable_ongoing_bootstrap)
@@ -921,16 +1037,14 @@ void vban::node::unchecked_cleanup ()
 		auto now (vban::seconds_since_epoch ());
 		auto transaction (store.tx_begin_read ());
 		// Max 1M records to clean, max 2 minutes reading to prevent slow i/o systems issues
-		for (auto i (store.unchecked_begin (transaction)), n (store.unchecked_end ()); i != n && cleaning_list.size () < 1024 * 1024 && vban::seconds_since_epoch () - now < 120; ++i)
-		{
-			vban::unchecked_key const & key (i->first);
-			vban::unchecked_info const & info (i->second);
+		unchecked.for_each (transaction, vban::unchecked_key{}, [this, now, &digests, &cleaning_list] (vban::unchecked_key const & key, vban::unchecked_info const & info) {
 			if ((now - info.modified) > static_cast<uint64_t> (config.unchecked_cutoff_time.count ()))
 			{
 				digests.push_back (network.publish_filter.hash (info.block));
 				cleaning_list.push_back (key);
 			}
-		}
+			return cleaning_list.size () < 1024 * 1024 && vban::seconds_since_epoch () - now < 120;
+		});
 	}
 	if (!cleaning_list.empty ())
 	{
@@ -945,9 +1059,9 @@ void vban::node::unchecked_cleanup ()
 		{
 			auto key (cleaning_list.front ());
 			cleaning_list.pop_front ();
-			if (store.unchecked_exists (transaction, key))
+			if (unchecked.exists (transaction, key))
 			{
-				store.unchecked_del (transaction, key);
+				unchecked.del (transaction, key);
 			}
 		}
 	}
@@ -1045,14 +1159,20 @@ void vban::node::ledger_pruning (uint64_t const batch_size_a, bool bootstrap_wei
 		transaction_write_count = 0;
 		if (!pruning_targets.empty () && !stopped)
 		{
-			auto scoped_write_guard = write_database_queue.wait (vban::writer::pruning);
-			auto write_transaction (store.tx_begin_write ({ tables::blocks, tables::pruned }));
-			while (!pruning_targets.empty () && transaction_write_count < batch_size_a && !stopped)
+			auto prune = [this, &pruning_targets, &transaction_write_count, batch_size_a] (vban::write_transaction & write_transaction) {
+				while (!pruning_targets.empty () && transaction_write_count < batch_size_a && !stopped)
+				{
+					auto const & pruning_hash (pruning_targets.front ());
+					auto account_pruned_count (ledger.pruning_action (write_transaction, pruning_hash, batch_size_a));
+					transaction_write_count += account_pruned_count;
+					pruning_targets.pop_front ();
+				}
+			};
+			if (!write_database_queue.append (vban::writer::pruning, prune))
 			{
-				auto const & pruning_hash (pruning_targets.front ());
-				auto account_pruned_count (ledger.pruning_action (write_transaction, pruning_hash, batch_size_a));
-				transaction_write_count += account_pruned_count;
-				pruning_targets.pop_front ();
+				auto scoped_write_guard = write_database_queue.wait (vban::writer::pruning);
+				auto write_transaction (store.tx_begin_write ({ tables::blocks, tables::pruned, tables::representatives }));
+				prune (write_transaction);
 			}
 			pruned_count += transaction_write_count;
 			auto log_message (boost::str (boost::format ("%1% blocks pruned") % pruned_count));
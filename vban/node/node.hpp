@@ -22,6 +22,7 @@
 #include <vban/node/request_aggregator.hpp>
 #include <vban/node/signatures.hpp>
 #include <vban/node/telemetry.hpp>
+#include <vban/node/unchecked_map.hpp>
 #include <vban/node/vote_processor.hpp>
 #include <vban/node/wallet.hpp>
 #include <vban/node/write_database_queue.hpp>
@@ -169,6 +170,9 @@ public:
 	vban::wallets_store & wallets_store;
 	vban::gap_cache gap_cache;
 	vban::ledger ledger;
+	vban::unchecked_map unchecked;
+	vban::signature_cache signature_cache;
+	vban::representative_key_cache representative_keys;
 	vban::signature_checker checker;
 	vban::network network;
 	std::shared_ptr<vban::telemetry> telemetry;
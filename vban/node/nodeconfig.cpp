@@ -115,6 +115,18 @@ vban::error vban::node_config::serialize_toml (vban::tomlconfig & toml) const
 	toml.put ("frontiers_confirmation", serialize_frontiers_confirmation (frontiers_confirmation), "Mode controlling frontier confirmation rate.\ntype:string,{auto,always,disabled}");
 	toml.put ("max_queued_requests", max_queued_requests, "Limit for number of queued confirmation requests for one channel, after which new requests are dropped until the queue drops below this value.\ntype:uint32");
 	toml.put ("confirm_req_batches_max", confirm_req_batches_max, "Limit for the number of confirmation requests for one channel per request attempt\ntype:uint32");
+	toml.put ("signature_cache_size", signature_cache_size, "Maximum number of recently verified signatures kept to skip re-verifying rebroadcast votes and blocks. 0 disables the cache.\ntype:uint64");
+	toml.put ("account_cache_memory_mb", account_cache_memory_mb, "Memory budget in megabytes of the write-through cache for the accounts and confirmation_height tables used by block processing. 0 disables the cache.\ntype:uint64");
+	toml.put ("block_cache_size", block_cache_size, "Maximum number of recently read blocks kept decoded in memory by the store. 0 disables the cache.\ntype:uint64");
+	toml.put ("vote_processor_threads", vote_processor_threads, "Number of threads verifying and applying incoming votes. Votes from the same representative are always handled by the same thread. Defaults to 1.\ntype:uint32");
+	toml.put ("block_processor_batch_target_time", block_processor_batch_target_time.count (), "Target time the block processor holds the database write lock per batch. Batch sizes adapt to commit latency, queue depth and other waiting writers to stay close to it. 0 disables adaptive batching.\ntype:milliseconds");
+	toml.put ("block_processor_prevalidation_threads", block_processor_prevalidation_threads, "Number of threads checking legacy block signatures and prefetching ledger entries for queued blocks before they are written. 0 writes blocks without this stage.\ntype:uint64");
+	toml.put ("unchecked_memory_mb", unchecked_memory_mb, "Memory budget in megabytes for blocks waiting on a missing dependency. Blocks above it are written to the unchecked table.\ntype:uint64");
+	toml.put ("write_group_commit", write_group_commit, "Lets database writers that are ready while another one holds the write transaction append to it, so they are committed together with one sync. Only applies to LMDB.\ntype:bool");
+	toml.put ("block_filter_bits", block_filter_bits, "Bits of memory per block and pruned hash for the filter answering lookups of unknown blocks without database reads. Higher values lower the false positive rate, 0 disables the filter.\ntype:uint64");
+	toml.put ("account_history_index", account_history_index, "Maintain an index of the blocks of each account by height so account_history pages do not walk the chain. An existing ledger needs the index built once with --rebuild_account_history_index.\ntype:bool");
+	toml.put ("delegators_index", delegators_index, "Maintain an index of the accounts delegating to each representative so the delegators and delegators_count RPCs do not scan every account. It is built in the background when the node first starts with the option enabled, the RPCs scan the accounts until it is complete.\ntype:bool");
+	toml.put ("pending_summary_index", pending_summary_index, "Maintain a summary of the amounts pending for each account so pending searches with a threshold skip accounts which cannot match. It is built when the node first starts with the option enabled.\ntype:bool");
 
 	auto work_peers_l (toml.create_array ("work_peers", "A list of \"address:port\" entries to identify work peers."));
 	for (auto i (work_peers.begin ()), n (work_peers.end ()); i != n; ++i)
@@ -375,6 +387,20 @@ vban::error vban::node_config::deserialize_toml (vban::tomlconfig & toml)
 
 		toml.get<uint32_t> ("max_queued_requests", max_queued_requests);
 		toml.get<uint32_t> ("confirm_req_batches_max", confirm_req_batches_max);
+		toml.get<size_t> ("signature_cache_size", signature_cache_size);
+		toml.get<size_t> ("account_cache_memory_mb", account_cache_memory_mb);
+		toml.get<size_t> ("block_cache_size", block_cache_size);
+		toml.get<unsigned> ("vote_processor_threads", vote_processor_threads);
+		auto block_processor_batch_target_time_l = block_processor_batch_target_time.count ();
+		toml.get ("block_processor_batch_target_time", block_processor_batch_target_time_l);
+		block_processor_batch_target_time = std::chrono::milliseconds (block_processor_batch_target_time_l);
+		toml.get<unsigned> ("block_processor_prevalidation_threads", block_processor_prevalidation_threads);
+		toml.get<uint64_t> ("unchecked_memory_mb", unchecked_memory_mb);
+		toml.get<bool> ("write_group_commit", write_group_commit);
+		toml.get<size_t> ("block_filter_bits", block_filter_bits);
+		toml.get<bool> ("account_history_index", account_history_index);
+		toml.get<bool> ("delegators_index", delegators_index);
+		toml.get<bool> ("pending_summary_index", pending_summary_index);
 
 		if (toml.has_key ("frontiers_confirmation"))
 		{
@@ -436,6 +462,10 @@ vban::error vban::node_config::deserialize_toml (vban::tomlconfig & toml)
 		{
 			toml.get_error ().set ((boost::format ("block_processor_batch_max_time value must be equal or larger than %1%ms") % network_params.node.process_confirmed_interval.count ()).str ());
 		}
+		if (block_processor_batch_target_time > block_processor_batch_max_time)
+		{
+			toml.get_error ().set ("block_processor_batch_target_time must not be larger than block_processor_batch_max_time");
+		}
 		if (max_pruning_age < std::chrono::seconds (5 * 60) && !network.is_dev_network ())
 		{
 			toml.get_error ().set ("max_pruning_age must be greater than or equal to 5 minutes");
@@ -448,6 +478,10 @@ vban::error vban::node_config::deserialize_toml (vban::tomlconfig & toml)
 		{
 			toml.get_error ().set ("bootstrap_frontier_request_count must be greater than or equal to 1024");
 		}
+		if (vote_processor_threads == 0)
+		{
+			toml.get_error ().set ("vote_processor_threads must be non-zero");
+		}
 	}
 	catch (std::runtime_error const & ex)
 	{
@@ -62,10 +62,32 @@ public:
 	unsigned work_threads{ std::max<unsigned> (4, std::thread::hardware_concurrency ()) };
 	/* Use half available threads on the system for signature checking. The calling thread does checks as well, so these are extra worker threads */
 	unsigned signature_checker_threads{ std::thread::hardware_concurrency () / 2 };
+	/** Number of recently verified signatures remembered by the signature checker, 0 disables the cache */
+	size_t signature_cache_size{ 64 * 1024 };
+	/** Memory budget of the write-through accounts and confirmation_height cache in front of the store, 0 disables it */
+	size_t account_cache_memory_mb{ 64 };
+	/** Number of decoded blocks kept by the store for repeated lookups of recent hashes, 0 disables the cache */
+	size_t block_cache_size{ 16 * 1024 };
 	bool enable_voting{ false };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
 	unsigned bootstrap_initiator_threads{ 1 };
+	/** Threads applying incoming votes, votes are sharded over them by representative */
+	unsigned vote_processor_threads{ 1 };
+	/** Threads reading ahead for queued blocks so the block processor mostly applies results under the write lock */
+	unsigned block_processor_prevalidation_threads{ std::min<unsigned> (4, std::max<unsigned> (1, std::thread::hardware_concurrency () / 4)) };
+	/** Blocks waiting on a missing dependency are kept in memory up to this budget before spilling to the unchecked table */
+	uint64_t unchecked_memory_mb{ 128 };
+	/** Writers ready while another holds the database write transaction append to it and share its commit */
+	bool write_group_commit{ false };
+	/** Memory per block hash of the filter which lets lookups of unknown blocks skip the database, 0 disables it */
+	size_t block_filter_bits{ 10 };
+	/** Index blocks by account and height so account_history seeks pages directly instead of walking the chain */
+	bool account_history_index{ false };
+	/** Index accounts by representative so the delegators RPCs do not scan the accounts table */
+	bool delegators_index{ false };
+	/** Summarise the amounts pending for each account so thresholded pending searches skip accounts without reading their entries */
+	bool pending_summary_index{ false };
 	uint32_t bootstrap_frontier_request_count{ 1024 * 1024 };
 	vban::websocket::config websocket_config;
 	vban::diagnostics_config diagnostics_config;
@@ -80,6 +102,8 @@ public:
 	std::string external_address;
 	uint16_t external_port{ 0 };
 	std::chrono::milliseconds block_processor_batch_max_time{ network_params.network.is_dev_network () ? std::chrono::milliseconds (500) : std::chrono::milliseconds (5000) };
+	/** Write lock hold time the adaptive batch sizing aims for, 0 uses fixed batches bounded by block_processor_batch_max_time */
+	std::chrono::milliseconds block_processor_batch_target_time{ network_params.network.is_dev_network () ? std::chrono::milliseconds (50) : std::chrono::milliseconds (250) };
 	std::chrono::seconds unchecked_cutoff_time{ std::chrono::seconds (4 * 60 * 60) }; // 4 hours
 	/** Timeout for initiated async operations */
 	std::chrono::seconds tcp_io_timeout{ (network_params.network.is_dev_network () && !is_sanitizer_build) ? std::chrono::seconds (5) : std::chrono::seconds (15) };
@@ -83,6 +83,7 @@ void vban::rep_crawler::ongoing_crawl ()
 	cleanup_reps ();
 	update_weights ();
 	validate ();
+	update_key_cache ();
 	query (get_crawl_targets (total_weight_l));
 	auto sufficient_weight (total_weight_l > node.online_reps.delta ());
 	// If online weight drops below minimum, reach out to preconfigured peers
@@ -324,6 +325,37 @@ void vban::rep_crawler::update_weights ()
 	}
 }
 
+void vban::rep_crawler::update_key_cache ()
+{
+	// Principal representatives we have a channel to, plus the ones whose votes were observed recently
+	auto minimum (node.minimum_principal_weight ());
+	std::vector<std::pair<vban::uint256_t, vban::account>> candidates;
+	for (auto const & rep : principal_representatives ())
+	{
+		candidates.emplace_back (rep.weight.number (), rep.account);
+	}
+	for (auto const & account : node.online_reps.list ())
+	{
+		auto weight (node.ledger.weight (account));
+		if (weight >= minimum)
+		{
+			candidates.emplace_back (weight, account);
+		}
+	}
+	// Heaviest first so a full cache keeps the keys signing most of the votes
+	std::sort (candidates.begin (), candidates.end (), [] (auto const & a, auto const & b) { return a.first > b.first; });
+	std::unordered_set<vban::account> seen;
+	std::vector<vban::public_key> keys;
+	for (auto const & candidate : candidates)
+	{
+		if (seen.insert (candidate.second).second)
+		{
+			keys.push_back (candidate.second);
+		}
+	}
+	node.representative_keys.update (keys);
+}
+
 std::vector<vban::representative> vban::rep_crawler::representatives (size_t count_a, vban::uint256_t const weight_a, boost::optional<decltype (vban::protocol_constants::protocol_version)> const & opt_version_min_a)
 {
 	auto version_min (opt_version_min_a.value_or (node.network_params.protocol.protocol_version_min ()));
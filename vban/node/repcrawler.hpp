@@ -144,6 +144,9 @@ private:
 	/** Update representatives weights from ledger */
 	void update_weights ();
 
+	/** Decompress the public keys of the heaviest principal representatives ahead of their votes */
+	void update_key_cache ();
+
 	/** Protects the probable_reps container */
 	mutable vban::mutex probable_reps_mutex;
 
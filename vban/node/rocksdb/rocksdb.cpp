@@ -65,6 +65,7 @@ void rocksdb_val::convert_buffer_to_value ()
 
 vban::rocksdb_store::rocksdb_store (vban::logger_mt & logger_a, boost::filesystem::path const & path_a, vban::rocksdb_config const & rocksdb_config_a, bool open_read_only_a) :
 	logger{ logger_a },
+	path{ path_a },
 	rocksdb_config{ rocksdb_config_a },
 	max_block_write_batch_num_m{ vban::narrow_cast<unsigned> (blocks_memtable_size_bytes () / (2 * (sizeof (vban::block_type) + vban::state_block::size + vban::block_sideband::size (vban::block_type::state)))) },
 	cf_name_table_map{ create_cf_name_table_map () }
@@ -83,6 +84,16 @@ vban::rocksdb_store::rocksdb_store (vban::logger_mt & logger_a, boost::filesyste
 			construct_column_family_mutexes ();
 		}
 		open (error, path_a, open_read_only_a);
+		if (!error)
+		{
+			auto transaction (tx_begin_read ());
+			representatives_load (transaction);
+		}
+		// Only the compact block format is upgraded in place, older ledgers are converted by migrating from LMDB
+		if (!error && !open_read_only_a && version_get (tx_begin_read ()) == 24)
+		{
+			upgrade_v24_to_v25 ();
+		}
 	}
 }
 
@@ -100,7 +111,11 @@ std::unordered_map<const char *, vban::tables> vban::rocksdb_store::create_cf_na
 		{ "peers", tables::peers },
 		{ "confirmation_height", tables::confirmation_height },
 		{ "pruned", tables::pruned },
-		{ "final_votes", tables::final_votes } };
+		{ "final_votes", tables::final_votes },
+		{ "account_heights", tables::account_heights },
+		{ "delegators", tables::delegators },
+		{ "pending_summary", tables::pending_summary },
+		{ "representatives", tables::representatives } };
 
 	debug_assert (map.size () == all_tables ().size () + 1);
 	return map;
@@ -149,6 +164,38 @@ void vban::rocksdb_store::open (bool & error_a, boost::filesystem::path const &
 	}
 }
 
+void vban::rocksdb_store::upgrade_v24_to_v25 ()
+{
+	logger.always_log ("Preparing v24 to v25 database upgrade...");
+	auto transaction (tx_begin_write ({ tables::blocks, tables::meta, tables::representatives }));
+	// The iterator reads the snapshot taken when it is created, entries rewritten meanwhile are not visited again
+	std::unique_ptr<rocksdb::Iterator> iterator (db->NewIterator (rocksdb::ReadOptions (), table_to_column_family (tables::blocks)));
+	uint64_t count_l (0);
+	std::vector<uint8_t> data;
+	std::vector<uint8_t> compact;
+	for (iterator->SeekToFirst (); iterator->Valid (); iterator->Next ())
+	{
+		data.assign (iterator->value ().data (), iterator->value ().data () + iterator->value ().size ());
+		if (block_entry_compact (transaction, data, compact))
+		{
+			vban::rocksdb_val key{ iterator->key ().size (), (void *)iterator->key ().data () };
+			auto status (put (transaction, tables::blocks, key, vban::rocksdb_val{ compact.size (), compact.data () }));
+			release_assert_success (status);
+			if (++count_l % max_block_write_batch_num_m == 0)
+			{
+				transaction.refresh ();
+			}
+			if (count_l % 1000000 == 0)
+			{
+				logger.always_log (boost::str (boost::format ("%1% state blocks compacted") % count_l));
+			}
+		}
+	}
+	release_assert (iterator->status ().ok ());
+	version_put (transaction, 25);
+	logger.always_log (boost::str (boost::format ("Finished compacting %1% state blocks") % count_l));
+}
+
 void vban::rocksdb_store::generate_tombstone_map ()
 {
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (vban::tables::unchecked), std::forward_as_tuple (0, 50000));
@@ -239,6 +286,10 @@ rocksdb::ColumnFamilyOptions vban::rocksdb_store::get_cf_options (std::string co
 		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 
+		// Entries of an account are scanned together, so the bloom filters also hold the account prefix (pending_key::account)
+		cf_options.memtable_prefix_bloom_size_ratio = 0.25;
+		cf_options.prefix_extractor.reset (rocksdb::NewFixedPrefixTransform (sizeof (vban::account)));
+
 		// Number of files in level 0 which triggers compaction. Size of L0 and L1 should be kept similar as this is the only compaction which is single threaded
 		cf_options.level0_file_num_compaction_trigger = 2;
 
@@ -272,6 +323,33 @@ rocksdb::ColumnFamilyOptions vban::rocksdb_store::get_cf_options (std::string co
 	{
 		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+
+		// Votes are looked up by root, the first half of the qualified root key
+		cf_options.memtable_prefix_bloom_size_ratio = 0.25;
+		cf_options.prefix_extractor.reset (rocksdb::NewFixedPrefixTransform (sizeof (vban::root)));
+	}
+	else if (cf_name_a == "account_heights")
+	{
+		// Optional index, only deleted from by rollbacks
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
+	else if (cf_name_a == "delegators")
+	{
+		// Optional index, an entry moves on every representative change
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
+	else if (cf_name_a == "pending_summary")
+	{
+		// Optional index, overwritten whenever pending changes
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
+	else if (cf_name_a == "representatives")
+	{
+		// Small, append only and only read at startup
+		cf_options = get_small_cf_options (small_table_factory);
 	}
 	else if (cf_name_a == rocksdb::kDefaultColumnFamilyName)
 	{
@@ -363,6 +441,14 @@ rocksdb::ColumnFamilyHandle * vban::rocksdb_store::table_to_column_family (table
 			return get_handle ("confirmation_height");
 		case tables::final_votes:
 			return get_handle ("final_votes");
+		case tables::account_heights:
+			return get_handle ("account_heights");
+		case tables::delegators:
+			return get_handle ("delegators");
+		case tables::pending_summary:
+			return get_handle ("pending_summary");
+		case tables::representatives:
+			return get_handle ("representatives");
 		default:
 			release_assert (false);
 			return get_handle ("");
@@ -510,6 +596,19 @@ uint64_t vban::rocksdb_store::count (vban::transaction const & transaction_a, ta
 	{
 		db->GetIntProperty (table_to_column_family (table_a), "rocksdb.estimate-num-keys", &sum);
 	}
+	// This is only an estimation
+	else if (table_a == tables::account_heights || table_a == tables::delegators || table_a == tables::pending_summary)
+	{
+		db->GetIntProperty (table_to_column_family (table_a), "rocksdb.estimate-num-keys", &sum);
+	}
+	// Small enough to be counted exactly
+	else if (table_a == tables::representatives)
+	{
+		for (auto i (make_iterator<uint64_t, vban::account> (transaction_a, tables::representatives, true)), n (vban::store_iterator<uint64_t, vban::account> (nullptr)); i != n; ++i)
+		{
+			++sum;
+		}
+	}
 	// Accounts and blocks should only be used in tests and CLI commands to check database consistency
 	// otherwise there can be performance issues.
 	else if (table_a == tables::accounts)
@@ -523,7 +622,7 @@ uint64_t vban::rocksdb_store::count (vban::transaction const & transaction_a, ta
 	else if (table_a == tables::blocks)
 	{
 		// This is also used in some CLI commands
-		for (auto i (blocks_begin (transaction_a)), n (blocks_end ()); i != n; ++i)
+		for (auto i (block_views_begin (transaction_a)), n (block_views_end ()); i != n; ++i)
 		{
 			++sum;
 		}
@@ -755,7 +854,66 @@ void vban::rocksdb_store::on_flush (rocksdb::FlushJobInfo const & flush_job_info
 
 std::vector<vban::tables> vban::rocksdb_store::all_tables () const
 {
-	return std::vector<vban::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::unchecked, tables::vote };
+	return std::vector<vban::tables>{ tables::account_heights, tables::accounts, tables::blocks, tables::confirmation_height, tables::delegators, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pending_summary, tables::pruned, tables::representatives, tables::unchecked, tables::vote };
+}
+
+std::unique_ptr<vban::bulk_writer> vban::rocksdb_store::bulk_writer_make (vban::tables table_a)
+{
+	std::unique_ptr<vban::bulk_writer> result;
+	if (optimistic_db != nullptr)
+	{
+		auto column_family (table_to_column_family (table_a));
+		auto directory (path / "bulk");
+		boost::system::error_code error_mkdir;
+		boost::filesystem::create_directories (directory, error_mkdir);
+		rocksdb::Options options (rocksdb::DBOptions (), get_cf_options (column_family->GetName ()));
+		auto dictionary (table_a == tables::blocks ? &representative_ids : nullptr);
+		result = std::make_unique<vban::rocksdb_bulk_writer> (options, table_a, column_family, directory / (std::to_string (bulk_files++) + ".sst"), dictionary);
+	}
+	return result;
+}
+
+bool vban::rocksdb_store::bulk_ingest (std::vector<std::unique_ptr<vban::bulk_writer>> & writers_a)
+{
+	std::unordered_map<rocksdb::ColumnFamilyHandle *, std::vector<std::string>> files;
+	for (auto const & writer : writers_a)
+	{
+		auto const & writer_l (*boost::polymorphic_downcast<vban::rocksdb_bulk_writer *> (writer.get ()));
+		if (!writer_l.empty)
+		{
+			files[writer_l.column_family].push_back (writer_l.path.string ());
+		}
+	}
+	// Ids given by the blocks writers are persisted before the entries using them
+	if (files.count (table_to_column_family (tables::blocks)) > 0)
+	{
+		auto transaction (tx_begin_write ({ tables::representatives }));
+		for (uint64_t id (0), n (representative_ids.next ()); id < n; ++id)
+		{
+			vban::account representative;
+			auto error_l (representative_ids.get (id, representative));
+			debug_assert (!error_l);
+			auto status (put (transaction, tables::representatives, vban::rocksdb_val (id), vban::rocksdb_val (representative)));
+			release_assert_success (status);
+		}
+	}
+	rocksdb::IngestExternalFileOptions options;
+	// Nothing else uses the files, so they are linked into the database instead of copied
+	options.move_files = true;
+	auto error (false);
+	for (auto const & [column_family, files_l] : files)
+	{
+		auto status (db->IngestExternalFile (column_family, files_l, options));
+		if (!status.ok ())
+		{
+			logger.always_log (boost::str (boost::format ("Ingesting %1% files failed: %2%") % column_family->GetName () % status.ToString ()));
+			error = true;
+		}
+	}
+	writers_a.clear ();
+	boost::system::error_code error_remove;
+	boost::filesystem::remove_all (path / "bulk", error_remove);
+	return error;
 }
 
 bool vban::rocksdb_store::copy_db (boost::filesystem::path const & destination_path)
@@ -913,4 +1071,83 @@ vban::rocksdb_store::tombstone_info::tombstone_info (uint64_t num_since_last_flu
 }
 
 // Explicitly instantiate
+vban::rocksdb_bulk_writer::rocksdb_bulk_writer (rocksdb::Options const & options_a, vban::tables table_a, rocksdb::ColumnFamilyHandle * column_family_a, boost::filesystem::path const & path_a, vban::representative_dictionary * dictionary_a) :
+	table (table_a),
+	column_family (column_family_a),
+	path (path_a),
+	dictionary (dictionary_a),
+	writer (rocksdb::EnvOptions (), options_a, column_family_a)
+{
+	status = writer.Open (path.string ());
+}
+
+void vban::rocksdb_bulk_writer::block_raw_put (std::vector<uint8_t> const & data_a, vban::block_hash const & hash_a)
+{
+	debug_assert (table == tables::blocks && dictionary != nullptr);
+	vban::account representative;
+	std::vector<uint8_t> compact;
+	if (vban::block_encoding::compactable (data_a, representative))
+	{
+		vban::block_encoding::compact (data_a, dictionary->assign (representative), compact);
+	}
+	auto const & stored (compact.empty () ? data_a : compact);
+	vban::rocksdb_val value{ stored.size (), (void *)stored.data () };
+	put (hash_a, value);
+}
+
+void vban::rocksdb_bulk_writer::account_put (vban::account const & account_a, vban::account_info const & info_a)
+{
+	debug_assert (table == tables::accounts);
+	put (account_a, info_a);
+}
+
+void vban::rocksdb_bulk_writer::pending_put (vban::pending_key const & key_a, vban::pending_info const & info_a)
+{
+	debug_assert (table == tables::pending);
+	put (key_a, info_a);
+}
+
+void vban::rocksdb_bulk_writer::confirmation_height_put (vban::account const & account_a, vban::confirmation_height_info const & info_a)
+{
+	debug_assert (table == tables::confirmation_height);
+	put (account_a, info_a);
+}
+
+void vban::rocksdb_bulk_writer::account_height_put (vban::account const & account_a, uint64_t height_a, vban::block_hash const & hash_a)
+{
+	debug_assert (table == tables::account_heights);
+	put (vban::account_height_key (account_a, height_a), hash_a);
+}
+
+void vban::rocksdb_bulk_writer::delegator_put (vban::account const & representative_a, vban::account const & account_a)
+{
+	debug_assert (table == tables::delegators);
+	put (vban::delegator_key (representative_a, account_a), vban::rocksdb_val{ nullptr });
+}
+
+void vban::rocksdb_bulk_writer::pending_summary_put (vban::account const & account_a, vban::pending_summary const & summary_a)
+{
+	debug_assert (table == tables::pending_summary);
+	put (account_a, summary_a);
+}
+
+void vban::rocksdb_bulk_writer::put (vban::rocksdb_val const & key_a, vban::rocksdb_val const & value_a)
+{
+	if (status.ok ())
+	{
+		// Fails unless keys are added in increasing order
+		status = writer.Put (key_a, value_a);
+		empty = false;
+	}
+}
+
+bool vban::rocksdb_bulk_writer::finish ()
+{
+	if (status.ok () && !empty)
+	{
+		status = writer.Finish ();
+	}
+	return !status.ok ();
+}
+
 template class vban::block_store_partial<rocksdb::Slice, vban::rocksdb_store>;
@@ -11,6 +11,7 @@
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 #include <rocksdb/utilities/transaction.h>
@@ -20,6 +21,37 @@ namespace vban
 class logging_mt;
 class rocksdb_config;
 
+/**
+ * Writes a sorted table file for a column family, which rocksdb_store::bulk_ingest moves into the database.
+ * State block entries are compacted through the store's representative dictionary, bulk_ingest persists the ids they were given.
+ */
+class rocksdb_bulk_writer final : public vban::bulk_writer
+{
+public:
+	/** \p dictionary_a is only set for the blocks table */
+	rocksdb_bulk_writer (rocksdb::Options const &, vban::tables, rocksdb::ColumnFamilyHandle *, boost::filesystem::path const &, vban::representative_dictionary * dictionary_a);
+	void block_raw_put (std::vector<uint8_t> const &, vban::block_hash const &) override;
+	void account_put (vban::account const &, vban::account_info const &) override;
+	void pending_put (vban::pending_key const &, vban::pending_info const &) override;
+	void confirmation_height_put (vban::account const &, vban::confirmation_height_info const &) override;
+	void account_height_put (vban::account const &, uint64_t, vban::block_hash const &) override;
+	void delegator_put (vban::account const &, vban::account const &) override;
+	void pending_summary_put (vban::account const &, vban::pending_summary const &) override;
+	bool finish () override;
+	/** Only the puts of this table may be called */
+	vban::tables const table;
+	rocksdb::ColumnFamilyHandle * const column_family;
+	boost::filesystem::path const path;
+	/** Files without records cannot be finished and are not ingested */
+	bool empty{ true };
+
+private:
+	void put (vban::rocksdb_val const &, vban::rocksdb_val const &);
+	vban::representative_dictionary * const dictionary;
+	rocksdb::SstFileWriter writer;
+	rocksdb::Status status;
+};
+
 /**
  * rocksdb implementation of the block store
  */
@@ -43,6 +75,9 @@ public:
 
 	void serialize_memory_stats (boost::property_tree::ptree &) override;
 
+	std::unique_ptr<vban::bulk_writer> bulk_writer_make (vban::tables) override;
+	bool bulk_ingest (std::vector<std::unique_ptr<vban::bulk_writer>> &) override;
+
 	bool copy_db (boost::filesystem::path const & destination) override;
 	void rebuild_db (vban::write_transaction const & transaction_a) override;
 
@@ -51,13 +86,19 @@ public:
 	template <typename Key, typename Value>
 	vban::store_iterator<Key, Value> make_iterator (vban::transaction const & transaction_a, tables table_a, bool const direction_asc) const
 	{
-		return vban::store_iterator<Key, Value> (std::make_unique<vban::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), nullptr, direction_asc));
+		return vban::store_iterator<Key, Value> (std::make_unique<vban::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), nullptr, direction_asc, false, block_dictionary (table_a)));
 	}
 
 	template <typename Key, typename Value>
 	vban::store_iterator<Key, Value> make_iterator (vban::transaction const & transaction_a, tables table_a, vban::rocksdb_val const & key) const
 	{
-		return vban::store_iterator<Key, Value> (std::make_unique<vban::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true));
+		return vban::store_iterator<Key, Value> (std::make_unique<vban::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true, false, block_dictionary (table_a)));
+	}
+
+	template <typename Key, typename Value>
+	vban::store_iterator<Key, Value> make_prefix_iterator (vban::transaction const & transaction_a, tables table_a, vban::rocksdb_val const & key) const
+	{
+		return vban::store_iterator<Key, Value> (std::make_unique<vban::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true, true, block_dictionary (table_a)));
 	}
 
 	bool init_error () const override;
@@ -67,6 +108,7 @@ public:
 private:
 	bool error{ false };
 	vban::logger_mt & logger;
+	boost::filesystem::path const path;
 	// Optimistic transactions are used in write mode
 	rocksdb::OptimisticTransactionDB * optimistic_db = nullptr;
 	std::unique_ptr<rocksdb::DB> db;
@@ -75,6 +117,7 @@ private:
 	std::unordered_map<vban::tables, vban::mutex> write_lock_mutexes;
 	vban::rocksdb_config rocksdb_config;
 	unsigned const max_block_write_batch_num_m;
+	std::atomic<unsigned> bulk_files{ 0 };
 
 	class tombstone_info
 	{
@@ -99,6 +142,7 @@ private:
 	int clear (rocksdb::ColumnFamilyHandle * column_family);
 
 	void open (bool & error_a, boost::filesystem::path const & path_a, bool open_read_only_a);
+	void upgrade_v24_to_v25 ();
 
 	void construct_column_family_mutexes ();
 	rocksdb::Options get_db_options ();
@@ -33,19 +33,30 @@ class rocksdb_iterator : public store_iterator_impl<T, U>
 public:
 	rocksdb_iterator () = default;
 
-	rocksdb_iterator (rocksdb::DB * db, vban::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle_a, rocksdb_val const * val_a, bool const direction_asc)
+	/**
+	 * With \p prefix_a the iterator ends after the entries sharing the prefix of \p val_a, so seeks only read the files whose prefix bloom filter matches.
+	 * Other iterators seek in total order, which stays correct when scanning across prefixes of tables with a prefix extractor.
+	 * Values are decoded with \p dictionary_a when it is set, which is only the case for the blocks table.
+	 */
+	rocksdb_iterator (rocksdb::DB * db, vban::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle_a, rocksdb_val const * val_a, bool const direction_asc, bool const prefix_a = false, vban::representative_dictionary const * dictionary_a = nullptr) :
+		dictionary (dictionary_a)
 	{
+		debug_assert (!prefix_a || val_a != nullptr);
 		// Don't fill the block cache for any blocks read as a result of an iterator
 		if (is_read (transaction_a))
 		{
 			auto read_options = snapshot_options (transaction_a);
 			read_options.fill_cache = false;
+			read_options.prefix_same_as_start = prefix_a;
+			read_options.total_order_seek = !prefix_a;
 			cursor.reset (db->NewIterator (read_options, handle_a));
 		}
 		else
 		{
 			rocksdb::ReadOptions ropts;
 			ropts.fill_cache = false;
+			ropts.prefix_same_as_start = prefix_a;
+			ropts.total_order_seek = !prefix_a;
 			cursor.reset (tx (transaction_a)->GetIterator (ropts, handle_a));
 		}
 
@@ -83,6 +94,7 @@ public:
 		cursor = other_a.cursor;
 		other_a.cursor = nullptr;
 		current = other_a.current;
+		dictionary = other_a.dictionary;
 	}
 
 	rocksdb_iterator (vban::rocksdb_iterator<T, U> const &) = delete;
@@ -170,7 +182,11 @@ public:
 			{
 				value_a.first = T ();
 			}
-			if (current.second.size () != 0)
+			if (current.second.size () != 0 && dictionary != nullptr)
+			{
+				value_a.second = vban::block_entry_converter<U>::convert (current.second, *dictionary);
+			}
+			else if (current.second.size () != 0)
 			{
 				value_a.second = static_cast<U> (current.second);
 			}
@@ -190,6 +206,7 @@ public:
 	{
 		cursor = std::move (other_a.cursor);
 		current = other_a.current;
+		dictionary = other_a.dictionary;
 		return *this;
 	}
 	vban::store_iterator_impl<T, U> & operator= (vban::store_iterator_impl<T, U> const &) = delete;
@@ -198,6 +215,8 @@ public:
 	std::pair<vban::rocksdb_val, vban::rocksdb_val> current;
 
 private:
+	vban::representative_dictionary const * dictionary{ nullptr };
+
 	rocksdb::Transaction * tx (vban::transaction const & transaction_a) const
 	{
 		return static_cast<rocksdb::Transaction *> (transaction_a.get_handle ());
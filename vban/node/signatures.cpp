@@ -1,10 +1,159 @@
 #include <vban/boost/asio/post.hpp>
+#include <vban/crypto/blake2/blake2.h>
 #include <vban/lib/locks.hpp>
 #include <vban/lib/numbers.hpp>
+#include <vban/lib/stats.hpp>
 #include <vban/node/signatures.hpp>
 
-vban::signature_checker::signature_checker (unsigned num_threads) :
-	thread_pool (num_threads, vban::thread_role::name::signature_checking)
+vban::signature_cache::signature_cache (size_t max_size_a, vban::stat & stats_a) :
+	max_size (max_size_a),
+	stats (stats_a)
+{
+}
+
+vban::uint256_union vban::signature_cache::key (unsigned char const * message_a, size_t length_a, unsigned char const * pub_key_a, unsigned char const * signature_a)
+{
+	vban::uint256_union result;
+	blake2b_state hash;
+	blake2b_init (&hash, sizeof (result.bytes));
+	blake2b_update (&hash, message_a, length_a);
+	blake2b_update (&hash, pub_key_a, sizeof (vban::public_key));
+	blake2b_update (&hash, signature_a, sizeof (vban::signature));
+	blake2b_final (&hash, result.bytes.data (), sizeof (result.bytes));
+	return result;
+}
+
+vban::signature_cache::shard & vban::signature_cache::shard_for (vban::uint256_union const & key_a)
+{
+	// Keys are uniformly distributed digests, any byte selects a shard evenly
+	return shards[key_a.bytes[0] % shard_count];
+}
+
+bool vban::signature_cache::exists (vban::uint256_union const & key_a)
+{
+	bool result (false);
+	auto & shard_l (shard_for (key_a));
+	{
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		auto & hashed (shard_l.entries.get<1> ());
+		auto existing (hashed.find (key_a));
+		if (existing != hashed.end ())
+		{
+			// Keep recently used entries at the back so the least recently used are evicted first
+			shard_l.entries.relocate (shard_l.entries.end (), shard_l.entries.project<0> (existing));
+			result = true;
+		}
+	}
+	return result;
+}
+
+void vban::signature_cache::record (uint64_t hits_a, uint64_t misses_a)
+{
+	hits += hits_a;
+	misses += misses_a;
+	if (hits_a > 0)
+	{
+		stats.add (vban::stat::type::signature_cache, vban::stat::detail::cache_hit, vban::stat::dir::in, hits_a);
+	}
+	if (misses_a > 0)
+	{
+		stats.add (vban::stat::type::signature_cache, vban::stat::detail::cache_miss, vban::stat::dir::in, misses_a);
+	}
+}
+
+void vban::signature_cache::insert (vban::uint256_union const & key_a)
+{
+	auto & shard_l (shard_for (key_a));
+	auto const max_shard_size (std::max<size_t> (1, max_size / shard_count));
+	vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+	if (shard_l.entries.push_back (key_a).second)
+	{
+		while (shard_l.entries.size () > max_shard_size)
+		{
+			shard_l.entries.pop_front ();
+		}
+	}
+}
+
+size_t vban::signature_cache::size ()
+{
+	size_t result (0);
+	for (auto & shard_l : shards)
+	{
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		result += shard_l.entries.size ();
+	}
+	return result;
+}
+
+std::unique_ptr<vban::container_info_component> vban::collect_container_info (signature_cache & signature_cache, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", signature_cache.size (), sizeof (vban::uint256_union) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hits", static_cast<size_t> (signature_cache.hits), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "misses", static_cast<size_t> (signature_cache.misses), 0 }));
+	return composite;
+}
+
+vban::representative_key_cache::representative_key_cache (size_t max_size_a) :
+	max_size (max_size_a),
+	keys_m (std::make_shared<keys_t> ())
+{
+}
+
+void vban::representative_key_cache::update (std::vector<vban::public_key> const & keys_a)
+{
+	auto existing (keys ());
+	auto updated (std::make_shared<keys_t> ());
+	auto changed (false);
+	for (auto i (keys_a.begin ()), n (keys_a.end ()); i != n && updated->size () < max_size; ++i)
+	{
+		auto found (existing->find (*i));
+		if (found != existing->end ())
+		{
+			updated->insert (*found);
+		}
+		else
+		{
+			ed25519_unpacked_public_key unpacked;
+			// Keys not on the curve can never verify, leave them to the regular path
+			if (ed25519_publickey_unpack (i->bytes.data (), &unpacked) == 0)
+			{
+				changed = updated->emplace (*i, unpacked).second || changed;
+			}
+		}
+	}
+	if (changed || updated->size () != existing->size ())
+	{
+		vban::lock_guard<vban::mutex> guard (mutex);
+		keys_m = std::move (updated);
+	}
+}
+
+std::shared_ptr<vban::representative_key_cache::keys_t const> vban::representative_key_cache::keys () const
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	return keys_m;
+}
+
+size_t vban::representative_key_cache::size () const
+{
+	return keys ()->size ();
+}
+
+std::unique_ptr<vban::container_info_component> vban::collect_container_info (representative_key_cache & representative_key_cache, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "keys", representative_key_cache.size (), sizeof (vban::representative_key_cache::keys_t::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hits", static_cast<size_t> (representative_key_cache.hits), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "misses", static_cast<size_t> (representative_key_cache.misses), 0 }));
+	return composite;
+}
+
+vban::signature_checker::signature_checker (unsigned num_threads, vban::signature_cache * cache_a, vban::representative_key_cache * representative_keys_a) :
+	thread_pool (num_threads, vban::thread_role::name::signature_checking),
+	cache (cache_a),
+	representative_keys (representative_keys_a)
 {
 }
 
@@ -21,6 +170,79 @@ void vban::signature_checker::verify (vban::signature_check_set & check_a)
 		return;
 	}
 
+	if (cache != nullptr && cache->max_size > 0)
+	{
+		verify_cached (check_a);
+	}
+	else
+	{
+		verify_impl (check_a);
+	}
+}
+
+/* Marks entries found in the cache as valid and only passes the remaining ones to the curve math.
+ * Newly verified valid signatures are added to the cache afterwards.
+ */
+void vban::signature_checker::verify_cached (vban::signature_check_set & check_a)
+{
+	std::vector<vban::uint256_union> keys;
+	keys.reserve (check_a.size);
+	std::vector<size_t> misses;
+	misses.reserve (check_a.size);
+	for (size_t i (0); i < check_a.size; ++i)
+	{
+		keys.push_back (vban::signature_cache::key (check_a.messages[i], check_a.message_lengths[i], check_a.pub_keys[i], check_a.signatures[i]));
+		if (cache->exists (keys.back ()))
+		{
+			check_a.verifications[i] = 1;
+		}
+		else
+		{
+			misses.push_back (i);
+		}
+	}
+	cache->record (check_a.size - misses.size (), misses.size ());
+	if (misses.size () == check_a.size)
+	{
+		verify_impl (check_a);
+	}
+	else if (!misses.empty ())
+	{
+		auto size (misses.size ());
+		std::vector<unsigned char const *> messages;
+		messages.reserve (size);
+		std::vector<size_t> lengths;
+		lengths.reserve (size);
+		std::vector<unsigned char const *> pub_keys;
+		pub_keys.reserve (size);
+		std::vector<unsigned char const *> signatures;
+		signatures.reserve (size);
+		std::vector<int> verifications (size, 0);
+		for (auto index : misses)
+		{
+			messages.push_back (check_a.messages[index]);
+			lengths.push_back (check_a.message_lengths[index]);
+			pub_keys.push_back (check_a.pub_keys[index]);
+			signatures.push_back (check_a.signatures[index]);
+		}
+		vban::signature_check_set check_misses (size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data ());
+		verify_impl (check_misses);
+		for (size_t i (0); i < size; ++i)
+		{
+			check_a.verifications[misses[i]] = verifications[i];
+		}
+	}
+	for (auto index : misses)
+	{
+		if (check_a.verifications[index] == 1)
+		{
+			cache->insert (keys[index]);
+		}
+	}
+}
+
+void vban::signature_checker::verify_impl (vban::signature_check_set & check_a)
+{
 	if (check_a.size <= batch_size || single_threaded ())
 	{
 		// Not dealing with many so just use the calling thread for checking signatures
@@ -88,7 +310,30 @@ void vban::signature_checker::flush ()
 
 bool vban::signature_checker::verify_batch (const vban::signature_check_set & check_a, size_t start_index, size_t size)
 {
-	vban::validate_message_batch (check_a.messages + start_index, check_a.message_lengths + start_index, check_a.pub_keys + start_index, check_a.signatures + start_index, size, check_a.verifications + start_index);
+	auto keys_l (representative_keys != nullptr ? representative_keys->keys () : nullptr);
+	if (keys_l != nullptr && !keys_l->empty ())
+	{
+		std::vector<ed25519_unpacked_public_key const *> unpacked (size, nullptr);
+		uint64_t hits_l (0);
+		for (size_t i (0); i < size; ++i)
+		{
+			vban::public_key key;
+			std::copy (check_a.pub_keys[start_index + i], check_a.pub_keys[start_index + i] + key.bytes.size (), key.bytes.begin ());
+			auto existing (keys_l->find (key));
+			if (existing != keys_l->end ())
+			{
+				unpacked[i] = &existing->second;
+				++hits_l;
+			}
+		}
+		representative_keys->hits += hits_l;
+		representative_keys->misses += size - hits_l;
+		vban::validate_message_batch (check_a.messages + start_index, check_a.message_lengths + start_index, check_a.pub_keys + start_index, unpacked.data (), check_a.signatures + start_index, size, check_a.verifications + start_index);
+	}
+	else
+	{
+		vban::validate_message_batch (check_a.messages + start_index, check_a.message_lengths + start_index, check_a.pub_keys + start_index, check_a.signatures + start_index, size, check_a.verifications + start_index);
+	}
 	return std::all_of (check_a.verifications + start_index, check_a.verifications + start_index + size, [] (int verification) { return verification == 0 || verification == 1; });
 }
 
@@ -1,14 +1,28 @@
 #pragma once
 
+#include <vban/lib/locks.hpp>
+#include <vban/lib/numbers.hpp>
 #include <vban/lib/threading.hpp>
 #include <vban/lib/utility.hpp>
 
+#include <crypto/ed25519-donna/ed25519.h>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <array>
 #include <atomic>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace vban
 {
+class stat;
 class signature_check_set final
 {
 public:
@@ -25,11 +39,81 @@ public:
 	int * verifications;
 };
 
+/**
+ * Bounded cache of recently verified (message, public key, signature) triples.
+ * Only valid signatures are stored, keyed by a blake2b digest of the whole triple, so a hit can never accept a
+ * signature that was not verified before. Peers rebroadcasting the same votes and blocks then skip the curve math.
+ * @note This class is thread-safe, entries are spread over independently locked shards
+ */
+class signature_cache final
+{
+public:
+	signature_cache (size_t, vban::stat &);
+	/** Returns true if the triple identified by \p key_a was verified as valid before */
+	bool exists (vban::uint256_union const & key_a);
+	void insert (vban::uint256_union const & key_a);
+	/** Adds the hits and misses of a batch of lookups to the counters and stats */
+	void record (uint64_t hits_a, uint64_t misses_a);
+	size_t size ();
+	static vban::uint256_union key (unsigned char const * message_a, size_t length_a, unsigned char const * pub_key_a, unsigned char const * signature_a);
+
+	size_t const max_size;
+	std::atomic<uint64_t> hits{ 0 };
+	std::atomic<uint64_t> misses{ 0 };
+
+private:
+	class shard final
+	{
+	public:
+		// clang-format off
+		boost::multi_index_container<vban::uint256_union,
+		boost::multi_index::indexed_by<
+			boost::multi_index::sequenced<>,
+			boost::multi_index::hashed_unique<boost::multi_index::identity<vban::uint256_union>, std::hash<vban::uint256_union>>>>
+		entries;
+		// clang-format on
+		vban::mutex mutex{ mutex_identifier (mutexes::signature_cache) };
+	};
+	shard & shard_for (vban::uint256_union const &);
+	static size_t constexpr shard_count = 16;
+	std::array<shard, shard_count> shards;
+	vban::stat & stats;
+};
+
+std::unique_ptr<container_info_component> collect_container_info (signature_cache & signature_cache, std::string const & name);
+
+/**
+ * Public keys of high weight representatives with their curve points already decompressed.
+ * A few hundred principal representatives sign almost every vote, so verifying against a cached point saves a field
+ * square root per signature. The key set is replaced periodically by the rep crawler, readers share immutable snapshots.
+ * @note This class is thread-safe
+ */
+class representative_key_cache final
+{
+public:
+	using keys_t = std::unordered_map<vban::public_key, ed25519_unpacked_public_key>;
+	explicit representative_key_cache (size_t max_size = 1024);
+	/** Replaces the cached keys with the first max_size valid entries of \p keys_a, points already decompressed are reused */
+	void update (std::vector<vban::public_key> const & keys_a);
+	std::shared_ptr<keys_t const> keys () const;
+	size_t size () const;
+
+	size_t const max_size;
+	std::atomic<uint64_t> hits{ 0 };
+	std::atomic<uint64_t> misses{ 0 };
+
+private:
+	mutable vban::mutex mutex{ mutex_identifier (mutexes::representative_key_cache) };
+	std::shared_ptr<keys_t const> keys_m;
+};
+
+std::unique_ptr<container_info_component> collect_container_info (representative_key_cache & representative_key_cache, std::string const & name);
+
 /** Multi-threaded signature checker */
 class signature_checker final
 {
 public:
-	signature_checker (unsigned num_threads);
+	signature_checker (unsigned num_threads, vban::signature_cache * = nullptr, vban::representative_key_cache * = nullptr);
 	~signature_checker ();
 	void verify (signature_check_set &);
 	void stop ();
@@ -41,6 +125,8 @@ private:
 	std::atomic<int> tasks_remaining{ 0 };
 	std::atomic<bool> stopped{ false };
 	vban::thread_pool thread_pool;
+	vban::signature_cache * cache;
+	vban::representative_key_cache * representative_keys;
 
 	struct Task final
 	{
@@ -56,6 +142,8 @@ private:
 		std::atomic<size_t> pending;
 	};
 
+	void verify_impl (signature_check_set &);
+	void verify_cached (signature_check_set &);
 	bool verify_batch (const vban::signature_check_set & check_a, size_t index, size_t size);
 	void verify_async (vban::signature_check_set & check_a, size_t num_batches, std::promise<void> & promise);
 	bool single_threaded () const;
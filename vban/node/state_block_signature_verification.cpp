@@ -45,11 +45,11 @@ void vban::state_block_signature_verification::run (uint64_t state_block_signatu
 	vban::unique_lock<vban::mutex> lk (mutex);
 	while (!stopped)
 	{
-		if (!state_blocks.empty ())
+		if (!state_blocks.empty () || !local_blocks.empty ())
 		{
 			size_t const max_verification_batch (state_block_signature_verification_size != 0 ? state_block_signature_verification_size : vban::signature_checker::batch_size * (node_config.signature_checker_threads + 1));
 			active = true;
-			while (!state_blocks.empty () && !stopped)
+			while ((!state_blocks.empty () || !local_blocks.empty ()) && !stopped)
 			{
 				auto items = setup_items (max_verification_batch);
 				lk.unlock ();
@@ -78,7 +78,15 @@ void vban::state_block_signature_verification::add (vban::unchecked_info const &
 {
 	{
 		vban::lock_guard<vban::mutex> guard (mutex);
-		state_blocks.emplace_back (info_a);
+		// Wallet blocks go into the next verification batch instead of waiting behind queued network and bootstrap blocks
+		if (info_a.source == vban::block_source::local)
+		{
+			local_blocks.emplace_back (info_a);
+		}
+		else
+		{
+			state_blocks.emplace_back (info_a);
+		}
 	}
 	condition.notify_one ();
 }
@@ -86,24 +94,27 @@ void vban::state_block_signature_verification::add (vban::unchecked_info const &
 size_t vban::state_block_signature_verification::size ()
 {
 	vban::lock_guard<vban::mutex> guard (mutex);
-	return state_blocks.size ();
+	return state_blocks.size () + local_blocks.size ();
 }
 
 std::deque<vban::unchecked_info> vban::state_block_signature_verification::setup_items (size_t max_count)
 {
 	std::deque<vban::unchecked_info> items;
-	if (state_blocks.size () <= max_count)
+	if (local_blocks.empty () && state_blocks.size () <= max_count)
 	{
 		items.swap (state_blocks);
 	}
 	else
 	{
-		for (auto i (0); i < max_count; ++i)
+		// Local blocks first, each queue in arrival order
+		for (auto queue : { &local_blocks, &state_blocks })
 		{
-			items.push_back (state_blocks.front ());
-			state_blocks.pop_front ();
+			while (!queue->empty () && items.size () < max_count)
+			{
+				items.push_back (queue->front ());
+				queue->pop_front ();
+			}
 		}
-		debug_assert (!state_blocks.empty ());
 	}
 	return items;
 }
@@ -37,6 +37,8 @@ private:
 	bool stopped{ false };
 	bool active{ false };
 	std::deque<vban::unchecked_info> state_blocks;
+	/** Local blocks are verified ahead of state_blocks */
+	std::deque<vban::unchecked_info> local_blocks;
 	vban::condition_variable condition;
 	std::thread thread;
 
@@ -1,6 +1,7 @@
 #include <vban/lib/stats.hpp>
 #include <vban/lib/threading.hpp>
 #include <vban/node/network.hpp>
+#include <vban/node/node.hpp>
 #include <vban/node/nodeconfig.hpp>
 #include <vban/node/telemetry.hpp>
 #include <vban/node/transport/transport.hpp>
@@ -633,7 +634,7 @@ vban::telemetry_data vban::local_telemetry_data (vban::ledger const & ledger_a,
 	telemetry_data.bandwidth_cap = bandwidth_limit_a;
 	telemetry_data.protocol_version = network_params_a.protocol.protocol_version;
 	telemetry_data.uptime = std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - statup_time_a).count ();
-	telemetry_data.unchecked_count = ledger_a.store.unchecked_count (ledger_a.store.tx_begin_read ());
+	telemetry_data.unchecked_count = network_a.node.unchecked.count (ledger_a.store.tx_begin_read ());
 	telemetry_data.genesis_block = network_params_a.ledger.genesis_hash;
 	telemetry_data.peer_count = vban::narrow_cast<decltype (telemetry_data.peer_count)> (network_a.size ());
 	telemetry_data.account_count = ledger_a.cache.account_count;
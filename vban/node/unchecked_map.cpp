@@ -0,0 +1,169 @@
+#include <vban/node/unchecked_map.hpp>
+#include <vban/secure/blockstore.hpp>
+
+size_t constexpr vban::unchecked_map::entry_size;
+
+vban::unchecked_map::unchecked_map (vban::block_store & store_a, size_t memory_limit_a) :
+	store (store_a),
+	memory_limit (memory_limit_a)
+{
+	if (!store.init_error ())
+	{
+		// Entries left by a previous run or by a version without the memory index
+		disk_used_m = store.unchecked_count (store.tx_begin_read ()) > 0;
+	}
+}
+
+void vban::unchecked_map::put (vban::write_transaction const & transaction_a, vban::unchecked_key const & key_a, vban::unchecked_info const & info_a)
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	auto existing (memory.find (key_a));
+	if (existing != memory.end ())
+	{
+		existing->second = info_a;
+	}
+	else if (memory.size () * entry_size < memory_limit && !(disk_used_m && store.unchecked_exists (transaction_a, key_a)))
+	{
+		memory.emplace (key_a, info_a);
+	}
+	else
+	{
+		store.unchecked_put (transaction_a, key_a, info_a);
+		disk_used_m = true;
+	}
+}
+
+std::vector<vban::unchecked_info> vban::unchecked_map::get (vban::transaction const & transaction_a, vban::block_hash const & dependency_a)
+{
+	std::vector<vban::unchecked_info> result;
+	{
+		vban::lock_guard<vban::mutex> guard (mutex);
+		for (auto i (memory.lower_bound (vban::unchecked_key (dependency_a, 0))), n (memory.end ()); i != n && i->first.previous == dependency_a; ++i)
+		{
+			result.push_back (i->second);
+		}
+	}
+	if (disk_used_m)
+	{
+		auto disk (store.unchecked_get (transaction_a, dependency_a));
+		result.insert (result.end (), disk.begin (), disk.end ());
+	}
+	return result;
+}
+
+bool vban::unchecked_map::exists (vban::transaction const & transaction_a, vban::unchecked_key const & key_a)
+{
+	{
+		vban::lock_guard<vban::mutex> guard (mutex);
+		if (memory.count (key_a) > 0)
+		{
+			return true;
+		}
+	}
+	return disk_used_m && store.unchecked_exists (transaction_a, key_a);
+}
+
+void vban::unchecked_map::del (vban::write_transaction const & transaction_a, vban::unchecked_key const & key_a)
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	if (memory.erase (key_a) == 0 && disk_used_m && store.unchecked_exists (transaction_a, key_a))
+	{
+		store.unchecked_del (transaction_a, key_a);
+	}
+}
+
+void vban::unchecked_map::clear (vban::write_transaction const & transaction_a)
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	memory.clear ();
+	store.unchecked_clear (transaction_a);
+	disk_used_m = false;
+}
+
+size_t vban::unchecked_map::count (vban::transaction const & transaction_a)
+{
+	auto result (memory_size ());
+	if (disk_used_m)
+	{
+		result += store.unchecked_count (transaction_a);
+	}
+	return result;
+}
+
+bool vban::unchecked_map::memory_next (vban::unchecked_key const & key_a, bool inclusive_a, std::pair<vban::unchecked_key, vban::unchecked_info> & result_a)
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	auto existing (inclusive_a ? memory.lower_bound (key_a) : memory.upper_bound (key_a));
+	auto found (existing != memory.end ());
+	if (found)
+	{
+		result_a = *existing;
+	}
+	return found;
+}
+
+void vban::unchecked_map::for_each (vban::transaction const & transaction_a, vban::unchecked_key const & start_a, std::function<bool (vban::unchecked_key const &, vban::unchecked_info const &)> const & action_a)
+{
+	auto disk_i (disk_used_m ? store.unchecked_begin (transaction_a, start_a) : store.unchecked_end ());
+	auto disk_n (store.unchecked_end ());
+	// The memory index is looked up again after every entry so the lock is never held while calling back
+	std::pair<vban::unchecked_key, vban::unchecked_info> memory_item;
+	auto memory_valid (memory_next (start_a, true, memory_item));
+	auto proceed (true);
+	while (proceed && (memory_valid || disk_i != disk_n))
+	{
+		if (memory_valid && (disk_i == disk_n || !(vban::unchecked_key (disk_i->first) < memory_item.first)))
+		{
+			if (disk_i != disk_n && vban::unchecked_key (disk_i->first) == memory_item.first)
+			{
+				++disk_i;
+			}
+			proceed = action_a (memory_item.first, memory_item.second);
+			memory_valid = memory_next (memory_item.first, false, memory_item);
+		}
+		else
+		{
+			proceed = action_a (disk_i->first, disk_i->second);
+			++disk_i;
+		}
+	}
+}
+
+std::deque<vban::unchecked_info> vban::unchecked_map::release (vban::write_transaction const & transaction_a, vban::hash_or_account const & dependency_a, size_t max_a)
+{
+	std::deque<vban::unchecked_info> result;
+	std::deque<vban::block_hash> dependencies{ dependency_a.hash };
+	// Breadth first, a dependent block is only reached through the block it waits on so it is always queued after it
+	// Every dependent of a followed block is taken, so blocks left behind wait on a released block and not on one already written
+	while (!dependencies.empty () && (result.empty () || result.size () < max_a))
+	{
+		auto dependency (dependencies.front ());
+		dependencies.pop_front ();
+		for (auto & info : get (transaction_a, dependency))
+		{
+			auto hash (info.block->hash ());
+			del (transaction_a, vban::unchecked_key (dependency, hash));
+			dependencies.push_back (hash);
+			result.push_back (std::move (info));
+		}
+	}
+	return result;
+}
+
+size_t vban::unchecked_map::memory_size ()
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	return memory.size ();
+}
+
+bool vban::unchecked_map::disk_used () const
+{
+	return disk_used_m;
+}
+
+std::unique_ptr<vban::container_info_component> vban::collect_container_info (unchecked_map & unchecked_map, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "memory", unchecked_map.memory_size (), vban::unchecked_map::entry_size }));
+	return composite;
+}
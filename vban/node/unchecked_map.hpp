@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vban/lib/locks.hpp>
+#include <vban/lib/utility.hpp>
+#include <vban/secure/common.hpp>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace vban
+{
+class block_store;
+class transaction;
+class write_transaction;
+
+/**
+ * Blocks waiting on a missing dependency (previous block, source block or epoch open pending entry), indexed by that dependency.
+ * Entries are kept in memory up to a budget and only spill to the unchecked table once it is exceeded, so out of order
+ * bootstrap blocks normally cost no database writes or reads. The table is only consulted while it may hold entries.
+ * Entries held in memory are not persisted, blocks lost on restart are requested again by bootstrap.
+ */
+class unchecked_map final
+{
+public:
+	unchecked_map (vban::block_store &, size_t memory_limit_a);
+	void put (vban::write_transaction const &, vban::unchecked_key const &, vban::unchecked_info const &);
+	/** Blocks directly waiting on \p dependency_a */
+	std::vector<vban::unchecked_info> get (vban::transaction const &, vban::block_hash const & dependency_a);
+	bool exists (vban::transaction const &, vban::unchecked_key const &);
+	void del (vban::write_transaction const &, vban::unchecked_key const &);
+	void clear (vban::write_transaction const &);
+	size_t count (vban::transaction const &);
+	/**
+	 * Visits entries from \p start_a in key order, merging memory and disk
+	 * @param action_a Returns false to stop iterating
+	 */
+	void for_each (vban::transaction const &, vban::unchecked_key const & start_a, std::function<bool (vban::unchecked_key const &, vban::unchecked_info const &)> const & action_a);
+	/**
+	 * Removes and returns every block waiting on \p dependency_a together with the blocks waiting on those, transitively.
+	 * Blocks are ordered so each one comes after the block it depends on, letting the block processor insert whole chains in one pass.
+	 * Dependents stop being followed once \p max_a blocks are released, the rest are released when the returned blocks are processed.
+	 * Direct dependents of \p dependency_a are always released.
+	 */
+	std::deque<vban::unchecked_info> release (vban::write_transaction const &, vban::hash_or_account const & dependency_a, size_t max_a);
+	size_t memory_size ();
+	/** True while the unchecked table may hold entries */
+	bool disk_used () const;
+	/** Estimated memory taken by one entry */
+	static size_t constexpr entry_size = sizeof (vban::unchecked_key) + sizeof (vban::unchecked_info) + sizeof (vban::state_block) + 8 * sizeof (void *);
+
+private:
+	bool memory_next (vban::unchecked_key const &, bool inclusive_a, std::pair<vban::unchecked_key, vban::unchecked_info> & result_a);
+
+	vban::block_store & store;
+	size_t const memory_limit;
+	vban::mutex mutex{ mutex_identifier (mutexes::unchecked_map) };
+	std::map<vban::unchecked_key, vban::unchecked_info> memory;
+	std::atomic<bool> disk_used_m{ false };
+};
+
+std::unique_ptr<vban::container_info_component> collect_container_info (unchecked_map & unchecked_map, std::string const & name);
+}
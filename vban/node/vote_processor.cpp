@@ -15,6 +15,8 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+
 vban::vote_processor::vote_processor (vban::signature_checker & checker_a, vban::active_transactions & active_a, vban::node_observers & observers_a, vban::stat & stats_a, vban::node_config & config_a, vban::node_flags & flags_a, vban::logger_mt & logger_a, vban::online_reps & online_reps_a, vban::rep_crawler & rep_crawler_a, vban::ledger & ledger_a, vban::network_params & network_params_a) :
 	checker (checker_a),
 	active (active_a),
@@ -27,36 +29,31 @@ vban::vote_processor::vote_processor (vban::signature_checker & checker_a, vban:
 	ledger (ledger_a),
 	network_params (network_params_a),
 	max_votes (flags_a.vote_processor_capacity),
-	started (false),
-	stopped (false),
-	is_active (false),
-	thread ([this] () {
-		vban::thread_role::set (vban::thread_role::name::vote_processing);
-		process_loop ();
-	})
+	shards (std::max<unsigned> (1, config_a.vote_processor_threads))
 {
-	vban::unique_lock<vban::mutex> lock (mutex);
-	condition.wait (lock, [&started = started] { return started; });
+	threads.reserve (shards.size ());
+	for (auto & shard_l : shards)
+	{
+		threads.emplace_back ([this, &shard_l] () {
+			vban::thread_role::set (vban::thread_role::name::vote_processing);
+			process_loop (shard_l);
+		});
+	}
 }
 
-void vban::vote_processor::process_loop ()
+void vban::vote_processor::process_loop (shard & shard_a)
 {
 	vban::timer<std::chrono::milliseconds> elapsed;
 	bool log_this_iteration;
 
 	vban::unique_lock<vban::mutex> lock (mutex);
-	started = true;
-
-	lock.unlock ();
-	condition.notify_all ();
-	lock.lock ();
-
 	while (!stopped)
 	{
-		if (!votes.empty ())
+		if (!shard_a.votes.empty ())
 		{
-			decltype (votes) votes_l;
-			votes_l.swap (votes);
+			vote_queue votes_l;
+			votes_l.swap (shard_a.votes);
+			queued -= votes_l.size ();
 
 			log_this_iteration = false;
 			if (config.logging.network_logging () && votes_l.size () > 50)
@@ -68,15 +65,15 @@ void vban::vote_processor::process_loop ()
 				log_this_iteration = true;
 				elapsed.restart ();
 			}
-			is_active = true;
+			shard_a.active = true;
 			lock.unlock ();
 			verify_votes (votes_l);
 			lock.lock ();
-			is_active = false;
+			shard_a.active = false;
+			total_processed += votes_l.size ();
 
 			lock.unlock ();
 			condition.notify_all ();
-			total_processed += votes_l.size ();
 			lock.lock ();
 
 			if (log_this_iteration && elapsed.stop () > std::chrono::milliseconds (100))
@@ -86,7 +83,7 @@ void vban::vote_processor::process_loop ()
 		}
 		else
 		{
-			condition.wait (lock);
+			shard_a.condition.wait (lock);
 		}
 	}
 }
@@ -99,30 +96,32 @@ bool vban::vote_processor::vote (std::shared_ptr<vban::vote> const & vote_a, std
 	if (!stopped)
 	{
 		// Level 0 (< 0.1%)
-		if (votes.size () < 6.0 / 9.0 * max_votes)
+		if (queued < 6.0 / 9.0 * max_votes)
 		{
 			process = true;
 		}
 		// Level 1 (0.1-1%)
-		else if (votes.size () < 7.0 / 9.0 * max_votes)
+		else if (queued < 7.0 / 9.0 * max_votes)
 		{
 			process = (representatives_1.find (vote_a->account) != representatives_1.end ());
 		}
 		// Level 2 (1-5%)
-		else if (votes.size () < 8.0 / 9.0 * max_votes)
+		else if (queued < 8.0 / 9.0 * max_votes)
 		{
 			process = (representatives_2.find (vote_a->account) != representatives_2.end ());
 		}
 		// Level 3 (> 5%)
-		else if (votes.size () < max_votes)
+		else if (queued < max_votes)
 		{
 			process = (representatives_3.find (vote_a->account) != representatives_3.end ());
 		}
 		if (process)
 		{
-			votes.emplace_back (vote_a, channel_a);
+			auto & shard_l (shard_for (vote_a->account));
+			shard_l.votes.emplace_back (vote_a, channel_a);
+			++queued;
 			lock.unlock ();
-			condition.notify_all ();
+			shard_l.condition.notify_one ();
 			// Lock no longer required
 		}
 		else
@@ -133,7 +132,7 @@ bool vban::vote_processor::vote (std::shared_ptr<vban::vote> const & vote_a, std
 	return !process;
 }
 
-void vban::vote_processor::verify_votes (decltype (votes) const & votes_a)
+void vban::vote_processor::verify_votes (vote_queue const & votes_a)
 {
 	auto size (votes_a.size ());
 	std::vector<unsigned char const *> messages;
@@ -209,17 +208,23 @@ void vban::vote_processor::stop ()
 		vban::lock_guard<vban::mutex> lock (mutex);
 		stopped = true;
 	}
-	condition.notify_all ();
-	if (thread.joinable ())
+	for (auto & shard_l : shards)
 	{
-		thread.join ();
+		shard_l.condition.notify_all ();
+	}
+	for (auto & thread : threads)
+	{
+		if (thread.joinable ())
+		{
+			thread.join ();
+		}
 	}
 }
 
 void vban::vote_processor::flush ()
 {
 	vban::unique_lock<vban::mutex> lock (mutex);
-	while (is_active || !votes.empty ())
+	while (any_active () || queued != 0)
 	{
 		condition.wait (lock);
 	}
@@ -228,7 +233,7 @@ void vban::vote_processor::flush ()
 void vban::vote_processor::flush_active ()
 {
 	vban::unique_lock<vban::mutex> lock (mutex);
-	while (is_active)
+	while (any_active ())
 	{
 		condition.wait (lock);
 	}
@@ -237,13 +242,24 @@ void vban::vote_processor::flush_active ()
 size_t vban::vote_processor::size ()
 {
 	vban::lock_guard<vban::mutex> guard (mutex);
-	return votes.size ();
+	return queued;
 }
 
 bool vban::vote_processor::empty ()
 {
 	vban::lock_guard<vban::mutex> guard (mutex);
-	return votes.empty ();
+	return queued == 0;
+}
+
+vban::vote_processor::shard & vban::vote_processor::shard_for (vban::account const & account_a)
+{
+	// Accounts are public keys, any byte is uniformly distributed
+	return shards[account_a.bytes[0] % shards.size ()];
+}
+
+bool vban::vote_processor::any_active () const
+{
+	return std::any_of (shards.begin (), shards.end (), [] (auto const & shard_a) { return shard_a.active; });
 }
 
 bool vban::vote_processor::half_full ()
@@ -290,14 +306,14 @@ std::unique_ptr<vban::container_info_component> vban::collect_container_info (vo
 
 	{
 		vban::lock_guard<vban::mutex> guard (vote_processor.mutex);
-		votes_count = vote_processor.votes.size ();
+		votes_count = vote_processor.queued;
 		representatives_1_count = vote_processor.representatives_1.size ();
 		representatives_2_count = vote_processor.representatives_2.size ();
 		representatives_3_count = vote_processor.representatives_3.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (decltype (vote_processor.votes)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (vban::vote_processor::vote_queue::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1_count, sizeof (decltype (vote_processor.representatives_1)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2_count, sizeof (decltype (vote_processor.representatives_2)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3_count, sizeof (decltype (vote_processor.representatives_3)::value_type) }));
@@ -9,6 +9,7 @@
 #include <mutex>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace vban
 {
@@ -51,7 +52,18 @@ public:
 	std::atomic<uint64_t> total_processed{ 0 };
 
 private:
-	void process_loop ();
+	using vote_queue = std::deque<std::pair<std::shared_ptr<vban::vote>, std::shared_ptr<vban::transport::channel>>>;
+	/** Votes of a representative always go to the same shard so they are applied in arrival order */
+	class shard final
+	{
+	public:
+		vote_queue votes;
+		bool active{ false };
+		vban::condition_variable condition;
+	};
+	void process_loop (shard &);
+	shard & shard_for (vban::account const &);
+	bool any_active () const;
 
 	vban::signature_checker & checker;
 	vban::active_transactions & active;
@@ -64,17 +76,17 @@ private:
 	vban::ledger & ledger;
 	vban::network_params & network_params;
 	size_t max_votes;
-	std::deque<std::pair<std::shared_ptr<vban::vote>, std::shared_ptr<vban::transport::channel>>> votes;
+	std::vector<shard> shards;
+	/** Votes queued over all shards */
+	size_t queued{ 0 };
 	/** Representatives levels for random early detection */
 	std::unordered_set<vban::account> representatives_1;
 	std::unordered_set<vban::account> representatives_2;
 	std::unordered_set<vban::account> representatives_3;
 	vban::condition_variable condition;
 	vban::mutex mutex{ mutex_identifier (mutexes::vote_processor) };
-	bool started;
-	bool stopped;
-	bool is_active;
-	std::thread thread;
+	bool stopped{ false };
+	std::vector<std::thread> threads;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (vote_processor & vote_processor, std::string const & name);
 	friend class vote_processor_weights_Test;
@@ -1175,10 +1175,10 @@ bool vban::wallet::search_pending (vban::transaction const & wallet_transaction_
 		{
 			auto block_transaction (wallets.node.store.tx_begin_read ());
 			vban::account const & account (i->first);
-			// Don't search pending for watch-only accounts
-			if (!vban::wallet_value (i->second).key.is_zero ())
+			// Don't search pending for watch-only accounts, or accounts with nothing above the receive minimum
+			if (!vban::wallet_value (i->second).key.is_zero () && !wallets.node.ledger.pending_summary_excludes (block_transaction, account, wallets.node.config.receive_minimum))
 			{
-				for (auto j (wallets.node.store.pending_begin (block_transaction, vban::pending_key (account, 0))), k (wallets.node.store.pending_end ()); j != k && vban::pending_key (j->first).account == account; ++j)
+				for (auto j (wallets.node.store.pending_begin (block_transaction, account)), k (wallets.node.store.pending_end ()); j != k && vban::pending_key (j->first).account == account; ++j)
 				{
 					vban::pending_key key (j->first);
 					auto hash (key.hash);
@@ -1243,7 +1243,7 @@ uint32_t vban::wallet::deterministic_check (vban::transaction const & transactio
 		else
 		{
 			// Check if there are pending blocks for account
-			for (auto ii (wallets.node.store.pending_begin (block_transaction, vban::pending_key (pair.pub, 0))), nn (wallets.node.store.pending_end ()); ii != nn && vban::pending_key (ii->first).account == pair.pub; ++ii)
+			for (auto ii (wallets.node.store.pending_begin (block_transaction, pair.pub)), nn (wallets.node.store.pending_end ()); ii != nn && vban::pending_key (ii->first).account == pair.pub; ++ii)
 			{
 				index = i;
 				n = i + 64 + (i / 64);
@@ -1,6 +1,7 @@
 #include <vban/lib/config.hpp>
 #include <vban/lib/utility.hpp>
 #include <vban/node/write_database_queue.hpp>
+#include <vban/secure/blockstore.hpp>
 
 #include <algorithm>
 
@@ -50,7 +51,7 @@ void vban::write_guard::release ()
 	owns = false;
 }
 
-vban::write_database_queue::write_database_queue (bool use_noops_a) :
+vban::write_database_queue::write_database_queue (bool use_noops_a, bool group_commit_a) :
 	guard_finish_callback ([use_noops_a, &queue = queue, &mutex = mutex, &cv = cv] () {
 		if (!use_noops_a)
 		{
@@ -61,7 +62,8 @@ vban::write_database_queue::write_database_queue (bool use_noops_a) :
 			cv.notify_all ();
 		}
 	}),
-	use_noops (use_noops_a)
+	use_noops (use_noops_a),
+	group_commit (group_commit_a && !use_noops_a)
 {
 }
 
@@ -85,6 +87,7 @@ vban::write_guard vban::write_database_queue::wait (vban::writer writer)
 		cv.wait (lk);
 	}
 
+	++acquired_m;
 	return write_guard (guard_finish_callback);
 }
 
@@ -123,7 +126,131 @@ bool vban::write_database_queue::process (vban::writer writer)
 	return result;
 }
 
+size_t vban::write_database_queue::waiters ()
+{
+	if (use_noops)
+	{
+		return 0;
+	}
+
+	vban::lock_guard<vban::mutex> guard (mutex);
+	return queue.empty () ? 0 : queue.size () - 1;
+}
+
 vban::write_guard vban::write_database_queue::pop ()
 {
+	++acquired_m;
 	return write_guard (guard_finish_callback);
 }
+
+bool vban::write_database_queue::append (vban::writer writer_a, std::function<void (vban::write_transaction &)> const & action_a)
+{
+	if (!group_commit)
+	{
+		return false;
+	}
+
+	vban::unique_lock<vban::mutex> lk (mutex);
+	if (!group_open)
+	{
+		return false;
+	}
+	// The writer owning the group is at the front, a writer queued behind it no longer needs its place
+	auto existing = std::find (queue.begin (), queue.end (), writer_a);
+	if (existing == queue.begin ())
+	{
+		return false;
+	}
+	if (existing != queue.end ())
+	{
+		queue.erase (existing);
+	}
+	auto entry (std::make_shared<group_entry> ());
+	entry->action = action_a;
+	group_entries.push_back (entry);
+	while (!entry->done)
+	{
+		cv.wait (lk);
+	}
+	++appended_m;
+	return true;
+}
+
+void vban::write_database_queue::group_begin ()
+{
+	if (group_commit)
+	{
+		vban::lock_guard<vban::mutex> guard (mutex);
+		debug_assert (!group_open);
+		group_open = true;
+	}
+}
+
+size_t vban::write_database_queue::group_commit_transaction (vban::write_transaction & transaction_a)
+{
+	std::deque<std::shared_ptr<group_entry>> committed;
+	if (group_commit)
+	{
+		vban::unique_lock<vban::mutex> lk (mutex);
+		// Appended writes may take a while, writers becoming ready meanwhile still join this group
+		while (!group_entries.empty ())
+		{
+			auto entries (std::move (group_entries));
+			group_entries.clear ();
+			lk.unlock ();
+			for (auto const & entry : entries)
+			{
+				entry->action (transaction_a);
+			}
+			committed.insert (committed.end (), entries.begin (), entries.end ());
+			lk.lock ();
+		}
+		group_open = false;
+	}
+	transaction_a.commit ();
+	if (!committed.empty ())
+	{
+		{
+			vban::lock_guard<vban::mutex> guard (mutex);
+			for (auto const & entry : committed)
+			{
+				entry->done = true;
+			}
+		}
+		cv.notify_all ();
+	}
+	return committed.size ();
+}
+
+uint64_t vban::write_database_queue::acquired () const
+{
+	return acquired_m;
+}
+
+uint64_t vban::write_database_queue::appended () const
+{
+	return appended_m;
+}
+
+vban::write_group::write_group (vban::write_database_queue & queue_a, vban::write_transaction & transaction_a) :
+	queue (queue_a),
+	transaction (transaction_a)
+{
+	queue.group_begin ();
+}
+
+vban::write_group::~write_group ()
+{
+	commit ();
+}
+
+size_t vban::write_group::commit ()
+{
+	size_t result (0);
+	if (!committed)
+	{
+		committed = true;
+		result = queue.group_commit_transaction (transaction);
+	}
+	return result;
+}
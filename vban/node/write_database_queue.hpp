@@ -2,13 +2,17 @@
 
 #include <vban/lib/locks.hpp>
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 
 namespace vban
 {
+class write_transaction;
+
 /** Distinct areas write locking is done, order is irrelevant */
 enum class writer
 {
@@ -38,7 +42,7 @@ private:
 class write_database_queue final
 {
 public:
-	write_database_queue (bool use_noops_a);
+	write_database_queue (bool use_noops_a, bool group_commit_a = false);
 	/** Blocks until we are at the head of the queue */
 	write_guard wait (vban::writer writer);
 
@@ -48,14 +52,67 @@ public:
 	/** Returns true if this writer is anywhere in the queue. Currently only used in tests */
 	bool contains (vban::writer writer);
 
+	/** Number of writers queued behind the one currently at the front */
+	size_t waiters ();
+
 	/** Doesn't actually pop anything until the returned write_guard is out of scope */
 	write_guard pop ();
 
+	/**
+	 * Group commit: runs action_a in the write transaction of the writer holding the queue, if it opened a write_group,
+	 * and returns once that transaction has been committed. The writer gives up its place in the queue.
+	 * Returns false when group commit is disabled or no group is open, the caller should then wait and write on its own.
+	 */
+	bool append (vban::writer writer_a, std::function<void (vban::write_transaction &)> const & action_a);
+
+	/** Number of times a writer was given the queue */
+	uint64_t acquired () const;
+
+	/** Number of writes appended to another writer's transaction instead of committing their own */
+	uint64_t appended () const;
+
 private:
+	class group_entry final
+	{
+	public:
+		std::function<void (vban::write_transaction &)> action;
+		bool done{ false };
+	};
+	void group_begin ();
+	size_t group_commit_transaction (vban::write_transaction &);
+
 	std::deque<vban::writer> queue;
 	vban::mutex mutex;
 	vban::condition_variable cv;
 	std::function<void ()> guard_finish_callback;
 	bool use_noops;
+	bool group_commit;
+	bool group_open{ false };
+	std::deque<std::shared_ptr<group_entry>> group_entries;
+	std::atomic<uint64_t> acquired_m{ 0 };
+	std::atomic<uint64_t> appended_m{ 0 };
+
+	friend class write_group;
+};
+
+/**
+ * Lets writers that become ready while transaction_a is open append their writes to it, see write_database_queue::append.
+ * Appended writes run on the thread owning the group right before it commits, so the whole group costs one commit and fsync.
+ * Must be created while holding the queue, does nothing beyond committing when group commit is disabled.
+ */
+class write_group final
+{
+public:
+	write_group (vban::write_database_queue &, vban::write_transaction &);
+	~write_group ();
+	write_group (write_group const &) = delete;
+	write_group & operator= (write_group const &) = delete;
+	/** Runs the appended writes, commits and releases their writers. Returns the number of appended writes */
+	size_t commit ();
+
+private:
+	vban::write_database_queue & queue;
+	vban::write_transaction & transaction;
+	bool committed{ false };
 };
 }
@@ -1579,6 +1579,81 @@ TEST (rpc, account_history)
 	}
 }
 
+TEST (rpc, account_history_index)
+{
+	vban::system system;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.account_history_index = true;
+	auto node0 = add_ipc_enabled_node (system, node_config);
+	ASSERT_TRUE (node0->ledger.account_heights_enabled);
+	vban::genesis genesis;
+	std::vector<vban::block_hash> hashes{ genesis.hash () };
+	{
+		auto transaction (node0->store.tx_begin_write ());
+		for (auto i (1); i < 4; ++i)
+		{
+			vban::state_block send (vban::genesis_account, hashes.back (), vban::genesis_account, vban::genesis_amount - i * vban::Gxrb_ratio, vban::keypair ().pub, vban::dev_genesis_key.prv, vban::dev_genesis_key.pub, *node0->work_generate_blocking (hashes.back ()));
+			ASSERT_EQ (vban::process_result::progress, node0->ledger.process (transaction, send).code);
+			hashes.push_back (send.hash ());
+		}
+	}
+	scoped_io_thread_name_change scoped_thread_name_io;
+	vban::node_rpc_config node_rpc_config;
+	vban::ipc::ipc_server ipc_server (*node0, node_rpc_config);
+	vban::rpc_config rpc_config (vban::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node0->config.ipc_config.transport_tcp.port;
+	vban::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	vban::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	// The offset is skipped by seeking the index
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "account_history");
+		request.put ("account", vban::genesis_account.to_account ());
+		request.put ("offset", 2);
+		request.put ("count", 1);
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		auto & history_node (response.json.get_child ("history"));
+		ASSERT_EQ (1, history_node.size ());
+		ASSERT_EQ ("2", history_node.begin ()->second.get<std::string> ("height"));
+		ASSERT_EQ (hashes[1].to_string (), history_node.begin ()->second.get<std::string> ("hash"));
+		ASSERT_EQ (genesis.hash ().to_string (), response.json.get<std::string> ("previous"));
+	}
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "account_history");
+		request.put ("account", vban::genesis_account.to_account ());
+		request.put ("reverse", true);
+		request.put ("offset", 1);
+		request.put ("count", 2);
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		std::vector<std::string> heights;
+		for (auto & entry : response.json.get_child ("history"))
+		{
+			heights.push_back (entry.second.get<std::string> ("height"));
+		}
+		ASSERT_EQ ((std::vector<std::string>{ "2", "3" }), heights);
+		ASSERT_EQ (hashes[3].to_string (), response.json.get<std::string> ("next"));
+	}
+	// An offset past the end of the chain gives an empty page
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "account_history");
+		request.put ("account", vban::genesis_account.to_account ());
+		request.put ("offset", 10);
+		request.put ("count", 10);
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_TRUE (response.json.get_child ("history").empty ());
+		ASSERT_FALSE (response.json.get_optional<std::string> ("previous").is_initialized ());
+	}
+}
+
 TEST (rpc, history_count)
 {
 	vban::system system;
@@ -4069,6 +4144,62 @@ TEST (rpc, accounts_pending)
 	check_block_response_count (system, rpc, request, 1);
 }
 
+TEST (rpc, accounts_pending_summary)
+{
+	vban::system system;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.pending_summary_index = true;
+	auto & node1 = *add_ipc_enabled_node (system, node_config);
+	ASSERT_TRUE (node1.ledger.pending_summary_enabled);
+	vban::keypair key1;
+	vban::block_builder builder;
+	auto send1 = builder.state ()
+				 .account (vban::genesis_account)
+				 .previous (node1.latest (vban::genesis_account))
+				 .representative (vban::genesis_account)
+				 .balance (vban::genesis_amount - 100)
+				 .link (key1.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*node1.work_generate_blocking (node1.latest (vban::genesis_account)))
+				 .build ();
+	ASSERT_EQ (vban::process_result::progress, node1.process (*send1).code);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	vban::node_rpc_config node_rpc_config;
+	vban::ipc::ipc_server ipc_server (node1, node_rpc_config);
+	vban::rpc_config rpc_config (vban::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node1.config.ipc_config.transport_tcp.port;
+	vban::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	vban::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "accounts_pending");
+	boost::property_tree::ptree entry;
+	boost::property_tree::ptree peers_l;
+	entry.put ("", key1.pub.to_account ());
+	peers_l.push_back (std::make_pair ("", entry));
+	request.add_child ("accounts", peers_l);
+	request.put ("count", "100");
+	request.put ("include_only_confirmed", "false");
+	// The summary proves nothing reaches the threshold, the account is still listed
+	request.put ("threshold", "101");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ (0, response.json.get_child ("blocks").get_child (key1.pub.to_account ()).size ());
+	}
+	request.put ("threshold", "100");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		auto & blocks (response.json.get_child ("blocks").get_child (key1.pub.to_account ()));
+		ASSERT_EQ (1, blocks.size ());
+		ASSERT_EQ (send1->hash ().to_string (), blocks.begin ()->first);
+		ASSERT_EQ ("100", blocks.begin ()->second.get<std::string> (""));
+	}
+}
+
 TEST (rpc, blocks)
 {
 	vban::system system;
@@ -4642,6 +4773,96 @@ TEST (rpc, delegators_count)
 	ASSERT_EQ ("2", count);
 }
 
+TEST (rpc, delegators_index)
+{
+	vban::system system;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.delegators_index = true;
+	auto & node1 = *add_ipc_enabled_node (system, node_config);
+	ASSERT_TRUE (node1.ledger.delegators_enabled);
+	// Built in the background after the node starts
+	ASSERT_TIMELY (5s, node1.store.delegators_complete (node1.store.tx_begin_read ()));
+	vban::keypair key1;
+	vban::keypair key2;
+	vban::block_builder builder;
+	auto send1 = builder.state ()
+				 .account (vban::genesis_account)
+				 .previous (node1.latest (vban::genesis_account))
+				 .representative (vban::genesis_account)
+				 .balance (vban::genesis_amount - 100)
+				 .link (key1.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*node1.work_generate_blocking (node1.latest (vban::genesis_account)))
+				 .build ();
+	auto send2 = builder.state ()
+				 .account (vban::genesis_account)
+				 .previous (send1->hash ())
+				 .representative (vban::genesis_account)
+				 .balance (vban::genesis_amount - 200)
+				 .link (key2.pub)
+				 .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+				 .work (*node1.work_generate_blocking (send1->hash ()))
+				 .build ();
+	auto open1 = builder.state ()
+				 .account (key1.pub)
+				 .previous (0)
+				 .representative (vban::genesis_account)
+				 .balance (100)
+				 .link (send1->hash ())
+				 .sign (key1.prv, key1.pub)
+				 .work (*node1.work_generate_blocking (key1.pub))
+				 .build ();
+	auto open2 = builder.state ()
+				 .account (key2.pub)
+				 .previous (0)
+				 .representative (vban::genesis_account)
+				 .balance (100)
+				 .link (send2->hash ())
+				 .sign (key2.prv, key2.pub)
+				 .work (*node1.work_generate_blocking (key2.pub))
+				 .build ();
+	ASSERT_EQ (vban::process_result::progress, node1.process (*send1).code);
+	ASSERT_EQ (vban::process_result::progress, node1.process (*send2).code);
+	ASSERT_EQ (vban::process_result::progress, node1.process (*open1).code);
+	ASSERT_EQ (vban::process_result::progress, node1.process (*open2).code);
+	std::vector<vban::account> accounts{ vban::genesis_account, key1.pub, key2.pub };
+	std::sort (accounts.begin (), accounts.end ());
+	scoped_io_thread_name_change scoped_thread_name_io;
+	vban::node_rpc_config node_rpc_config;
+	vban::ipc::ipc_server ipc_server (node1, node_rpc_config);
+	vban::rpc_config rpc_config (vban::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node1.config.ipc_config.transport_tcp.port;
+	vban::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	vban::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "delegators_count");
+		request.put ("account", vban::genesis_account.to_account ());
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ ("3", response.json.get<std::string> ("count"));
+	}
+	// Pages are ordered by account and resume after the start account
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "delegators");
+		request.put ("account", vban::genesis_account.to_account ());
+		request.put ("count", 2);
+		request.put ("start", accounts[0].to_account ());
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		std::vector<std::string> delegators;
+		for (auto & delegator : response.json.get_child ("delegators"))
+		{
+			delegators.push_back (delegator.first);
+		}
+		ASSERT_EQ ((std::vector<std::string>{ accounts[1].to_account (), accounts[2].to_account () }), delegators);
+	}
+}
+
 TEST (rpc, account_info)
 {
 	vban::system system;
@@ -6412,14 +6633,14 @@ TEST (rpc, unchecked_clear)
 	node.block_processor.flush ();
 	boost::property_tree::ptree request;
 	{
-		ASSERT_EQ (node.store.unchecked_count (node.store.tx_begin_read ()), 1);
+		ASSERT_EQ (node.unchecked.count (node.store.tx_begin_read ()), 1);
 	}
 	request.put ("action", "unchecked_clear");
 	test_response response (request, rpc.config.port, system.io_ctx);
 	ASSERT_TIMELY (5s, response.status != 0);
 	ASSERT_EQ (200, response.status);
 
-	ASSERT_TIMELY (10s, node.store.unchecked_count (node.store.tx_begin_read ()) == 0);
+	ASSERT_TIMELY (10s, node.unchecked.count (node.store.tx_begin_read ()) == 0);
 }
 
 TEST (rpc, unopened)
@@ -6934,6 +7155,60 @@ TEST (rpc, database_txn_tracker)
 	thread.join ();
 }
 
+TEST (rpc, database_checkpoint)
+{
+	if (vban::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	vban::system system;
+	vban::node_config node_config (vban::get_available_port (), system.logging);
+	node_config.lmdb_config.sync = vban::lmdb_config::sync_strategy::checkpoint;
+	node_config.lmdb_config.checkpoint_interval = std::chrono::hours (1);
+	auto node = add_ipc_enabled_node (system, node_config);
+	{
+		auto transaction (node->store.tx_begin_write ());
+		node->store.confirmation_height_put (transaction, vban::account (1), vban::confirmation_height_info (1, vban::block_hash (1)));
+	}
+	scoped_io_thread_name_change scoped_thread_name_io;
+	vban::node_rpc_config node_rpc_config;
+	vban::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	vban::rpc_config rpc_config (vban::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	vban::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	vban::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "database_checkpoint");
+	uint64_t committed (0);
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ ("1", response.json.get<std::string> ("enabled"));
+		committed = response.json.get<uint64_t> ("committed");
+		ASSERT_LT (response.json.get<uint64_t> ("durable"), committed);
+		ASSERT_FALSE (response.json.get_optional<std::string> ("timed_out").is_initialized ());
+	}
+	request.put ("wait", "true");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ ("0", response.json.get<std::string> ("timed_out"));
+		ASSERT_LE (committed, response.json.get<uint64_t> ("durable"));
+	}
+	request.put ("timeout", "bad");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		std::error_code ec (vban::error_rpc::bad_timeout);
+		ASSERT_EQ (ec.message (), response.json.get<std::string> ("error"));
+	}
+}
+
 TEST (rpc, active_difficulty)
 {
 	vban::system system;
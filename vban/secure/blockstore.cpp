@@ -1,6 +1,459 @@
 #include <vban/lib/threading.hpp>
 #include <vban/secure/blockstore.hpp>
 
+#include <crypto/blake2/blake2.h>
+
+bool vban::representative_dictionary::find (vban::account const & representative_a, uint64_t & id_a) const
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	auto existing (ids.find (representative_a));
+	auto result (existing == ids.end ());
+	if (!result)
+	{
+		id_a = existing->second;
+	}
+	return result;
+}
+
+bool vban::representative_dictionary::get (uint64_t id_a, vban::account & representative_a) const
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	auto result (id_a >= representatives.size ());
+	if (!result)
+	{
+		representative_a = representatives[id_a];
+	}
+	return result;
+}
+
+void vban::representative_dictionary::insert (uint64_t id_a, vban::account const & representative_a)
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	release_assert (id_a == representatives.size ());
+	ids.emplace (representative_a, id_a);
+	representatives.push_back (representative_a);
+}
+
+uint64_t vban::representative_dictionary::assign (vban::account const & representative_a)
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	auto existing (ids.emplace (representative_a, representatives.size ()));
+	if (existing.second)
+	{
+		representatives.push_back (representative_a);
+	}
+	return existing.first->second;
+}
+
+uint64_t vban::representative_dictionary::next () const
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	return representatives.size ();
+}
+
+void vban::representative_dictionary::clear ()
+{
+	vban::lock_guard<vban::mutex> guard (mutex);
+	ids.clear ();
+	representatives.clear ();
+}
+
+namespace
+{
+/** LEB128: 7 bits per byte, least significant first, the high bit is set on every byte but the last */
+template <typename T>
+void write_varint (std::vector<uint8_t> & result_a, T value_a)
+{
+	while (value_a >= 0x80)
+	{
+		result_a.push_back (static_cast<uint8_t> (value_a & 0x7f) | 0x80);
+		value_a >>= 7;
+	}
+	result_a.push_back (static_cast<uint8_t> (value_a));
+}
+
+/** Number of bytes written by write_varint */
+template <typename T>
+size_t varint_size (T value_a)
+{
+	size_t result (1);
+	for (; value_a >= 0x80; value_a >>= 7)
+	{
+		++result;
+	}
+	return result;
+}
+
+/** Returns true on error, a truncated value or one which does not fit \p T */
+template <typename T>
+bool read_varint (uint8_t const *& data_a, uint8_t const * end_a, T & value_a)
+{
+	value_a = 0;
+	auto error (true);
+	unsigned constexpr digits (std::numeric_limits<T>::digits);
+	for (unsigned shift (0); data_a != end_a && shift < digits; shift += 7)
+	{
+		auto byte (*data_a++);
+		T bits (byte & 0x7f);
+		if (digits - shift < 7 && (bits >> (digits - shift)) != 0)
+		{
+			// The last byte has bits above the width of T
+			break;
+		}
+		value_a |= bits << shift;
+		if ((byte & 0x80) == 0)
+		{
+			error = false;
+			break;
+		}
+	}
+	return error;
+}
+}
+
+bool vban::block_encoding::is_compact (uint8_t const * data_a, size_t size_a)
+{
+	return size_a != 0 && (data_a[0] == compact_state || data_a[0] == compact_state_fixed_balance);
+}
+
+bool vban::block_encoding::compactable (std::vector<uint8_t> const & data_a, vban::account & representative_a)
+{
+	auto result (!data_a.empty () && static_cast<vban::block_type> (data_a[0]) == vban::block_type::state && data_a.size () >= balance_offset + sizeof (vban::amount));
+	if (result)
+	{
+		std::copy (data_a.begin () + representative_offset, data_a.begin () + balance_offset, representative_a.bytes.begin ());
+	}
+	return result;
+}
+
+void vban::block_encoding::compact (std::vector<uint8_t> const & data_a, uint64_t representative_id_a, std::vector<uint8_t> & result_a)
+{
+	debug_assert (data_a.size () >= balance_offset + sizeof (vban::amount));
+	vban::amount balance;
+	std::copy (data_a.begin () + balance_offset, data_a.begin () + balance_offset + sizeof (balance.bytes), balance.bytes.begin ());
+	auto fixed_balance (varint_size (balance.number ()) > sizeof (balance.bytes));
+	result_a.clear ();
+	result_a.reserve (data_a.size ());
+	result_a.push_back (fixed_balance ? compact_state_fixed_balance : compact_state);
+	result_a.insert (result_a.end (), data_a.begin () + sizeof (vban::block_type), data_a.begin () + representative_offset);
+	write_varint (result_a, representative_id_a);
+	if (fixed_balance)
+	{
+		result_a.insert (result_a.end (), balance.bytes.begin (), balance.bytes.end ());
+	}
+	else
+	{
+		write_varint (result_a, balance.number ());
+	}
+	result_a.insert (result_a.end (), data_a.begin () + balance_offset + sizeof (balance.bytes), data_a.end ());
+}
+
+bool vban::block_encoding::decode (uint8_t const * data_a, size_t size_a, compact_fields & fields_a)
+{
+	debug_assert (is_compact (data_a, size_a));
+	auto end (data_a + size_a);
+	auto position (data_a + std::min (size_a, representative_offset));
+	auto error (size_a < representative_offset || read_varint (position, end, fields_a.representative_id));
+	if (!error && data_a[0] == compact_state_fixed_balance)
+	{
+		error = static_cast<size_t> (end - position) < sizeof (fields_a.balance.bytes);
+		if (!error)
+		{
+			std::copy (position, position + sizeof (fields_a.balance.bytes), fields_a.balance.bytes.begin ());
+			position += sizeof (fields_a.balance.bytes);
+		}
+	}
+	else if (!error)
+	{
+		vban::uint128_t balance;
+		error = read_varint (position, end, balance);
+		fields_a.balance = vban::amount (balance);
+	}
+	if (!error)
+	{
+		fields_a.link_offset = position - data_a;
+		error = size_a - fields_a.link_offset < sizeof (vban::link) + sizeof (vban::signature) + sizeof (uint64_t) + vban::block_sideband::size (vban::block_type::state);
+	}
+	return error;
+}
+
+std::shared_ptr<std::vector<uint8_t>> vban::block_encoding::expand (uint8_t const * data_a, size_t size_a, vban::representative_dictionary const & dictionary_a)
+{
+	compact_fields fields;
+	vban::account representative;
+	std::shared_ptr<std::vector<uint8_t>> result;
+	auto error (decode (data_a, size_a, fields) || dictionary_a.get (fields.representative_id, representative));
+	if (!error)
+	{
+		result = std::make_shared<std::vector<uint8_t>> ();
+		result->reserve (size_a + sizeof (vban::account) + sizeof (vban::amount));
+		result->push_back (static_cast<uint8_t> (vban::block_type::state));
+		result->insert (result->end (), data_a + sizeof (vban::block_type), data_a + representative_offset);
+		result->insert (result->end (), representative.bytes.begin (), representative.bytes.end ());
+		result->insert (result->end (), fields.balance.bytes.begin (), fields.balance.bytes.end ());
+		result->insert (result->end (), data_a + fields.link_offset, data_a + size_a);
+	}
+	return result;
+}
+
+vban::block_view::block_view (uint8_t const * data_a, size_t size_a, std::shared_ptr<std::vector<uint8_t>> const & buffer_a, vban::representative_dictionary const * dictionary_a) :
+	data (size_a != 0 ? data_a : nullptr),
+	size (size_a),
+	buffer (buffer_a),
+	dictionary (dictionary_a),
+	compact (vban::block_encoding::is_compact (data_a, size_a))
+{
+	if (compact)
+	{
+		debug_assert (dictionary != nullptr);
+		auto error (vban::block_encoding::decode (data, size, fields));
+		release_assert (!error, "Corrupt compact block entry");
+	}
+}
+
+vban::block_view::operator bool () const
+{
+	return data != nullptr;
+}
+
+vban::block_type vban::block_view::type () const
+{
+	debug_assert (data != nullptr);
+	return compact ? vban::block_type::state : static_cast<vban::block_type> (data[0]);
+}
+
+size_t vban::block_view::sideband_offset () const
+{
+	auto result (size - vban::block_sideband::size (type ()));
+	debug_assert (result == (compact ? fields.link_offset + sizeof (vban::link) + sizeof (vban::signature) + sizeof (uint64_t) : block_offset + vban::block::size (type ())));
+	return result;
+}
+
+vban::block_hash vban::block_view::hash () const
+{
+	vban::block_hash result;
+	blake2b_state hash_l;
+	auto status (blake2b_init (&hash_l, sizeof (result.bytes)));
+	debug_assert (status == 0);
+	// Hashables are serialized first and in hashing order for every block type
+	size_t hashables_size (0);
+	switch (type ())
+	{
+		case vban::block_type::send:
+			hashables_size = vban::send_hashables::size;
+			break;
+		case vban::block_type::receive:
+			hashables_size = vban::receive_hashables::size;
+			break;
+		case vban::block_type::open:
+			hashables_size = vban::open_hashables::size;
+			break;
+		case vban::block_type::change:
+			hashables_size = vban::change_hashables::size;
+			break;
+		case vban::block_type::state:
+		{
+			vban::uint256_union preamble (static_cast<uint64_t> (vban::block_type::state));
+			blake2b_update (&hash_l, preamble.bytes.data (), preamble.bytes.size ());
+			hashables_size = vban::state_hashables::size;
+			break;
+		}
+		case vban::block_type::invalid:
+		case vban::block_type::not_a_block:
+			release_assert (false);
+			break;
+	}
+	if (compact)
+	{
+		// Account and previous are in place, the other hashables are stored compactly
+		auto representative_l (representative ());
+		blake2b_update (&hash_l, data + block_offset, vban::block_encoding::representative_offset - block_offset);
+		blake2b_update (&hash_l, representative_l.bytes.data (), representative_l.bytes.size ());
+		blake2b_update (&hash_l, fields.balance.bytes.data (), fields.balance.bytes.size ());
+		blake2b_update (&hash_l, data + fields.link_offset, sizeof (vban::link));
+	}
+	else
+	{
+		blake2b_update (&hash_l, data + block_offset, hashables_size);
+	}
+	status = blake2b_final (&hash_l, result.bytes.data (), sizeof (result.bytes));
+	debug_assert (status == 0);
+	return result;
+}
+
+vban::account vban::block_view::account () const
+{
+	switch (type ())
+	{
+		case vban::block_type::open:
+			return read<vban::account> (block_offset + sizeof (vban::block_hash) + sizeof (vban::account));
+		case vban::block_type::state:
+			return read<vban::account> (block_offset);
+		default:
+			// Legacy blocks store the account in the sideband, right after the successor
+			return read<vban::account> (sideband_offset () + sizeof (vban::block_hash));
+	}
+}
+
+vban::block_hash vban::block_view::previous () const
+{
+	switch (type ())
+	{
+		case vban::block_type::open:
+			return vban::block_hash (0);
+		case vban::block_type::state:
+			return read<vban::block_hash> (block_offset + sizeof (vban::account));
+		default:
+			return read<vban::block_hash> (block_offset);
+	}
+}
+
+vban::account vban::block_view::representative () const
+{
+	switch (type ())
+	{
+		case vban::block_type::open:
+		case vban::block_type::change:
+			return read<vban::account> (block_offset + sizeof (vban::block_hash));
+		case vban::block_type::state:
+			if (compact)
+			{
+				vban::account result;
+				auto error (dictionary == nullptr || dictionary->get (fields.representative_id, result));
+				release_assert (!error, "Unknown representative of a compact block entry");
+				return result;
+			}
+			return read<vban::account> (block_offset + sizeof (vban::account) + sizeof (vban::block_hash));
+		default:
+			return vban::account (0);
+	}
+}
+
+vban::amount vban::block_view::balance () const
+{
+	switch (type ())
+	{
+		case vban::block_type::send:
+			return read<vban::amount> (block_offset + sizeof (vban::block_hash) + sizeof (vban::account));
+		case vban::block_type::state:
+			return compact ? fields.balance : read<vban::amount> (block_offset + sizeof (vban::account) + sizeof (vban::block_hash) + sizeof (vban::account));
+		case vban::block_type::open:
+			return read<vban::amount> (sideband_offset () + sizeof (vban::block_hash));
+		default:
+			return read<vban::amount> (sideband_offset () + sizeof (vban::block_hash) + sizeof (vban::account) + sizeof (uint64_t));
+	}
+}
+
+vban::link vban::block_view::link () const
+{
+	vban::link result (0);
+	if (type () == vban::block_type::state)
+	{
+		result = read<vban::link> (compact ? fields.link_offset : block_offset + sizeof (vban::account) + sizeof (vban::block_hash) + sizeof (vban::account) + sizeof (vban::amount));
+	}
+	return result;
+}
+
+vban::block_hash vban::block_view::source () const
+{
+	switch (type ())
+	{
+		case vban::block_type::receive:
+			return read<vban::block_hash> (block_offset + sizeof (vban::block_hash));
+		case vban::block_type::open:
+			return read<vban::block_hash> (block_offset);
+		default:
+			return vban::block_hash (0);
+	}
+}
+
+vban::account vban::block_view::destination () const
+{
+	vban::account result (0);
+	if (type () == vban::block_type::send)
+	{
+		result = read<vban::account> (block_offset + sizeof (vban::block_hash));
+	}
+	return result;
+}
+
+vban::block_hash vban::block_view::successor () const
+{
+	return read<vban::block_hash> (sideband_offset ());
+}
+
+uint64_t vban::block_view::height () const
+{
+	uint64_t result (1);
+	auto type_l (type ());
+	if (type_l != vban::block_type::open)
+	{
+		auto offset (sideband_offset () + sizeof (vban::block_hash) + (type_l != vban::block_type::state ? sizeof (vban::account) : 0));
+		debug_assert (offset + sizeof (result) <= size);
+		std::copy (data + offset, data + offset + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		boost::endian::big_to_native_inplace (result);
+	}
+	return result;
+}
+
+vban::block_sideband vban::block_view::sideband () const
+{
+	auto offset (sideband_offset ());
+	vban::bufferstream stream (data + offset, size - offset);
+	vban::block_sideband result;
+	auto error (result.deserialize (stream, type ()));
+	(void)error;
+	debug_assert (!error);
+	return result;
+}
+
+void vban::block_view::serialize (vban::stream & stream_a) const
+{
+	if (compact)
+	{
+		// Put the compactly stored fields back at their serialized offset
+		vban::write (stream_a, vban::block_type::state);
+		vban::write (stream_a, read<vban::account> (block_offset));
+		vban::write (stream_a, read<vban::block_hash> (block_offset + sizeof (vban::account)));
+		vban::write (stream_a, representative ());
+		vban::write (stream_a, fields.balance);
+		auto size_l (sideband_offset () - fields.link_offset);
+		auto amount_written (stream_a.sputn (data + fields.link_offset, size_l));
+		(void)amount_written;
+		debug_assert (amount_written == size_l);
+	}
+	else
+	{
+		auto size_l (sideband_offset ());
+		auto amount_written (stream_a.sputn (data, size_l));
+		(void)amount_written;
+		debug_assert (amount_written == size_l);
+	}
+}
+
+std::shared_ptr<vban::block> vban::block_view::block () const
+{
+	std::shared_ptr<vban::block> result;
+	if (compact)
+	{
+		std::vector<uint8_t> serialized;
+		{
+			vban::vectorstream stream (serialized);
+			serialize (stream);
+		}
+		vban::bufferstream stream (serialized.data () + block_offset, serialized.size () - block_offset);
+		result = vban::deserialize_block (stream, vban::block_type::state);
+	}
+	else
+	{
+		vban::bufferstream stream (data + block_offset, size - block_offset);
+		result = vban::deserialize_block (stream, type ());
+	}
+	release_assert (result != nullptr);
+	result->sideband_set (sideband ());
+	return result;
+}
+
 vban::representative_visitor::representative_visitor (vban::transaction const & transaction_a, vban::block_store & store_a) :
 	transaction (transaction_a),
 	store (store_a),
@@ -13,9 +466,19 @@ void vban::representative_visitor::compute (vban::block_hash const & hash_a)
 	current = hash_a;
 	while (result.is_zero ())
 	{
-		auto block (store.block_get (transaction, current));
-		debug_assert (block != nullptr);
-		block->visit (*this);
+		// Walk stored blocks in place, only send and receive blocks don't set a representative
+		auto block (store.block_get_view (transaction, current));
+		debug_assert (block);
+		switch (block.type ())
+		{
+			case vban::block_type::send:
+			case vban::block_type::receive:
+				current = block.previous ();
+				break;
+			default:
+				result = current;
+				break;
+		}
 	}
 }
 
@@ -33,6 +33,123 @@ public:
 	vban::block_sideband sideband;
 };
 
+/**
+ * Small ids for the representatives of stored state blocks, persisted in the representatives table.
+ * Ids are never removed or reused so every stored block stays decodable.
+ * @note This class is thread-safe
+ */
+class representative_dictionary final
+{
+public:
+	/** Returns true if \p representative_a has no id yet, otherwise sets \p id_a */
+	bool find (vban::account const & representative_a, uint64_t & id_a) const;
+	/** Returns true if \p id_a is unknown */
+	bool get (uint64_t id_a, vban::account & representative_a) const;
+	/** Ids are added in increasing order, both when loading the table and when assigning the next one */
+	void insert (uint64_t id_a, vban::account const & representative_a);
+	/** Returns the id of \p representative_a, giving it the next one if it has none. Callers persist new ids themselves */
+	uint64_t assign (vban::account const & representative_a);
+	/** The id of the next new representative */
+	uint64_t next () const;
+	void clear ();
+
+private:
+	mutable vban::mutex mutex{ mutex_identifier (mutexes::representative_dictionary) };
+	std::unordered_map<vban::account, uint64_t> ids;
+	std::vector<vban::account> representatives;
+};
+
+/**
+ * Compact format of state block entries in the blocks table: the representative is replaced by its dictionary id and the balance
+ * is stored as a varint, the other fields and the sideband are unchanged. Balances of 2^112 and above would take more than 16 bytes
+ * as a varint and are kept in the fixed format instead, so the balance never grows. Other block types keep the vban::serialize_block
+ * format followed by the sideband, entries in either format can be mixed in the same table.
+ */
+namespace block_encoding
+{
+	/** Type bytes of compact entries with a varint or a fixed size balance, distinct from every vban::block_type */
+	uint8_t constexpr compact_state = 0x80 | static_cast<uint8_t> (vban::block_type::state);
+	uint8_t constexpr compact_state_fixed_balance = 0x40 | static_cast<uint8_t> (vban::block_type::state);
+	/** Offsets inside a serialized state block entry, after the type byte, account and previous */
+	size_t constexpr representative_offset = sizeof (vban::block_type) + sizeof (vban::account) + sizeof (vban::block_hash);
+	size_t constexpr balance_offset = representative_offset + sizeof (vban::account);
+
+	/** Fields of a compact entry which are not stored at their serialized offset */
+	class compact_fields final
+	{
+	public:
+		uint64_t representative_id{ 0 };
+		vban::amount balance{ 0 };
+		/** Offset of the link, it is followed by the rest of the entry in the serialized format */
+		size_t link_offset{ 0 };
+	};
+
+	bool is_compact (uint8_t const * data_a, size_t size_a);
+	/** Returns true if the compact entry is corrupt */
+	bool decode (uint8_t const * data_a, size_t size_a, compact_fields & fields_a);
+	/** Returns true if the serialized entry can be stored compactly, \p representative_a is set to its representative */
+	bool compactable (std::vector<uint8_t> const & data_a, vban::account & representative_a);
+	/** Writes the compact form of a serialized state block entry */
+	void compact (std::vector<uint8_t> const & data_a, uint64_t representative_id_a, std::vector<uint8_t> & result_a);
+	/** Returns the serialized block and sideband of a compact entry, null if it is corrupt */
+	std::shared_ptr<std::vector<uint8_t>> expand (uint8_t const * data_a, size_t size_a, vban::representative_dictionary const & dictionary_a);
+}
+
+/**
+ * Read-only view of a block as it is stored in the blocks table: the block type, the serialized block and its sideband.
+ * Fields are decoded on access straight from the database value, so walks that only look at a few fields or forward the
+ * serialized block do not allocate. Compact entries are decoded in place too, the representative is only looked up in
+ * the dictionary when it is accessed. A view is only valid while the transaction it was read with is open, views coming
+ * from an iterator are only valid until the iterator moves.
+ * Accessors follow the ledger meaning of a field, e.g. account () and balance () fall back to the sideband for legacy blocks
+ */
+class block_view final
+{
+public:
+	block_view () = default;
+	/** \p dictionary_a is required to read compact entries */
+	block_view (uint8_t const *, size_t, std::shared_ptr<std::vector<uint8_t>> const & = nullptr, vban::representative_dictionary const * dictionary_a = nullptr);
+	/** False if the block does not exist */
+	explicit operator bool () const;
+	vban::block_type type () const;
+	vban::block_hash hash () const;
+	vban::account account () const;
+	vban::block_hash previous () const;
+	vban::account representative () const;
+	vban::amount balance () const;
+	vban::link link () const;
+	vban::block_hash source () const;
+	vban::account destination () const;
+	vban::block_hash successor () const;
+	uint64_t height () const;
+	vban::block_sideband sideband () const;
+	/** Writes the block in the vban::serialize_block format, without the sideband */
+	void serialize (vban::stream &) const;
+	/** Decodes a full block with its sideband */
+	std::shared_ptr<vban::block> block () const;
+
+private:
+	template <typename T>
+	T read (size_t offset_a) const
+	{
+		T result;
+		debug_assert (offset_a + sizeof (result.bytes) <= size);
+		std::copy (data + offset_a, data + offset_a + sizeof (result.bytes), result.bytes.begin ());
+		return result;
+	}
+	/** Offset of the serialized block, just after the block type */
+	static size_t constexpr block_offset = sizeof (vban::block_type);
+	size_t sideband_offset () const;
+
+	uint8_t const * data{ nullptr };
+	size_t size{ 0 };
+	/** Keeps values copied out of the database alive, not set when the view points into a memory map */
+	std::shared_ptr<std::vector<uint8_t>> buffer;
+	vban::representative_dictionary const * dictionary{ nullptr };
+	bool compact{ false };
+	vban::block_encoding::compact_fields fields;
+};
+
 /**
  * Encapsulates database specific container
  */
@@ -129,6 +246,16 @@ public:
 		convert_buffer_to_value ();
 	}
 
+	db_val (vban::pending_summary const & val_a) :
+		buffer (std::make_shared<std::vector<uint8_t>> ())
+	{
+		{
+			vban::vectorstream stream (*buffer);
+			val_a.serialize (stream);
+		}
+		convert_buffer_to_value ();
+	}
+
 	db_val (vban::block_info const & val_a) :
 		db_val (sizeof (val_a), const_cast<vban::block_info *> (&val_a))
 	{
@@ -141,6 +268,18 @@ public:
 		static_assert (std::is_standard_layout<vban::endpoint_key>::value, "Standard layout is required");
 	}
 
+	db_val (vban::delegator_key const & val_a) :
+		db_val (sizeof (val_a), const_cast<vban::delegator_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<vban::delegator_key>::value, "Standard layout is required");
+	}
+
+	db_val (vban::account_height_key const & val_a) :
+		db_val (sizeof (val_a), const_cast<vban::account_height_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<vban::account_height_key>::value, "Standard layout is required");
+	}
+
 	db_val (std::shared_ptr<vban::block> const & val_a) :
 		buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -222,6 +361,16 @@ public:
 		return result;
 	}
 
+	explicit operator vban::pending_summary () const
+	{
+		vban::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
+		vban::pending_summary result;
+		bool error (result.deserialize (stream));
+		(void)error;
+		debug_assert (!error);
+		return result;
+	}
+
 	explicit operator vban::unchecked_info () const
 	{
 		vban::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
@@ -293,6 +442,24 @@ public:
 		return result;
 	}
 
+	explicit operator vban::delegator_key () const
+	{
+		vban::delegator_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (vban::delegator_key::representative) + sizeof (vban::delegator_key::account) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
+	explicit operator vban::account_height_key () const
+	{
+		vban::account_height_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (vban::account) + sizeof (uint64_t) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
 	template <class Block>
 	explicit operator block_w_sideband_v18<Block> () const
 	{
@@ -319,6 +486,11 @@ public:
 		return block_w_sideband;
 	}
 
+	explicit operator block_view () const
+	{
+		return vban::block_view (reinterpret_cast<uint8_t const *> (data ()), size (), buffer);
+	}
+
 	explicit operator state_block_w_sideband_v14 () const
 	{
 		vban::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
@@ -459,6 +631,45 @@ public:
 	vban::block_hash current;
 	vban::block_hash result;
 };
+/** Returns a blocks table value in the serialized block and sideband format, expanding compact entries */
+template <typename Val>
+vban::db_val<Val> block_entry_decode (vban::db_val<Val> const & value_a, vban::representative_dictionary const & dictionary_a)
+{
+	auto data (static_cast<uint8_t const *> (value_a.data ()));
+	if (vban::block_encoding::is_compact (data, value_a.size ()))
+	{
+		vban::db_val<Val> result;
+		result.buffer = vban::block_encoding::expand (data, value_a.size (), dictionary_a);
+		release_assert (result.buffer != nullptr, "Corrupt compact block entry");
+		result.convert_buffer_to_value ();
+		return result;
+	}
+	return value_a;
+}
+
+/** Converts a blocks table value to \p T, compact entries are expanded unless \p T is a view which decodes them in place */
+template <typename T>
+class block_entry_converter final
+{
+public:
+	template <typename Val>
+	static T convert (vban::db_val<Val> const & value_a, vban::representative_dictionary const & dictionary_a)
+	{
+		return static_cast<T> (vban::block_entry_decode (value_a, dictionary_a));
+	}
+};
+
+template <>
+class block_entry_converter<vban::block_view> final
+{
+public:
+	template <typename Val>
+	static vban::block_view convert (vban::db_val<Val> const & value_a, vban::representative_dictionary const & dictionary_a)
+	{
+		return vban::block_view (static_cast<uint8_t const *> (value_a.data ()), value_a.size (), value_a.buffer, &dictionary_a);
+	}
+};
+
 template <typename T, typename U>
 class store_iterator_impl
 {
@@ -539,17 +750,21 @@ private:
 // Keep this in alphabetical order
 enum class tables
 {
+	account_heights,
 	accounts,
 	blocks,
 	confirmation_height,
 	default_unused, // RocksDB only
+	delegators,
 	final_votes,
 	frontiers,
 	meta,
 	online_weight,
 	peers,
 	pending,
+	pending_summary,
 	pruned,
+	representatives,
 	unchecked,
 	vote
 };
@@ -620,6 +835,41 @@ private:
 
 class ledger_cache;
 
+/**
+ * Durability of the write transactions committed since the store was opened, numbered in commit order.
+ * Only stores flushing in the background report commits which are not durable yet.
+ */
+class store_checkpoint final
+{
+public:
+	bool enabled{ false };
+	uint64_t committed{ 0 };
+	/** Every commit up to and including this one is on disk */
+	uint64_t durable{ 0 };
+	std::chrono::system_clock::time_point time;
+};
+
+/**
+ * Loads records of a single table, added in increasing key order, into a file which the store adds in one step without transactions.
+ * Only the put of the table the writer was made for may be called.
+ * Writers of the same table must cover key ranges which do not overlap. Caches and the block filter are bypassed, so it is only
+ * meant for filling a store before it is used.
+ */
+class bulk_writer
+{
+public:
+	virtual ~bulk_writer () = default;
+	virtual void block_raw_put (std::vector<uint8_t> const &, vban::block_hash const &) = 0;
+	virtual void account_put (vban::account const &, vban::account_info const &) = 0;
+	virtual void pending_put (vban::pending_key const &, vban::pending_info const &) = 0;
+	virtual void confirmation_height_put (vban::account const &, vban::confirmation_height_info const &) = 0;
+	virtual void account_height_put (vban::account const &, uint64_t, vban::block_hash const &) = 0;
+	virtual void delegator_put (vban::account const &, vban::account const &) = 0;
+	virtual void pending_summary_put (vban::account const &, vban::pending_summary const &) = 0;
+	/** Completes the file, returns true on error */
+	virtual bool finish () = 0;
+};
+
 /**
  * Manages block storage and iteration
  */
@@ -632,8 +882,11 @@ public:
 	virtual void block_raw_put (vban::write_transaction const &, std::vector<uint8_t> const &, vban::block_hash const &) = 0;
 	virtual vban::block_hash block_successor (vban::transaction const &, vban::block_hash const &) const = 0;
 	virtual void block_successor_clear (vban::write_transaction const &, vban::block_hash const &) = 0;
+	/** The returned block may be shared with other callers through the block cache and must not be modified */
 	virtual std::shared_ptr<vban::block> block_get (vban::transaction const &, vban::block_hash const &) const = 0;
 	virtual std::shared_ptr<vban::block> block_get_no_sideband (vban::transaction const &, vban::block_hash const &) const = 0;
+	/** Returns a view of the stored block without decoding it, the view is only valid while the transaction is open */
+	virtual vban::block_view block_get_view (vban::transaction const &, vban::block_hash const &) const = 0;
 	virtual std::shared_ptr<vban::block> block_random (vban::transaction const &) = 0;
 	virtual void block_del (vban::write_transaction const &, vban::block_hash const &) = 0;
 	virtual bool block_exists (vban::transaction const &, vban::block_hash const &) = 0;
@@ -644,6 +897,9 @@ public:
 	virtual vban::store_iterator<vban::block_hash, block_w_sideband> blocks_begin (vban::transaction const &, vban::block_hash const &) const = 0;
 	virtual vban::store_iterator<vban::block_hash, block_w_sideband> blocks_begin (vban::transaction const &) const = 0;
 	virtual vban::store_iterator<vban::block_hash, block_w_sideband> blocks_end () const = 0;
+	virtual vban::store_iterator<vban::block_hash, vban::block_view> block_views_begin (vban::transaction const &, vban::block_hash const &) const = 0;
+	virtual vban::store_iterator<vban::block_hash, vban::block_view> block_views_begin (vban::transaction const &) const = 0;
+	virtual vban::store_iterator<vban::block_hash, vban::block_view> block_views_end () const = 0;
 
 	virtual void frontier_put (vban::write_transaction const &, vban::block_hash const &, vban::account const &) = 0;
 	virtual vban::account frontier_get (vban::transaction const &, vban::block_hash const &) const = 0;
@@ -669,6 +925,8 @@ public:
 	virtual bool pending_any (vban::transaction const &, vban::account const &) = 0;
 	virtual vban::store_iterator<vban::pending_key, vban::pending_info> pending_begin (vban::transaction const &, vban::pending_key const &) const = 0;
 	virtual vban::store_iterator<vban::pending_key, vban::pending_info> pending_begin (vban::transaction const &) const = 0;
+	/** Iterates the entries pending for an account, stores with prefix filters end the iteration after them and skip files without the account */
+	virtual vban::store_iterator<vban::pending_key, vban::pending_info> pending_begin (vban::transaction const &, vban::account const &) const = 0;
 	virtual vban::store_iterator<vban::pending_key, vban::pending_info> pending_end () const = 0;
 
 	virtual vban::uint256_t block_balance (vban::transaction const &, vban::block_hash const &) = 0;
@@ -697,6 +955,47 @@ public:
 	virtual void version_put (vban::write_transaction const &, int) = 0;
 	virtual int version_get (vban::transaction const &) const = 0;
 
+	/** Serialized ledger_cache written on clean shutdown, see vban::ledger::cache_snapshot_write */
+	virtual void cache_snapshot_put (vban::write_transaction const &, std::vector<uint8_t> const &) = 0;
+	virtual bool cache_snapshot_get (vban::transaction const &, std::vector<uint8_t> &) const = 0;
+	virtual void cache_snapshot_del (vban::write_transaction const &) = 0;
+
+	/** Secondary index of the blocks of each account by height, only kept up to date while vban::ledger::account_heights_enabled is set */
+	virtual void account_height_put (vban::write_transaction const &, vban::account const &, uint64_t, vban::block_hash const &) = 0;
+	virtual void account_height_del (vban::write_transaction const &, vban::account const &, uint64_t) = 0;
+	/** Returns zero if there is no entry */
+	virtual vban::block_hash account_height_get (vban::transaction const &, vban::account const &, uint64_t) const = 0;
+	virtual size_t account_height_count (vban::transaction const &) const = 0;
+	virtual void account_heights_clear (vban::write_transaction const &) = 0;
+	virtual vban::store_iterator<vban::account_height_key, vban::block_hash> account_heights_begin (vban::transaction const &, vban::account_height_key const &) const = 0;
+	virtual vban::store_iterator<vban::account_height_key, vban::block_hash> account_heights_end () const = 0;
+	/** Whether the index covers every block, cleared whenever it stops being maintained */
+	virtual bool account_heights_complete (vban::transaction const &) const = 0;
+	virtual void account_heights_complete_set (vban::write_transaction const &, bool) = 0;
+
+	/** Secondary index of the accounts delegating to each representative, only kept up to date while vban::ledger::delegators_enabled is set */
+	virtual void delegator_put (vban::write_transaction const &, vban::account const &, vban::account const &) = 0;
+	virtual void delegator_del (vban::write_transaction const &, vban::account const &, vban::account const &) = 0;
+	virtual bool delegator_exists (vban::transaction const &, vban::account const &, vban::account const &) const = 0;
+	virtual void delegators_clear (vban::write_transaction const &) = 0;
+	virtual vban::store_iterator<vban::delegator_key, vban::no_value> delegators_begin (vban::transaction const &, vban::delegator_key const &) const = 0;
+	virtual vban::store_iterator<vban::delegator_key, vban::no_value> delegators_end () const = 0;
+	/** Whether the index covers every account, cleared whenever it stops being maintained */
+	virtual bool delegators_complete (vban::transaction const &) const = 0;
+	virtual void delegators_complete_set (vban::write_transaction const &, bool) = 0;
+
+	/** Per account summary of the pending table, only kept up to date while vban::ledger::pending_summary_enabled is set */
+	virtual void pending_summary_put (vban::write_transaction const &, vban::account const &, vban::pending_summary const &) = 0;
+	/** Returns true if the account has no summary */
+	virtual bool pending_summary_get (vban::transaction const &, vban::account const &, vban::pending_summary &) const = 0;
+	virtual void pending_summary_del (vban::write_transaction const &, vban::account const &) = 0;
+	virtual void pending_summary_clear (vban::write_transaction const &) = 0;
+	virtual vban::store_iterator<vban::account, vban::pending_summary> pending_summary_begin (vban::transaction const &, vban::account const &) const = 0;
+	virtual vban::store_iterator<vban::account, vban::pending_summary> pending_summary_end () const = 0;
+	/** Whether the summaries cover the whole pending table, cleared whenever they stop being maintained */
+	virtual bool pending_summary_complete (vban::transaction const &) const = 0;
+	virtual void pending_summary_complete_set (vban::write_transaction const &, bool) = 0;
+
 	virtual void pruned_put (vban::write_transaction const & transaction_a, vban::block_hash const & hash_a) = 0;
 	virtual void pruned_del (vban::write_transaction const & transaction_a, vban::block_hash const & hash_a) = 0;
 	virtual bool pruned_exists (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const = 0;
@@ -734,6 +1033,9 @@ public:
 	virtual void blocks_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::block_hash, block_w_sideband>, vban::store_iterator<vban::block_hash, block_w_sideband>)> const & action_a) const = 0;
 	virtual void frontiers_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::block_hash, vban::account>, vban::store_iterator<vban::block_hash, vban::account>)> const & action_a) const = 0;
 	virtual void final_vote_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::qualified_root, vban::block_hash>, vban::store_iterator<vban::qualified_root, vban::block_hash>)> const & action_a) const = 0;
+	virtual void account_heights_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::account_height_key, vban::block_hash>, vban::store_iterator<vban::account_height_key, vban::block_hash>)> const & action_a) const = 0;
+	virtual void delegators_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::delegator_key, vban::no_value>, vban::store_iterator<vban::delegator_key, vban::no_value>)> const & action_a) const = 0;
+	virtual void pending_summary_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::account, vban::pending_summary>, vban::store_iterator<vban::account, vban::pending_summary>)> const & action_a) const = 0;
 
 	virtual uint64_t block_account_height (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const = 0;
 
@@ -754,10 +1056,40 @@ public:
 
 	/** Not applicable to all sub-classes */
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
+	virtual vban::store_checkpoint checkpoint_get ()
+	{
+		return {};
+	}
+	/** Flushes now and waits until every commit made before the call is durable, returns true on timeout */
+	virtual bool checkpoint_wait (std::chrono::milliseconds)
+	{
+		return false;
+	}
+	/** Returns nullptr if the store cannot load files directly */
+	virtual std::unique_ptr<vban::bulk_writer> bulk_writer_make (vban::tables)
+	{
+		return nullptr;
+	}
+	/** Adds the files of finished writers to the store, returns true on error */
+	virtual bool bulk_ingest (std::vector<std::unique_ptr<vban::bulk_writer>> &)
+	{
+		return true;
+	}
 	virtual void serialize_memory_stats (boost::property_tree::ptree &) = 0;
 
 	virtual bool init_error () const = 0;
 
+	/** Sets the memory budget in bytes of the accounts and confirmation_height caches, 0 disables them */
+	virtual void account_cache_memory_set (size_t) = 0;
+	/** Sets the maximum number of decoded blocks kept by block_get, 0 disables the cache */
+	virtual void block_cache_size_set (size_t) = 0;
+	/** Builds the in-memory filter over block and pruned hashes from the current tables, can only be called once and may run while the store is written to. 0 bits per entry leaves it disabled, as does \p stopped_a becoming true before the tables are read */
+	virtual void block_filter_build (size_t bits_per_entry, std::atomic<bool> const & stopped_a) = 0;
+	virtual bool block_filter_enabled () const = 0;
+	/** True if \p hash_a is in neither the blocks nor the pruned table, false if it may be or the filter is not built */
+	virtual bool block_filter_excludes (vban::block_hash const & hash_a) const = 0;
+	virtual std::unique_ptr<vban::container_info_component> collect_cache_info (std::string const &) = 0;
+
 	/** Start read-write transaction */
 	virtual vban::write_transaction tx_begin_write (std::vector<vban::tables> const & tables_to_lock = {}, std::vector<vban::tables> const & tables_no_lock = {}) = 0;
 
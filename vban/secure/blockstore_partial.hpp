@@ -6,6 +6,8 @@
 #include <vban/lib/timer.hpp>
 #include <vban/secure/blockstore.hpp>
 #include <vban/secure/buffer.hpp>
+#include <vban/secure/membership_filter.hpp>
+#include <vban/secure/store_cache.hpp>
 
 #include <crypto/cryptopp/words.h>
 
@@ -81,38 +83,67 @@ public:
 
 	vban::uint256_t block_balance (vban::transaction const & transaction_a, vban::block_hash const & hash_a) override
 	{
-		auto block (block_get (transaction_a, hash_a));
+		auto block (block_get_view (transaction_a, hash_a));
 		release_assert (block);
-		vban::uint256_t result (block_balance_calculated (block));
+		vban::uint256_t result (block.balance ().number ());
 		return result;
 	}
 
 	std::shared_ptr<vban::block> block_get (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
 	{
-		auto value (block_raw_get (transaction_a, hash_a));
+		auto stored (block_stored_get (transaction_a, hash_a));
 		std::shared_ptr<vban::block> result;
-		if (value.size () != 0)
+		if (stored.size () != 0)
 		{
-			vban::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			vban::block_type type;
-			auto error (try_read (stream, type));
-			release_assert (!error);
-			result = vban::deserialize_block (stream, type);
-			release_assert (result != nullptr);
-			vban::block_sideband sideband;
-			error = (sideband.deserialize (stream, type));
-			release_assert (!error);
-			result->sideband_set (sideband);
+			auto data (static_cast<uint8_t const *> (stored.data ()));
+			std::shared_ptr<cached_block const> cached;
+			// A decoded block is only reused if it came from the exact bytes this transaction sees, so snapshots stay consistent
+			auto miss (block_cache.get (hash_a, cached, [&stored, data] (std::shared_ptr<cached_block const> const & cached_a) {
+				return cached_a->raw.size () == stored.size () && std::equal (cached_a->raw.begin (), cached_a->raw.end (), data);
+			}));
+			if (!miss)
+			{
+				result = cached->block;
+			}
+			else
+			{
+				auto value (vban::block_entry_decode (stored, representative_ids));
+				vban::bufferstream stream (static_cast<uint8_t const *> (value.data ()), value.size ());
+				vban::block_type type;
+				auto error (try_read (stream, type));
+				release_assert (!error);
+				result = vban::deserialize_block (stream, type);
+				release_assert (result != nullptr);
+				vban::block_sideband sideband;
+				error = (sideband.deserialize (stream, type));
+				release_assert (!error);
+				result->sideband_set (sideband);
+				if (block_cache.enabled ())
+				{
+					// Compute the lazily cached hash before the block is shared between threads
+					result->hash ();
+					block_cache.put (hash_a, std::make_shared<cached_block const> (cached_block{ std::vector<uint8_t> (data, data + stored.size ()), result }));
+				}
+			}
 		}
 		return result;
 	}
 
 	bool block_exists (vban::transaction const & transaction_a, vban::block_hash const & hash_a) override
 	{
-		auto junk = block_raw_get (transaction_a, hash_a);
+		if (block_filter_excludes (hash_a))
+		{
+			return false;
+		}
+		auto junk = block_stored_get (transaction_a, hash_a);
 		return junk.size () != 0;
 	}
 
+	vban::block_view block_get_view (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
+	{
+		return vban::block_entry_converter<vban::block_view>::convert (block_stored_get (transaction_a, hash_a), representative_ids);
+	}
+
 	std::shared_ptr<vban::block> block_get_no_sideband (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
 	{
 		auto value (block_raw_get (transaction_a, hash_a));
@@ -133,9 +164,9 @@ public:
 
 	vban::account block_account (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
 	{
-		auto block (block_get (transaction_a, hash_a));
-		debug_assert (block != nullptr);
-		return block_account_calculated (*block);
+		auto block (block_get_view (transaction_a, hash_a));
+		debug_assert (block);
+		return block.account ();
 	}
 
 	vban::account block_account_calculated (vban::block const & block_a) const override
@@ -176,7 +207,8 @@ public:
 
 	vban::block_hash block_successor (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
 	{
-		auto value (block_raw_get (transaction_a, hash_a));
+		// The sideband ends both entry formats
+		auto value (block_stored_get (transaction_a, hash_a));
 		vban::block_hash result;
 		if (value.size () != 0)
 		{
@@ -234,11 +266,31 @@ public:
 		return vban::store_iterator<vban::block_hash, vban::block_w_sideband> (nullptr);
 	}
 
+	vban::store_iterator<vban::block_hash, vban::block_view> block_views_end () const override
+	{
+		return vban::store_iterator<vban::block_hash, vban::block_view> (nullptr);
+	}
+
 	vban::store_iterator<vban::account, vban::confirmation_height_info> confirmation_height_end () const override
 	{
 		return vban::store_iterator<vban::account, vban::confirmation_height_info> (nullptr);
 	}
 
+	vban::store_iterator<vban::account_height_key, vban::block_hash> account_heights_end () const override
+	{
+		return vban::store_iterator<vban::account_height_key, vban::block_hash> (nullptr);
+	}
+
+	vban::store_iterator<vban::delegator_key, vban::no_value> delegators_end () const override
+	{
+		return vban::store_iterator<vban::delegator_key, vban::no_value> (nullptr);
+	}
+
+	vban::store_iterator<vban::account, vban::pending_summary> pending_summary_end () const override
+	{
+		return vban::store_iterator<vban::account, vban::pending_summary> (nullptr);
+	}
+
 	vban::store_iterator<vban::block_hash, std::nullptr_t> pruned_end () const override
 	{
 		return vban::store_iterator<vban::block_hash, std::nullptr_t> (nullptr);
@@ -269,10 +321,44 @@ public:
 		return result;
 	}
 
+	void cache_snapshot_put (vban::write_transaction const & transaction_a, std::vector<uint8_t> const & data_a) override
+	{
+		vban::uint256_union cache_snapshot_key (2);
+		vban::db_val<Val> value{ data_a.size (), (void *)data_a.data () };
+		auto status = put (transaction_a, tables::meta, vban::db_val<Val> (cache_snapshot_key), value);
+		release_assert_success (status);
+	}
+
+	bool cache_snapshot_get (vban::transaction const & transaction_a, std::vector<uint8_t> & data_a) const override
+	{
+		vban::uint256_union cache_snapshot_key (2);
+		vban::db_val<Val> value;
+		auto status = get (transaction_a, tables::meta, vban::db_val<Val> (cache_snapshot_key), value);
+		release_assert (success (status) || not_found (status));
+		auto result (!success (status));
+		if (!result)
+		{
+			auto data (static_cast<uint8_t const *> (value.data ()));
+			data_a.assign (data, data + value.size ());
+		}
+		return result;
+	}
+
+	void cache_snapshot_del (vban::write_transaction const & transaction_a) override
+	{
+		vban::uint256_union cache_snapshot_key (2);
+		if (exists (transaction_a, tables::meta, vban::db_val<Val> (cache_snapshot_key)))
+		{
+			auto status = del (transaction_a, tables::meta, vban::db_val<Val> (cache_snapshot_key));
+			release_assert_success (status);
+		}
+	}
+
 	void block_del (vban::write_transaction const & transaction_a, vban::block_hash const & hash_a) override
 	{
 		auto status = del (transaction_a, tables::blocks, hash_a);
 		release_assert_success (status);
+		block_cache.erase (hash_a);
 	}
 
 	vban::epoch block_version (vban::transaction const & transaction_a, vban::block_hash const & hash_a) override
@@ -288,9 +374,13 @@ public:
 
 	void block_raw_put (vban::write_transaction const & transaction_a, std::vector<uint8_t> const & data, vban::block_hash const & hash_a) override
 	{
-		vban::db_val<Val> value{ data.size (), (void *)data.data () };
+		block_filter_insert (hash_a);
+		std::vector<uint8_t> compact;
+		auto stored (block_entry_compact (transaction_a, data, compact) ? &compact : &data);
+		vban::db_val<Val> value{ stored->size (), (void *)stored->data () };
 		auto status = put (transaction_a, tables::blocks, hash_a, value);
 		release_assert_success (status);
+		block_cache.erase (hash_a);
 	}
 
 	void pending_put (vban::write_transaction const & transaction_a, vban::pending_key const & key_a, vban::pending_info const & pending_info_a) override
@@ -329,7 +419,7 @@ public:
 
 	bool pending_any (vban::transaction const & transaction_a, vban::account const & account_a) override
 	{
-		auto iterator (pending_begin (transaction_a, vban::pending_key (account_a, 0)));
+		auto iterator (pending_begin (transaction_a, account_a));
 		return iterator != pending_end () && vban::pending_key (iterator->first).account == account_a;
 	}
 
@@ -399,16 +489,23 @@ public:
 		vban::db_val<Val> info (info_a);
 		auto status = put (transaction_a, tables::accounts, account_a, info);
 		release_assert_success (status);
+		account_cache.put (account_a, info_a);
 	}
 
 	void account_del (vban::write_transaction const & transaction_a, vban::account const & account_a) override
 	{
 		auto status = del (transaction_a, tables::accounts, account_a);
 		release_assert_success (status);
+		account_cache.erase (account_a);
 	}
 
 	bool account_get (vban::transaction const & transaction_a, vban::account const & account_a, vban::account_info & info_a) override
 	{
+		auto cached (cache_usable (transaction_a, tables::accounts));
+		if (cached && !account_cache.get (account_a, info_a))
+		{
+			return false;
+		}
 		vban::db_val<Val> value;
 		vban::db_val<Val> account (account_a);
 		auto status1 (get (transaction_a, tables::accounts, account, value));
@@ -419,6 +516,10 @@ public:
 			vban::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
 			result = info_a.deserialize (stream);
 		}
+		if (cached && !result)
+		{
+			account_cache.put (account_a, info_a);
+		}
 		return result;
 	}
 
@@ -452,8 +553,168 @@ public:
 		release_assert_success (status);
 	}
 
+	void account_height_put (vban::write_transaction const & transaction_a, vban::account const & account_a, uint64_t height_a, vban::block_hash const & hash_a) override
+	{
+		auto status (put (transaction_a, tables::account_heights, vban::account_height_key (account_a, height_a), hash_a));
+		release_assert_success (status);
+	}
+
+	void account_height_del (vban::write_transaction const & transaction_a, vban::account const & account_a, uint64_t height_a) override
+	{
+		auto status (del (transaction_a, tables::account_heights, vban::account_height_key (account_a, height_a)));
+		release_assert (success (status) || not_found (status));
+	}
+
+	vban::block_hash account_height_get (vban::transaction const & transaction_a, vban::account const & account_a, uint64_t height_a) const override
+	{
+		vban::db_val<Val> value;
+		auto status (get (transaction_a, tables::account_heights, vban::db_val<Val> (vban::account_height_key (account_a, height_a)), value));
+		release_assert (success (status) || not_found (status));
+		vban::block_hash result (0);
+		if (success (status))
+		{
+			result = static_cast<vban::block_hash> (value);
+		}
+		return result;
+	}
+
+	size_t account_height_count (vban::transaction const & transaction_a) const override
+	{
+		return count (transaction_a, tables::account_heights);
+	}
+
+	void account_heights_clear (vban::write_transaction const & transaction_a) override
+	{
+		auto status (drop (transaction_a, tables::account_heights));
+		release_assert_success (status);
+	}
+
+	bool account_heights_complete (vban::transaction const & transaction_a) const override
+	{
+		vban::uint256_union account_heights_complete_key (3);
+		return exists (transaction_a, tables::meta, vban::db_val<Val> (account_heights_complete_key));
+	}
+
+	void account_heights_complete_set (vban::write_transaction const & transaction_a, bool complete_a) override
+	{
+		vban::uint256_union account_heights_complete_key (3);
+		if (complete_a)
+		{
+			auto status (put (transaction_a, tables::meta, vban::db_val<Val> (account_heights_complete_key), vban::db_val<Val> (vban::uint256_union (1))));
+			release_assert_success (status);
+		}
+		else if (exists (transaction_a, tables::meta, vban::db_val<Val> (account_heights_complete_key)))
+		{
+			auto status (del (transaction_a, tables::meta, vban::db_val<Val> (account_heights_complete_key)));
+			release_assert_success (status);
+		}
+	}
+
+	void delegator_put (vban::write_transaction const & transaction_a, vban::account const & representative_a, vban::account const & account_a) override
+	{
+		auto status (put_key (transaction_a, tables::delegators, vban::delegator_key (representative_a, account_a)));
+		release_assert_success (status);
+	}
+
+	void delegator_del (vban::write_transaction const & transaction_a, vban::account const & representative_a, vban::account const & account_a) override
+	{
+		auto status (del (transaction_a, tables::delegators, vban::delegator_key (representative_a, account_a)));
+		release_assert (success (status) || not_found (status));
+	}
+
+	bool delegator_exists (vban::transaction const & transaction_a, vban::account const & representative_a, vban::account const & account_a) const override
+	{
+		return exists (transaction_a, tables::delegators, vban::db_val<Val> (vban::delegator_key (representative_a, account_a)));
+	}
+
+	void delegators_clear (vban::write_transaction const & transaction_a) override
+	{
+		auto status (drop (transaction_a, tables::delegators));
+		release_assert_success (status);
+	}
+
+	bool delegators_complete (vban::transaction const & transaction_a) const override
+	{
+		vban::uint256_union delegators_complete_key (4);
+		return exists (transaction_a, tables::meta, vban::db_val<Val> (delegators_complete_key));
+	}
+
+	void delegators_complete_set (vban::write_transaction const & transaction_a, bool complete_a) override
+	{
+		vban::uint256_union delegators_complete_key (4);
+		if (complete_a)
+		{
+			auto status (put (transaction_a, tables::meta, vban::db_val<Val> (delegators_complete_key), vban::db_val<Val> (vban::uint256_union (1))));
+			release_assert_success (status);
+		}
+		else if (exists (transaction_a, tables::meta, vban::db_val<Val> (delegators_complete_key)))
+		{
+			auto status (del (transaction_a, tables::meta, vban::db_val<Val> (delegators_complete_key)));
+			release_assert_success (status);
+		}
+	}
+
+	void pending_summary_put (vban::write_transaction const & transaction_a, vban::account const & account_a, vban::pending_summary const & summary_a) override
+	{
+		auto status (put (transaction_a, tables::pending_summary, account_a, summary_a));
+		release_assert_success (status);
+	}
+
+	bool pending_summary_get (vban::transaction const & transaction_a, vban::account const & account_a, vban::pending_summary & summary_a) const override
+	{
+		vban::db_val<Val> value;
+		auto status (get (transaction_a, tables::pending_summary, vban::db_val<Val> (account_a), value));
+		release_assert (success (status) || not_found (status));
+		bool result (true);
+		if (success (status))
+		{
+			summary_a = static_cast<vban::pending_summary> (value);
+			result = false;
+		}
+		return result;
+	}
+
+	void pending_summary_del (vban::write_transaction const & transaction_a, vban::account const & account_a) override
+	{
+		auto status (del (transaction_a, tables::pending_summary, account_a));
+		release_assert (success (status) || not_found (status));
+	}
+
+	void pending_summary_clear (vban::write_transaction const & transaction_a) override
+	{
+		auto status (drop (transaction_a, tables::pending_summary));
+		release_assert_success (status);
+	}
+
+	vban::store_iterator<vban::account, vban::pending_summary> pending_summary_begin (vban::transaction const & transaction_a, vban::account const & account_a) const override
+	{
+		return make_iterator<vban::account, vban::pending_summary> (transaction_a, tables::pending_summary, vban::db_val<Val> (account_a));
+	}
+
+	bool pending_summary_complete (vban::transaction const & transaction_a) const override
+	{
+		vban::uint256_union pending_summary_complete_key (5);
+		return exists (transaction_a, tables::meta, vban::db_val<Val> (pending_summary_complete_key));
+	}
+
+	void pending_summary_complete_set (vban::write_transaction const & transaction_a, bool complete_a) override
+	{
+		vban::uint256_union pending_summary_complete_key (5);
+		if (complete_a)
+		{
+			auto status (put (transaction_a, tables::meta, vban::db_val<Val> (pending_summary_complete_key), vban::db_val<Val> (vban::uint256_union (1))));
+			release_assert_success (status);
+		}
+		else if (exists (transaction_a, tables::meta, vban::db_val<Val> (pending_summary_complete_key)))
+		{
+			auto status (del (transaction_a, tables::meta, vban::db_val<Val> (pending_summary_complete_key)));
+			release_assert_success (status);
+		}
+	}
+
 	void pruned_put (vban::write_transaction const & transaction_a, vban::block_hash const & hash_a) override
 	{
+		block_filter_insert (hash_a);
 		auto status = put_key (transaction_a, tables::pruned, hash_a);
 		release_assert_success (status);
 	}
@@ -466,6 +727,10 @@ public:
 
 	bool pruned_exists (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
 	{
+		if (block_filter_excludes (hash_a))
+		{
+			return false;
+		}
 		return exists (transaction_a, tables::pruned, vban::db_val<Val> (hash_a));
 	}
 
@@ -560,10 +825,16 @@ public:
 		vban::db_val<Val> confirmation_height_info (confirmation_height_info_a);
 		auto status = put (transaction_a, tables::confirmation_height, account_a, confirmation_height_info);
 		release_assert_success (status);
+		confirmation_height_cache.put (account_a, confirmation_height_info_a);
 	}
 
 	bool confirmation_height_get (vban::transaction const & transaction_a, vban::account const & account_a, vban::confirmation_height_info & confirmation_height_info_a) override
 	{
+		auto cached (cache_usable (transaction_a, tables::confirmation_height));
+		if (cached && !confirmation_height_cache.get (account_a, confirmation_height_info_a))
+		{
+			return false;
+		}
 		vban::db_val<Val> value;
 		auto status = get (transaction_a, tables::confirmation_height, vban::db_val<Val> (account_a), value);
 		release_assert (success (status) || not_found (status));
@@ -578,6 +849,10 @@ public:
 			confirmation_height_info_a.height = 0;
 			confirmation_height_info_a.frontier = 0;
 		}
+		else if (cached)
+		{
+			confirmation_height_cache.put (account_a, confirmation_height_info_a);
+		}
 
 		return result;
 	}
@@ -586,6 +861,7 @@ public:
 	{
 		auto status (del (transaction_a, tables::confirmation_height, vban::db_val<Val> (account_a)));
 		release_assert_success (status);
+		confirmation_height_cache.erase (account_a);
 	}
 
 	bool confirmation_height_exists (vban::transaction const & transaction_a, vban::account const & account_a) const override
@@ -615,7 +891,7 @@ public:
 	{
 		std::vector<vban::block_hash> result;
 		vban::qualified_root key_start (root_a.raw, 0);
-		for (auto i (final_vote_begin (transaction_a, key_start)), n (final_vote_end ()); i != n && vban::qualified_root (i->first).root () == root_a; ++i)
+		for (auto i (make_prefix_iterator<vban::qualified_root, vban::block_hash> (transaction_a, tables::final_votes, vban::db_val<Val> (key_start))), n (final_vote_end ()); i != n && vban::qualified_root (i->first).root () == root_a; ++i)
 		{
 			result.push_back (i->second);
 		}
@@ -630,7 +906,8 @@ public:
 	void final_vote_del (vban::write_transaction const & transaction_a, vban::root const & root_a) override
 	{
 		std::vector<vban::qualified_root> final_vote_qualified_roots;
-		for (auto i (final_vote_begin (transaction_a, vban::qualified_root (root_a.raw, 0))), n (final_vote_end ()); i != n && vban::qualified_root (i->first).root () == root_a; ++i)
+		vban::qualified_root key_start (root_a.raw, 0);
+		for (auto i (make_prefix_iterator<vban::qualified_root, vban::block_hash> (transaction_a, tables::final_votes, vban::db_val<Val> (key_start))), n (final_vote_end ()); i != n && vban::qualified_root (i->first).root () == root_a; ++i)
 		{
 			final_vote_qualified_roots.push_back (i->first);
 		}
@@ -660,6 +937,7 @@ public:
 	void confirmation_height_clear (vban::write_transaction const & transaction_a) override
 	{
 		drop (transaction_a, vban::tables::confirmation_height);
+		confirmation_height_cache.clear ();
 	}
 
 	vban::store_iterator<vban::account, vban::account_info> accounts_begin (vban::transaction const & transaction_a, vban::account const & account_a) const override
@@ -682,6 +960,16 @@ public:
 		return make_iterator<vban::block_hash, vban::block_w_sideband> (transaction_a, tables::blocks, vban::db_val<Val> (hash_a));
 	}
 
+	vban::store_iterator<vban::block_hash, vban::block_view> block_views_begin (vban::transaction const & transaction_a) const override
+	{
+		return make_iterator<vban::block_hash, vban::block_view> (transaction_a, tables::blocks);
+	}
+
+	vban::store_iterator<vban::block_hash, vban::block_view> block_views_begin (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
+	{
+		return make_iterator<vban::block_hash, vban::block_view> (transaction_a, tables::blocks, vban::db_val<Val> (hash_a));
+	}
+
 	vban::store_iterator<vban::block_hash, vban::account> frontiers_begin (vban::transaction const & transaction_a) const override
 	{
 		return make_iterator<vban::block_hash, vban::account> (transaction_a, tables::frontiers);
@@ -702,6 +990,11 @@ public:
 		return make_iterator<vban::pending_key, vban::pending_info> (transaction_a, tables::pending);
 	}
 
+	vban::store_iterator<vban::pending_key, vban::pending_info> pending_begin (vban::transaction const & transaction_a, vban::account const & account_a) const override
+	{
+		return make_prefix_iterator<vban::pending_key, vban::pending_info> (transaction_a, tables::pending, vban::db_val<Val> (vban::pending_key (account_a, 0)));
+	}
+
 	vban::store_iterator<vban::unchecked_key, vban::unchecked_info> unchecked_begin (vban::transaction const & transaction_a) const override
 	{
 		return make_iterator<vban::unchecked_key, vban::unchecked_info> (transaction_a, tables::unchecked);
@@ -732,6 +1025,16 @@ public:
 		return make_iterator<vban::account, vban::confirmation_height_info> (transaction_a, tables::confirmation_height);
 	}
 
+	vban::store_iterator<vban::account_height_key, vban::block_hash> account_heights_begin (vban::transaction const & transaction_a, vban::account_height_key const & key_a) const override
+	{
+		return make_iterator<vban::account_height_key, vban::block_hash> (transaction_a, tables::account_heights, vban::db_val<Val> (key_a));
+	}
+
+	vban::store_iterator<vban::delegator_key, vban::no_value> delegators_begin (vban::transaction const & transaction_a, vban::delegator_key const & key_a) const override
+	{
+		return make_iterator<vban::delegator_key, vban::no_value> (transaction_a, tables::delegators, vban::db_val<Val> (key_a));
+	}
+
 	vban::store_iterator<vban::block_hash, std::nullptr_t> pruned_begin (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const override
 	{
 		return make_iterator<vban::block_hash, std::nullptr_t> (transaction_a, tables::pruned, vban::db_val<Val> (hash_a));
@@ -845,11 +1148,153 @@ public:
 		});
 	}
 
+	void account_heights_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::account_height_key, vban::block_hash>, vban::store_iterator<vban::account_height_key, vban::block_hash>)> const & action_a) const override
+	{
+		parallel_traversal<vban::uint256_t> (
+		[&action_a, this] (vban::uint256_t const & start, vban::uint256_t const & end, bool const is_last) {
+			auto transaction (this->tx_begin_read ());
+			action_a (transaction, this->account_heights_begin (transaction, vban::account_height_key (start, 0)), !is_last ? this->account_heights_begin (transaction, vban::account_height_key (end, 0)) : this->account_heights_end ());
+		});
+	}
+
+	void delegators_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::delegator_key, vban::no_value>, vban::store_iterator<vban::delegator_key, vban::no_value>)> const & action_a) const override
+	{
+		parallel_traversal<vban::uint256_t> (
+		[&action_a, this] (vban::uint256_t const & start, vban::uint256_t const & end, bool const is_last) {
+			auto transaction (this->tx_begin_read ());
+			action_a (transaction, this->delegators_begin (transaction, vban::delegator_key (start, 0)), !is_last ? this->delegators_begin (transaction, vban::delegator_key (end, 0)) : this->delegators_end ());
+		});
+	}
+
+	void pending_summary_for_each_par (std::function<void (vban::read_transaction const &, vban::store_iterator<vban::account, vban::pending_summary>, vban::store_iterator<vban::account, vban::pending_summary>)> const & action_a) const override
+	{
+		parallel_traversal<vban::uint256_t> (
+		[&action_a, this] (vban::uint256_t const & start, vban::uint256_t const & end, bool const is_last) {
+			auto transaction (this->tx_begin_read ());
+			action_a (transaction, this->pending_summary_begin (transaction, start), !is_last ? this->pending_summary_begin (transaction, end) : this->pending_summary_end ());
+		});
+	}
+
+	void account_cache_memory_set (size_t memory_a) override
+	{
+		// Account infos are larger, give them the bigger share
+		account_cache.resize (memory_a / 3 * 2 / account_cache.entry_size);
+		confirmation_height_cache.resize (memory_a / 3 / confirmation_height_cache.entry_size);
+	}
+
+	void block_cache_size_set (size_t size_a) override
+	{
+		block_cache.resize (size_a);
+	}
+
+	void block_filter_build (size_t bits_per_entry_a, std::atomic<bool> const & stopped_a) override
+	{
+		debug_assert (block_filter_writes == nullptr);
+		if (bits_per_entry_a != 0)
+		{
+			uint64_t count (0);
+			{
+				auto transaction (tx_begin_read ());
+				count = block_count (transaction) + pruned_count (transaction);
+			}
+			// Leaves room for the blocks arriving while the node runs, overfilling only costs precision
+			block_filter_m = std::make_unique<vban::membership_filter> (count + count / 2 + 1024 * 1024, bits_per_entry_a);
+			auto filter (block_filter_m.get ());
+			{
+				// Publishing under the table locks waits for writers already past block_filter_insert, their blocks are then committed before the traversal snapshots are taken
+				auto transaction (tx_begin_write ({ tables::blocks, tables::pruned }));
+				block_filter_writes = filter;
+			}
+			parallel_traversal<vban::uint256_t> (
+			[filter, &stopped_a, this] (vban::uint256_t const & start, vban::uint256_t const & end, bool const is_last) {
+				auto transaction (this->tx_begin_read ());
+				for (auto i (this->block_views_begin (transaction, start)), n (!is_last ? this->block_views_begin (transaction, end) : this->block_views_end ()); i != n && !stopped_a; ++i)
+				{
+					filter->insert (i->first);
+				}
+				for (auto i (this->pruned_begin (transaction, start)), n (!is_last ? this->pruned_begin (transaction, end) : this->pruned_end ()); i != n && !stopped_a; ++i)
+				{
+					filter->insert (i->first);
+				}
+			});
+			if (!stopped_a)
+			{
+				block_filter = filter;
+			}
+		}
+	}
+
+	bool block_filter_enabled () const override
+	{
+		return block_filter != nullptr;
+	}
+
+	bool block_filter_excludes (vban::block_hash const & hash_a) const override
+	{
+		auto filter (block_filter.load ());
+		return filter != nullptr && !filter->may_contain (hash_a);
+	}
+
+	std::unique_ptr<vban::container_info_component> collect_cache_info (std::string const & name) override
+	{
+		auto composite = std::make_unique<container_info_composite> (name);
+		composite->add_component (collect_container_info (account_cache, "accounts"));
+		composite->add_component (collect_container_info (confirmation_height_cache, "confirmation_height"));
+		composite->add_component (collect_container_info (block_cache, "blocks"));
+		if (block_filter_enabled ())
+		{
+			composite->add_component (collect_container_info (*block_filter_m, "block_filter"));
+		}
+		return composite;
+	}
+
 	int const minimum_version{ 14 };
 
 protected:
 	vban::network_params network_params;
-	int const version{ 21 };
+	int const version{ 25 };
+	vban::store_cache<vban::account, vban::account_info> account_cache;
+	vban::store_cache<vban::account, vban::confirmation_height_info> confirmation_height_cache;
+
+	/** Decoded block together with the raw value it was decoded from */
+	class cached_block final
+	{
+	public:
+		std::vector<uint8_t> raw;
+		std::shared_ptr<vban::block> block;
+	};
+	/**
+	 * Recently decoded blocks. Any transaction may use it, hits are checked against the bytes the transaction reads.
+	 * Entries are dropped whenever a block is rewritten or deleted, including successor updates and rollbacks.
+	 */
+	mutable vban::store_cache<vban::block_hash, std::shared_ptr<cached_block const>> block_cache;
+
+	/** Hashes of the blocks and pruned tables, only grows. Inserted into once built, consulted once fully populated */
+	std::unique_ptr<vban::membership_filter> block_filter_m;
+	std::atomic<vban::membership_filter *> block_filter_writes{ nullptr };
+	std::atomic<vban::membership_filter *> block_filter{ nullptr };
+
+	/** Ids of the representatives of compact state block entries, loaded from the representatives table once the store is open */
+	vban::representative_dictionary representative_ids;
+
+	void block_filter_insert (vban::block_hash const & hash_a)
+	{
+		auto filter (block_filter_writes.load ());
+		if (filter != nullptr)
+		{
+			filter->insert (hash_a);
+		}
+	}
+
+	/**
+	 * Caches only reflect the view of the write transaction holding the table,
+	 * read transactions and writers not holding it must see their own snapshot
+	 */
+	bool cache_usable (vban::transaction const & transaction_a, tables table_a) const
+	{
+		auto write_transaction_l (dynamic_cast<vban::write_transaction const *> (&transaction_a));
+		return write_transaction_l != nullptr && write_transaction_l->contains (table_a);
+	}
 
 	template <typename Key, typename Value>
 	vban::store_iterator<Key, Value> make_iterator (vban::transaction const & transaction_a, tables table_a, bool const direction_asc = true) const
@@ -863,7 +1308,21 @@ protected:
 		return static_cast<Derived_Store const &> (*this).template make_iterator<Key, Value> (transaction_a, table_a, key);
 	}
 
+	/** Iterates the entries sharing the prefix of \p key, stores may end the iteration after them so callers still have to check the prefix */
+	template <typename Key, typename Value>
+	vban::store_iterator<Key, Value> make_prefix_iterator (vban::transaction const & transaction_a, tables table_a, vban::db_val<Val> const & key) const
+	{
+		return static_cast<Derived_Store const &> (*this).template make_prefix_iterator<Key, Value> (transaction_a, table_a, key);
+	}
+
+	/** Returns the entry in the serialized block and sideband format, whichever format it is stored in */
 	vban::db_val<Val> block_raw_get (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const
+	{
+		return vban::block_entry_decode (block_stored_get (transaction_a, hash_a), representative_ids);
+	}
+
+	/** Returns the entry as stored, for callers which do not look at the block fields */
+	vban::db_val<Val> block_stored_get (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const
 	{
 		vban::db_val<Val> result;
 		auto status = get (transaction_a, tables::blocks, hash_a, result);
@@ -871,6 +1330,45 @@ protected:
 		return result;
 	}
 
+	/**
+	 * Returns true if \p data_a is a state block entry, \p result_a is then set to its compact form.
+	 * Representatives seen for the first time are given the next id, writers of the blocks table are serialized and
+	 * write transactions always commit so the id is persisted together with the block using it.
+	 */
+	bool block_entry_compact (vban::write_transaction const & transaction_a, std::vector<uint8_t> const & data_a, std::vector<uint8_t> & result_a)
+	{
+		vban::account representative;
+		auto result (vban::block_encoding::compactable (data_a, representative));
+		if (result)
+		{
+			uint64_t id;
+			if (representative_ids.find (representative, id))
+			{
+				id = representative_ids.next ();
+				auto status (put (transaction_a, tables::representatives, vban::db_val<Val> (id), vban::db_val<Val> (representative)));
+				release_assert_success (status);
+				representative_ids.insert (id, representative);
+			}
+			vban::block_encoding::compact (data_a, id, result_a);
+		}
+		return result;
+	}
+
+	void representatives_load (vban::transaction const & transaction_a)
+	{
+		representative_ids.clear ();
+		for (auto i (make_iterator<uint64_t, vban::account> (transaction_a, tables::representatives)), n (vban::store_iterator<uint64_t, vban::account> (nullptr)); i != n; ++i)
+		{
+			representative_ids.insert (i->first, i->second);
+		}
+	}
+
+	/** Blocks table iterators decode compact entries */
+	vban::representative_dictionary const * block_dictionary (tables table_a) const
+	{
+		return table_a == tables::blocks ? &representative_ids : nullptr;
+	}
+
 	size_t block_successor_offset (vban::transaction const & transaction_a, size_t entry_size_a, vban::block_type type_a) const
 	{
 		return entry_size_a - vban::block_sideband::size (type_a);
@@ -879,7 +1377,8 @@ protected:
 	static vban::block_type block_type_from_raw (void * data_a)
 	{
 		// The block type is the first byte
-		return static_cast<vban::block_type> ((reinterpret_cast<uint8_t const *> (data_a))[0]);
+		auto type (reinterpret_cast<uint8_t const *> (data_a));
+		return vban::block_encoding::is_compact (type, 1) ? vban::block_type::state : static_cast<vban::block_type> (type[0]);
 	}
 
 	uint64_t count (vban::transaction const & transaction_a, std::initializer_list<tables> dbs_a) const
@@ -315,6 +315,88 @@ bool vban::pending_info::operator== (vban::pending_info const & other_a) const
 	return source == other_a.source && amount == other_a.amount && epoch == other_a.epoch;
 }
 
+void vban::pending_summary::add (vban::amount const & amount_a)
+{
+	// An amount equal to an inexact bound makes it exact again, no remaining entry is outside the bounds
+	if (count == 0 || amount_a < minimum)
+	{
+		minimum = amount_a;
+		minimum_count = 1;
+	}
+	else if (amount_a == minimum)
+	{
+		++minimum_count;
+	}
+	if (count == 0 || amount_a > maximum)
+	{
+		maximum = amount_a;
+		maximum_count = 1;
+	}
+	else if (amount_a == maximum)
+	{
+		++maximum_count;
+	}
+	total = total.number () + amount_a.number ();
+	++count;
+}
+
+void vban::pending_summary::remove (vban::amount const & amount_a)
+{
+	debug_assert (count > 1);
+	--count;
+	total = total.number () - amount_a.number ();
+	if (amount_a == minimum && minimum_count != 0)
+	{
+		--minimum_count;
+	}
+	if (amount_a == maximum && maximum_count != 0)
+	{
+		--maximum_count;
+	}
+	if (count == 1)
+	{
+		// The remaining amount is the total
+		minimum = total;
+		maximum = total;
+		minimum_count = 1;
+		maximum_count = 1;
+	}
+}
+
+void vban::pending_summary::serialize (vban::stream & stream_a) const
+{
+	vban::write (stream_a, count);
+	vban::write (stream_a, total);
+	vban::write (stream_a, minimum);
+	vban::write (stream_a, maximum);
+	vban::write (stream_a, minimum_count);
+	vban::write (stream_a, maximum_count);
+}
+
+bool vban::pending_summary::deserialize (vban::stream & stream_a)
+{
+	auto error (false);
+	try
+	{
+		vban::read (stream_a, count);
+		vban::read (stream_a, total);
+		vban::read (stream_a, minimum);
+		vban::read (stream_a, maximum);
+		vban::read (stream_a, minimum_count);
+		vban::read (stream_a, maximum_count);
+	}
+	catch (std::runtime_error const &)
+	{
+		error = true;
+	}
+	return error;
+}
+
+bool vban::pending_summary::operator== (vban::pending_summary const & other_a) const
+{
+	return count == other_a.count && total == other_a.total && minimum == other_a.minimum && maximum == other_a.maximum && minimum_count == other_a.minimum_count && maximum_count == other_a.maximum_count;
+}
+
 vban::pending_key::pending_key (vban::account const & account_a, vban::block_hash const & hash_a) :
 	account (account_a),
 	hash (hash_a)
@@ -347,6 +429,48 @@ vban::account const & vban::pending_key::key () const
 	return account;
 }
 
+vban::delegator_key::delegator_key (vban::account const & representative_a, vban::account const & account_a) :
+	representative (representative_a),
+	account (account_a)
+{
+}
+
+bool vban::delegator_key::operator== (vban::delegator_key const & other_a) const
+{
+	return representative == other_a.representative && account == other_a.account;
+}
+
+vban::account const & vban::delegator_key::key () const
+{
+	return representative;
+}
+
+vban::account_height_key::account_height_key (vban::account const & account_a, uint64_t height_a) :
+	account_m (account_a),
+	height_big_endian (boost::endian::native_to_big (height_a))
+{
+}
+
+bool vban::account_height_key::operator== (vban::account_height_key const & other_a) const
+{
+	return account_m == other_a.account_m && height_big_endian == other_a.height_big_endian;
+}
+
+vban::account const & vban::account_height_key::key () const
+{
+	return account_m;
+}
+
+vban::account const & vban::account_height_key::account () const
+{
+	return account_m;
+}
+
+uint64_t vban::account_height_key::height () const
+{
+	return boost::endian::big_to_native (height_big_endian);
+}
+
 vban::unchecked_info::unchecked_info (std::shared_ptr<vban::block> const & block_a, vban::account const & account_a, uint64_t modified_a, vban::signature_verification verified_a, bool confirmed_a) :
 	block (block_a),
 	account (account_a),
@@ -870,6 +994,11 @@ bool vban::unchecked_key::operator== (vban::unchecked_key const & other_a) const
 	return previous == other_a.previous && hash == other_a.hash;
 }
 
+bool vban::unchecked_key::operator< (vban::unchecked_key const & other_a) const
+{
+	return previous != other_a.previous ? previous < other_a.previous : hash < other_a.hash;
+}
+
 vban::block_hash const & vban::unchecked_key::key () const
 {
 	return previous;
@@ -123,6 +123,29 @@ public:
 	vban::amount amount{ 0 };
 	vban::epoch epoch{ vban::epoch::epoch_0 };
 };
+/**
+ * Number, total and range of the amounts pending for an account
+ * The minimum and maximum are bounds of the range, they are exact while some entries are known to equal them. Removing the last
+ * such entry leaves the bound in place instead of rescanning the account, until the range is rebuilt or only one entry is left.
+ */
+class pending_summary final
+{
+public:
+	void add (vban::amount const &);
+	/** Removes one of several entries, the last entry is removed by deleting the summary */
+	void remove (vban::amount const &);
+	void serialize (vban::stream &) const;
+	bool deserialize (vban::stream &);
+	bool operator== (vban::pending_summary const &) const;
+	uint64_t count{ 0 };
+	vban::amount total{ 0 };
+	vban::amount minimum{ 0 };
+	vban::amount maximum{ 0 };
+	/** Number of entries equal to the minimum and maximum, zero once the bound is no longer exact */
+	uint64_t minimum_count{ 0 };
+	uint64_t maximum_count{ 0 };
+};
+
 class pending_key final
 {
 public:
@@ -135,6 +158,38 @@ public:
 	vban::block_hash hash{ 0 };
 };
 
+/**
+ * Key of the delegators table, ordered by representative then delegating account
+ */
+class delegator_key final
+{
+public:
+	delegator_key () = default;
+	delegator_key (vban::account const & representative_a, vban::account const & account_a);
+	bool operator== (vban::delegator_key const &) const;
+	vban::account const & key () const;
+	vban::account representative{ 0 };
+	vban::account account{ 0 };
+};
+
+/**
+ * Key of the account_heights table, the height is stored big endian so entries of an account are ordered by height
+ */
+class account_height_key final
+{
+public:
+	account_height_key () = default;
+	account_height_key (vban::account const &, uint64_t height_a);
+	bool operator== (vban::account_height_key const &) const;
+	vban::account const & key () const;
+	vban::account const & account () const;
+	uint64_t height () const;
+
+private:
+	vban::account account_m{ 0 };
+	uint64_t height_big_endian{ 0 };
+};
+
 class endpoint_key final
 {
 public:
@@ -175,6 +230,8 @@ public:
 	unchecked_key (vban::uint512_union const &);
 	bool deserialize (vban::stream &);
 	bool operator== (vban::unchecked_key const &) const;
+	/** Same ordering as the unchecked table, by dependency then block hash */
+	bool operator< (vban::unchecked_key const &) const;
 	vban::block_hash const & key () const;
 	vban::block_hash previous{ 0 };
 	vban::block_hash hash{ 0 };
@@ -191,6 +248,17 @@ enum class signature_verification : uint8_t
 	valid_epoch = 3 // Valid for epoch blocks
 };
 
+/**
+ * Where a block waiting to be processed came from, each source has its own block processor queue
+ */
+enum class block_source : uint8_t
+{
+	local, // Blocks created by our wallets
+	live, // Blocks published on the network
+	bootstrap, // Blocks pulled by bootstrap attempts
+	unchecked // Blocks released from the unchecked table once their dependency arrived
+};
+
 /**
  * Information on an unchecked block
  */
@@ -207,6 +275,8 @@ public:
 	uint64_t modified{ 0 };
 	vban::signature_verification verified{ vban::signature_verification::unknown };
 	bool confirmed{ false };
+	/** Not serialized, only tracks the queue while the block is in the block processor */
+	vban::block_source source{ vban::block_source::live };
 };
 
 class block_info final
@@ -6,6 +6,7 @@
 #include <vban/secure/common.hpp>
 #include <vban/secure/ledger.hpp>
 
+#include <crypto/blake2/blake2.h>
 #include <crypto/cryptopp/words.h>
 
 namespace
@@ -37,7 +38,7 @@ public:
 			vban::account_info info;
 			[[maybe_unused]] auto error (ledger.store.account_get (transaction, pending.source, info));
 			debug_assert (!error);
-			ledger.store.pending_del (transaction, key);
+			ledger.pending_del (transaction, key);
 			ledger.cache.rep_weights.representation_add (info.representative, pending.amount.number ());
 			vban::account_info new_info (block_a.hashables.previous, info.representative, info.open_block, ledger.balance (transaction, block_a.hashables.previous), vban::seconds_since_epoch (), info.block_count - 1, vban::epoch::epoch_0);
 			ledger.update_account (transaction, pending.source, info, new_info);
@@ -63,7 +64,7 @@ public:
 		vban::account_info new_info (block_a.hashables.previous, info.representative, info.open_block, ledger.balance (transaction, block_a.hashables.previous), vban::seconds_since_epoch (), info.block_count - 1, vban::epoch::epoch_0);
 		ledger.update_account (transaction, destination_account, info, new_info);
 		ledger.store.block_del (transaction, hash);
-		ledger.store.pending_put (transaction, vban::pending_key (destination_account, block_a.hashables.source), { source_account, amount, vban::epoch::epoch_0 });
+		ledger.pending_put (transaction, vban::pending_key (destination_account, block_a.hashables.source), { source_account, amount, vban::epoch::epoch_0 });
 		ledger.store.frontier_del (transaction, hash);
 		ledger.store.frontier_put (transaction, block_a.hashables.previous, destination_account);
 		ledger.store.block_successor_clear (transaction, block_a.hashables.previous);
@@ -81,7 +82,7 @@ public:
 		vban::account_info new_info;
 		ledger.update_account (transaction, destination_account, new_info, new_info);
 		ledger.store.block_del (transaction, hash);
-		ledger.store.pending_put (transaction, vban::pending_key (destination_account, block_a.hashables.source), { source_account, amount, vban::epoch::epoch_0 });
+		ledger.pending_put (transaction, vban::pending_key (destination_account, block_a.hashables.source), { source_account, amount, vban::epoch::epoch_0 });
 		ledger.store.frontier_del (transaction, hash);
 		ledger.stats.inc (vban::stat::type::rollback, vban::stat::detail::open);
 	}
@@ -141,7 +142,7 @@ public:
 			{
 				error = ledger.rollback (transaction, ledger.latest (transaction, block_a.hashables.link.as_account ()), list);
 			}
-			ledger.store.pending_del (transaction, key);
+			ledger.pending_del (transaction, key);
 			ledger.stats.inc (vban::stat::type::rollback, vban::stat::detail::send);
 		}
 		else if (!block_a.hashables.link.is_zero () && !ledger.is_epoch_link (block_a.hashables.link))
@@ -150,7 +151,7 @@ public:
 			[[maybe_unused]] bool is_pruned (false);
 			auto source_account (ledger.account_safe (transaction, block_a.hashables.link.as_block_hash (), is_pruned));
 			vban::pending_info pending_info (source_account, block_a.hashables.balance.number () - balance, block_a.sideband ().source_epoch);
-			ledger.store.pending_put (transaction, vban::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
+			ledger.pending_put (transaction, vban::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
 			ledger.stats.inc (vban::stat::type::rollback, vban::stat::detail::receive);
 		}
 
@@ -368,11 +369,11 @@ void ledger_processor::state_block_impl (vban::state_block & block_a)
 						{
 							vban::pending_key key (block_a.hashables.link.as_account (), hash);
 							vban::pending_info info (block_a.hashables.account, amount.number (), epoch);
-							ledger.store.pending_put (transaction, key, info);
+							ledger.pending_put (transaction, key, info);
 						}
 						else if (!block_a.hashables.link.is_zero ())
 						{
-							ledger.store.pending_del (transaction, vban::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()));
+							ledger.pending_del (transaction, vban::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()));
 						}
 
 						vban::account_info new_info (hash, block_a.representative (), info.open_block.is_zero () ? hash : info.open_block, block_a.hashables.balance, vban::seconds_since_epoch (), info.block_count + 1, epoch);
@@ -566,7 +567,7 @@ void ledger_processor::send_block (vban::send_block & block_a)
 								ledger.store.block_put (transaction, hash, block_a);
 								vban::account_info new_info (hash, info.representative, info.open_block, block_a.hashables.balance, vban::seconds_since_epoch (), info.block_count + 1, vban::epoch::epoch_0);
 								ledger.update_account (transaction, account, info, new_info);
-								ledger.store.pending_put (transaction, vban::pending_key (block_a.hashables.destination, hash), { account, amount, vban::epoch::epoch_0 });
+								ledger.pending_put (transaction, vban::pending_key (block_a.hashables.destination, hash), { account, amount, vban::epoch::epoch_0 });
 								ledger.store.frontier_del (transaction, block_a.hashables.previous);
 								ledger.store.frontier_put (transaction, hash, account);
 								result.previous_balance = info.balance;
@@ -636,7 +637,7 @@ void ledger_processor::receive_block (vban::receive_block & block_a)
 												debug_assert (!error);
 											}
 #endif
-											ledger.store.pending_del (transaction, key);
+											ledger.pending_del (transaction, key);
 											block_a.sideband_set (vban::block_sideband (account, 0, new_balance, info.block_count + 1, vban::seconds_since_epoch (), block_details, vban::epoch::epoch_0 /* unused */));
 											ledger.store.block_put (transaction, hash, block_a);
 											vban::account_info new_info (hash, info.representative, info.open_block, new_balance, vban::seconds_since_epoch (), info.block_count + 1, vban::epoch::epoch_0);
@@ -708,7 +709,7 @@ void ledger_processor::open_block (vban::open_block & block_a)
 										debug_assert (!error);
 									}
 #endif
-									ledger.store.pending_del (transaction, key);
+									ledger.pending_del (transaction, key);
 									block_a.sideband_set (vban::block_sideband (block_a.hashables.account, 0, pending.amount, 1, vban::seconds_since_epoch (), block_details, vban::epoch::epoch_0 /* unused */));
 									ledger.store.block_put (transaction, hash, block_a);
 									vban::account_info new_info (hash, block_a.representative (), hash, pending.amount.number (), vban::seconds_since_epoch (), 1, vban::epoch::epoch_0);
@@ -734,6 +735,17 @@ ledger_processor::ledger_processor (vban::ledger & ledger_a, vban::write_transac
 {
 	result.verified = verification;
 }
+
+/** Flags of the ledger cache snapshot, one per generated cache */
+uint8_t constexpr cache_reps = 0x1;
+uint8_t constexpr cache_block_count = 0x2;
+uint8_t constexpr cache_account_count = 0x4;
+uint8_t constexpr cache_cemented_count = 0x8;
+
+uint8_t cache_snapshot_flags (vban::generate_cache const & generate_cache_a)
+{
+	return (generate_cache_a.reps ? cache_reps : 0) | (generate_cache_a.block_count ? cache_block_count : 0) | (generate_cache_a.account_count ? cache_account_count : 0) | (generate_cache_a.cemented_count ? cache_cemented_count : 0);
+}
 } // namespace
 
 vban::ledger::ledger (vban::block_store & store_a, vban::stat & stat_a, vban::generate_cache const & generate_cache_a) :
@@ -749,7 +761,16 @@ vban::ledger::ledger (vban::block_store & store_a, vban::stat & stat_a, vban::ge
 
 void vban::ledger::initialize (vban::generate_cache const & generate_cache_a)
 {
-	if (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.block_count)
+	if (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.block_count || generate_cache_a.cemented_count)
+	{
+		cache_snapshot_loaded = !cache_snapshot_read (store.tx_begin_read (), generate_cache_a);
+	}
+	if (cache_snapshot_loaded)
+	{
+		cache_generated = cache_snapshot_flags (generate_cache_a);
+	}
+
+	if (!cache_snapshot_loaded && (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.block_count))
 	{
 		store.accounts_for_each_par (
 		[this] (vban::read_transaction const & /*unused*/, vban::store_iterator<vban::account, vban::account_info> i, vban::store_iterator<vban::account, vban::account_info> n) {
@@ -767,9 +788,11 @@ void vban::ledger::initialize (vban::generate_cache const & generate_cache_a)
 			this->cache.account_count += account_count_l;
 			this->cache.rep_weights.copy_from (rep_weights_l);
 		});
+		// The scan fills all three together
+		cache_generated |= cache_reps | cache_block_count | cache_account_count;
 	}
 
-	if (generate_cache_a.cemented_count)
+	if (!cache_snapshot_loaded && generate_cache_a.cemented_count)
 	{
 		store.confirmation_height_for_each_par (
 		[this] (vban::read_transaction const & /*unused*/, vban::store_iterator<vban::account, vban::confirmation_height_info> i, vban::store_iterator<vban::account, vban::confirmation_height_info> n) {
@@ -780,6 +803,7 @@ void vban::ledger::initialize (vban::generate_cache const & generate_cache_a)
 			}
 			this->cache.cemented_count += cemented_count_l;
 		});
+		cache_generated |= cache_cemented_count;
 	}
 
 	auto transaction (store.tx_begin_read ());
@@ -793,6 +817,102 @@ void vban::ledger::initialize (vban::generate_cache const & generate_cache_a)
 	}
 }
 
+/*
+ * Snapshot layout: format version, store version, flags of the caches that were generated, block/account/cemented counts,
+ * representative weights, followed by a blake2b checksum of everything before it.
+ * Caches that were disabled are written empty and flagged as missing, so they are never restored as zero.
+ */
+void vban::ledger::cache_snapshot_write (vban::write_transaction const & transaction_a)
+{
+	std::vector<uint8_t> data;
+	{
+		vban::vectorstream stream (data);
+		vban::write (stream, cache_snapshot_version);
+		vban::write (stream, boost::endian::native_to_big (static_cast<uint32_t> (store.version_get (transaction_a))));
+		vban::write (stream, cache_generated);
+		vban::write (stream, boost::endian::native_to_big (cache.block_count.load ()));
+		vban::write (stream, boost::endian::native_to_big (cache.account_count.load ()));
+		vban::write (stream, boost::endian::native_to_big (cache.cemented_count.load ()));
+		auto rep_amounts (cache.rep_weights.get_rep_amounts ());
+		vban::write (stream, boost::endian::native_to_big (static_cast<uint64_t> (rep_amounts.size ())));
+		for (auto const & rep_amount : rep_amounts)
+		{
+			vban::write (stream, rep_amount.first);
+			vban::write (stream, vban::uint128_union (rep_amount.second));
+		}
+	}
+	auto checksum (cache_snapshot_checksum (data.data (), data.size ()));
+	data.insert (data.end (), checksum.bytes.begin (), checksum.bytes.end ());
+	store.cache_snapshot_put (transaction_a, data);
+}
+
+bool vban::ledger::cache_snapshot_read (vban::transaction const & transaction_a, vban::generate_cache const & generate_cache_a)
+{
+	std::vector<uint8_t> data;
+	auto error (store.cache_snapshot_get (transaction_a, data));
+	vban::uint256_union checksum;
+	error = error || data.size () < sizeof (checksum);
+	if (!error)
+	{
+		auto payload_size (data.size () - sizeof (checksum));
+		std::copy (data.begin () + payload_size, data.end (), checksum.bytes.begin ());
+		error = checksum != cache_snapshot_checksum (data.data (), payload_size);
+		vban::bufferstream stream (data.data (), payload_size);
+		uint8_t version (0);
+		uint32_t store_version (0);
+		uint8_t flags (0);
+		uint64_t block_count (0);
+		uint64_t account_count (0);
+		uint64_t cemented_count (0);
+		uint64_t rep_count (0);
+		error = error || vban::try_read (stream, version) || version != cache_snapshot_version;
+		error = error || vban::try_read (stream, store_version) || boost::endian::big_to_native (store_version) != static_cast<uint32_t> (store.version_get (transaction_a));
+		// Every requested cache has to be in the snapshot, otherwise the ledger is scanned
+		auto requested (cache_snapshot_flags (generate_cache_a));
+		error = error || vban::try_read (stream, flags) || (flags & requested) != requested;
+		error = error || vban::try_read (stream, block_count) || vban::try_read (stream, account_count) || vban::try_read (stream, cemented_count) || vban::try_read (stream, rep_count);
+		decltype (cache.rep_weights) rep_weights_l;
+		for (uint64_t i (0), n (boost::endian::big_to_native (rep_count)); !error && i < n; ++i)
+		{
+			vban::account representative;
+			vban::uint128_union weight;
+			error = vban::try_read (stream, representative) || vban::try_read (stream, weight);
+			rep_weights_l.representation_put (representative, weight);
+		}
+		error = error || stream.in_avail () != 0;
+		if (!error)
+		{
+			if (generate_cache_a.block_count)
+			{
+				cache.block_count = boost::endian::big_to_native (block_count);
+			}
+			if (generate_cache_a.account_count)
+			{
+				cache.account_count = boost::endian::big_to_native (account_count);
+			}
+			if (generate_cache_a.cemented_count)
+			{
+				cache.cemented_count = boost::endian::big_to_native (cemented_count);
+			}
+			if (generate_cache_a.reps)
+			{
+				cache.rep_weights.copy_from (rep_weights_l);
+			}
+		}
+	}
+	return error;
+}
+
+vban::uint256_union vban::ledger::cache_snapshot_checksum (uint8_t const * data_a, size_t size_a) const
+{
+	vban::uint256_union result;
+	blake2b_state hash;
+	blake2b_init (&hash, sizeof (result.bytes));
+	blake2b_update (&hash, data_a, size_a);
+	blake2b_final (&hash, result.bytes.data (), sizeof (result.bytes));
+	return result;
+}
+
 // Balance for account containing hash
 vban::uint256_t vban::ledger::balance (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const
 {
@@ -841,8 +961,7 @@ vban::uint256_t vban::ledger::account_balance (vban::transaction const & transac
 vban::uint256_t vban::ledger::account_pending (vban::transaction const & transaction_a, vban::account const & account_a, bool only_confirmed_a)
 {
 	vban::uint256_t result (0);
-	vban::account end (account_a.number () + 1);
-	for (auto i (store.pending_begin (transaction_a, vban::pending_key (account_a, 0))), n (store.pending_begin (transaction_a, vban::pending_key (end, 0))); i != n; ++i)
+	for (auto i (store.pending_begin (transaction_a, account_a)), n (store.pending_end ()); i != n && i->first.account == account_a; ++i)
 	{
 		vban::pending_info const & info (i->second);
 		if (only_confirmed_a)
@@ -868,6 +987,10 @@ vban::process_return vban::ledger::process (vban::write_transaction const & tran
 	if (processor.result.code == vban::process_result::progress)
 	{
 		++cache.block_count;
+		if (account_heights_enabled)
+		{
+			store.account_height_put (transaction_a, store.block_account_calculated (block_a), block_a.sideband ().height, block_a.hash ());
+		}
 	}
 	return processor.result;
 }
@@ -893,11 +1016,17 @@ bool vban::ledger::block_or_pruned_exists (vban::block_hash const & hash_a) cons
 
 bool vban::ledger::block_or_pruned_exists (vban::transaction const & transaction_a, vban::block_hash const & hash_a) const
 {
-	if (store.pruned_exists (transaction_a, hash_a))
+	if (store.block_filter_excludes (hash_a))
 	{
-		return true;
+		stats.inc (vban::stat::type::ledger, vban::stat::detail::block_filter_negative);
+		return false;
+	}
+	auto result (store.pruned_exists (transaction_a, hash_a) || store.block_exists (transaction_a, hash_a));
+	if (!result && store.block_filter_enabled ())
+	{
+		stats.inc (vban::stat::type::ledger, vban::stat::detail::block_filter_false_positive);
 	}
-	return store.block_exists (transaction_a, hash_a);
+	return result;
 }
 
 std::string vban::ledger::block_text (char const * hash_a)
@@ -1032,6 +1161,16 @@ vban::uint256_t vban::ledger::weight (vban::account const & account_a)
 	return cache.rep_weights.representation_get (account_a);
 }
 
+// Vote weight of an account in the fixed width type used by vote tallies
+vban::uint256_fixed vban::ledger::weight_fixed (vban::account const & account_a)
+{
+	if (check_bootstrap_weights.load ())
+	{
+		return vban::uint256_fixed (weight (account_a));
+	}
+	return cache.rep_weights.representation_get_fixed (account_a);
+}
+
 // Rollback blocks until `block_a' doesn't exist or it tries to penetrate the confirmation height
 bool vban::ledger::rollback (vban::write_transaction const & transaction_a, vban::block_hash const & block_a, std::vector<std::shared_ptr<vban::block>> & list_a)
 {
@@ -1056,6 +1195,10 @@ bool vban::ledger::rollback (vban::write_transaction const & transaction_a, vban
 			if (!error)
 			{
 				--cache.block_count;
+				if (account_heights_enabled)
+				{
+					store.account_height_del (transaction_a, account_l, block->sideband ().height);
+				}
 			}
 		}
 		else
@@ -1247,6 +1390,22 @@ vban::link const & vban::ledger::epoch_link (vban::epoch epoch_a) const
 
 void vban::ledger::update_account (vban::write_transaction const & transaction_a, vban::account const & account_a, vban::account_info const & old_a, vban::account_info const & new_a)
 {
+	if (delegators_enabled)
+	{
+		// Compare against the stored info, old_a is empty when rolling back legacy open blocks
+		vban::account_info existing;
+		auto exists (!store.account_get (transaction_a, account_a, existing));
+		auto remains (!new_a.head.is_zero ());
+		auto moved (exists && remains && existing.representative != new_a.representative);
+		if (exists && (!remains || moved))
+		{
+			store.delegator_del (transaction_a, existing.representative, account_a);
+		}
+		if (remains && (!exists || moved))
+		{
+			store.delegator_put (transaction_a, new_a.representative, account_a);
+		}
+	}
 	if (!new_a.head.is_zero ())
 	{
 		if (old_a.head.is_zero () && new_a.open_block == new_a.head)
@@ -1371,6 +1530,155 @@ uint64_t vban::ledger::pruning_action (vban::write_transaction & transaction_a,
 	return pruned_count;
 }
 
+void vban::ledger::pending_put (vban::write_transaction const & transaction_a, vban::pending_key const & key_a, vban::pending_info const & info_a)
+{
+	store.pending_put (transaction_a, key_a, info_a);
+	if (pending_summary_enabled)
+	{
+		vban::pending_summary summary;
+		store.pending_summary_get (transaction_a, key_a.account, summary);
+		summary.add (info_a.amount);
+		store.pending_summary_put (transaction_a, key_a.account, summary);
+	}
+}
+
+void vban::ledger::pending_del (vban::write_transaction const & transaction_a, vban::pending_key const & key_a)
+{
+	if (pending_summary_enabled)
+	{
+		vban::pending_info info;
+		vban::pending_summary summary;
+		auto error (store.pending_get (transaction_a, key_a, info));
+		error = error || store.pending_summary_get (transaction_a, key_a.account, summary);
+		debug_assert (!error);
+		if (!error)
+		{
+			if (summary.count <= 1)
+			{
+				store.pending_summary_del (transaction_a, key_a.account);
+			}
+			else
+			{
+				// Constant time, a removed bound is kept as a looser bound rather than rescanning the account
+				summary.remove (info.amount);
+				store.pending_summary_put (transaction_a, key_a.account, summary);
+			}
+		}
+	}
+	store.pending_del (transaction_a, key_a);
+}
+
+bool vban::ledger::pending_summary_excludes (vban::transaction const & transaction_a, vban::account const & account_a, vban::amount const & threshold_a) const
+{
+	bool result (false);
+	if (pending_summary_enabled)
+	{
+		vban::pending_summary summary;
+		result = store.pending_summary_get (transaction_a, account_a, summary) || summary.maximum < threshold_a;
+	}
+	return result;
+}
+
+uint64_t vban::ledger::account_heights_rebuild (uint64_t batch_size_a)
+{
+	uint64_t result (0);
+	auto transaction (store.tx_begin_write ({ vban::tables::account_heights, vban::tables::meta }));
+	store.account_heights_complete_set (transaction, false);
+	store.account_heights_clear (transaction);
+	auto read_transaction (store.tx_begin_read ());
+	for (auto i (store.block_views_begin (read_transaction)), n (store.block_views_end ()); i != n; ++i)
+	{
+		auto const & view (i->second);
+		store.account_height_put (transaction, view.account (), view.height (), i->first);
+		if (++result % batch_size_a == 0)
+		{
+			transaction.commit ();
+			transaction.renew ();
+		}
+	}
+	store.account_heights_complete_set (transaction, true);
+	return result;
+}
+
+uint64_t vban::ledger::delegators_rebuild (uint64_t batch_size_a)
+{
+	{
+		auto transaction (store.tx_begin_write ({ vban::tables::delegators, vban::tables::meta }));
+		store.delegators_complete_set (transaction, false);
+		store.delegators_clear (transaction);
+	}
+	std::atomic<uint64_t> result{ 0 };
+	store.accounts_for_each_par (
+	[this, &result, batch_size_a] (vban::read_transaction const & /*unused*/, auto i, auto n) {
+		std::vector<vban::account> batch;
+		auto flush = [this, &batch, &result] () {
+			if (!batch.empty ())
+			{
+				// Representatives are read again under the delegators lock, the traversal snapshot may be older than changes the ledger already indexed
+				auto transaction (store.tx_begin_write ({ vban::tables::delegators }));
+				for (auto const & account : batch)
+				{
+					vban::account_info info;
+					if (!store.account_get (transaction, account, info))
+					{
+						store.delegator_put (transaction, info.representative, account);
+						++result;
+					}
+				}
+				batch.clear ();
+			}
+		};
+		for (; i != n; ++i)
+		{
+			batch.push_back (i->first);
+			if (batch.size () >= batch_size_a)
+			{
+				flush ();
+			}
+		}
+		flush ();
+	});
+	auto transaction (store.tx_begin_write ({ vban::tables::meta }));
+	store.delegators_complete_set (transaction, true);
+	return result;
+}
+
+uint64_t vban::ledger::pending_summary_rebuild (uint64_t batch_size_a)
+{
+	uint64_t result (0);
+	auto transaction (store.tx_begin_write ({ vban::tables::meta, vban::tables::pending_summary }));
+	store.pending_summary_complete_set (transaction, false);
+	store.pending_summary_clear (transaction);
+	auto read_transaction (store.tx_begin_read ());
+	// Entries are ordered by account so each summary is complete once the next account starts
+	vban::account account (0);
+	vban::pending_summary summary;
+	auto flush = [this, &transaction, &result, &account, &summary, batch_size_a] () {
+		if (summary.count != 0)
+		{
+			store.pending_summary_put (transaction, account, summary);
+			if (++result % batch_size_a == 0)
+			{
+				transaction.commit ();
+				transaction.renew ();
+			}
+		}
+	};
+	for (auto i (store.pending_begin (read_transaction)), n (store.pending_end ()); i != n; ++i)
+	{
+		if (i->first.account != account)
+		{
+			flush ();
+			account = i->first.account;
+			summary = vban::pending_summary ();
+		}
+		summary.add (i->second.amount);
+	}
+	flush ();
+	store.pending_summary_complete_set (transaction, true);
+	return result;
+}
+
 std::multimap<uint64_t, vban::uncemented_info, std::greater<>> vban::ledger::unconfirmed_frontiers () const
 {
 	vban::locked<std::multimap<uint64_t, vban::uncemented_info, std::greater<>>> result;
@@ -1409,6 +1717,11 @@ bool vban::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data
 	vban::set_secure_perm_directory (data_path_a, error_chmod);
 	auto rockdb_data_path = data_path_a / "rocksdb";
 	boost::filesystem::remove_all (rockdb_data_path);
+	// Sorted files of a bulk load which failed or was never ingested are removed however the migration ends
+	vban::cleanup_guard bulk_cleanup ({ [&rockdb_data_path] () {
+		boost::system::error_code error_remove;
+		boost::filesystem::remove_all (rockdb_data_path / "bulk", error_remove);
+	} });
 
 	vban::logger_mt logger;
 	auto error (false);
@@ -1420,21 +1733,71 @@ bool vban::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data
 
 	if (!rocksdb_store->init_error ())
 	{
-		store.blocks_for_each_par (
-		[&rocksdb_store] (vban::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { vban::tables::blocks }));
-
-				std::vector<uint8_t> vector;
+		// The large tables are written to sorted files in parallel and ingested at once, skipping the memtable, write ahead log and compactions
+		vban::locked<std::vector<std::unique_ptr<vban::bulk_writer>>> writers;
+		std::atomic<bool> bulk_error{ false };
+		auto bulk_load = [&rocksdb_store, &writers, &bulk_error] (vban::tables table_a, auto const & put_a) {
+			return [&rocksdb_store, &writers, &bulk_error, table_a, &put_a] (vban::read_transaction const & /*unused*/, auto i, auto n) {
+				auto writer (rocksdb_store->bulk_writer_make (table_a));
+				if (writer != nullptr)
 				{
-					vban::vectorstream stream (vector);
-					vban::serialize_block (stream, *i->second.block);
-					i->second.sideband.serialize (stream, i->second.block->type ());
+					for (; i != n; ++i)
+					{
+						put_a (*writer, i);
+					}
+					bulk_error = writer->finish () || bulk_error;
+					writers->push_back (std::move (writer));
+				}
+				else
+				{
+					bulk_error = true;
 				}
-				rocksdb_store->block_raw_put (rocksdb_transaction, vector, i->first);
+			};
+		};
+
+		auto blocks_put = [] (vban::bulk_writer & writer_a, auto & i) {
+			std::vector<uint8_t> vector;
+			{
+				vban::vectorstream stream (vector);
+				vban::serialize_block (stream, *i->second.block);
+				i->second.sideband.serialize (stream, i->second.block->type ());
 			}
-		});
+			writer_a.block_raw_put (vector, i->first);
+		};
+		store.blocks_for_each_par (bulk_load (vban::tables::blocks, blocks_put));
+
+		auto pending_put = [] (vban::bulk_writer & writer_a, auto & i) {
+			writer_a.pending_put (i->first, i->second);
+		};
+		store.pending_for_each_par (bulk_load (vban::tables::pending, pending_put));
+
+		auto confirmation_height_put = [] (vban::bulk_writer & writer_a, auto & i) {
+			writer_a.confirmation_height_put (i->first, i->second);
+		};
+		store.confirmation_height_for_each_par (bulk_load (vban::tables::confirmation_height, confirmation_height_put));
+
+		auto accounts_put = [] (vban::bulk_writer & writer_a, auto & i) {
+			writer_a.account_put (i->first, i->second);
+		};
+		store.accounts_for_each_par (bulk_load (vban::tables::accounts, accounts_put));
+
+		auto account_heights_put = [] (vban::bulk_writer & writer_a, auto & i) {
+			writer_a.account_height_put (i->first.account (), i->first.height (), i->second);
+		};
+		store.account_heights_for_each_par (bulk_load (vban::tables::account_heights, account_heights_put));
+
+		auto delegators_put = [] (vban::bulk_writer & writer_a, auto & i) {
+			writer_a.delegator_put (i->first.representative, i->first.account);
+		};
+		store.delegators_for_each_par (bulk_load (vban::tables::delegators, delegators_put));
+
+		auto pending_summary_put = [] (vban::bulk_writer & writer_a, auto & i) {
+			writer_a.pending_summary_put (i->first, i->second);
+		};
+		store.pending_summary_for_each_par (bulk_load (vban::tables::pending_summary, pending_summary_put));
+
+		// Files of a failed load are not ingested
+		error |= bulk_error || rocksdb_store->bulk_ingest (writers.lock ().get ());
 
 		store.unchecked_for_each_par (
 		[&rocksdb_store] (vban::read_transaction const & /*unused*/, auto i, auto n) {
@@ -1445,33 +1808,6 @@ bool vban::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data
 			}
 		});
 
-		store.pending_for_each_par (
-		[&rocksdb_store] (vban::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { vban::tables::pending }));
-				rocksdb_store->pending_put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.confirmation_height_for_each_par (
-		[&rocksdb_store] (vban::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { vban::tables::confirmation_height }));
-				rocksdb_store->confirmation_height_put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.accounts_for_each_par (
-		[&rocksdb_store] (vban::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { vban::tables::accounts }));
-				rocksdb_store->account_put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
 		store.frontiers_for_each_par (
 		[&rocksdb_store] (vban::read_transaction const & /*unused*/, auto i, auto n) {
 			for (; i != n; ++i)
@@ -1504,6 +1840,11 @@ bool vban::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data
 		auto rocksdb_transaction (rocksdb_store->tx_begin_write ());
 		rocksdb_store->version_put (rocksdb_transaction, version);
 
+		// The optional indexes are copied whole, they are exactly as complete as in the source ledger
+		rocksdb_store->account_heights_complete_set (rocksdb_transaction, store.account_heights_complete (lmdb_transaction));
+		rocksdb_store->delegators_complete_set (rocksdb_transaction, store.delegators_complete (lmdb_transaction));
+		rocksdb_store->pending_summary_complete_set (rocksdb_transaction, store.pending_summary_complete (lmdb_transaction));
+
 		for (auto i (store.online_weight_begin (lmdb_transaction)), n (store.online_weight_end ()); i != n; ++i)
 		{
 			rocksdb_store->online_weight_put (rocksdb_transaction, i->first, i->second);
@@ -1529,6 +1870,8 @@ bool vban::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data
 		auto account = random_block->account ().is_zero () ? random_block->sideband ().account : random_block->account ();
 		vban::account_info account_info;
 		error |= rocksdb_store->account_get (rocksdb_transaction, account, account_info);
+		auto height (random_block->sideband ().height);
+		error |= store.account_height_get (lmdb_transaction, account, height) != rocksdb_store->account_height_get (rocksdb_transaction, account, height);
 
 		// If confirmation height exists in the lmdb ledger for this account it should exist in the rocksdb ledger
 		vban::confirmation_height_info confirmation_height_info;
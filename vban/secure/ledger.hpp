@@ -38,6 +38,7 @@ public:
 	vban::uint256_t account_balance (vban::transaction const &, vban::account const &, bool = false);
 	vban::uint256_t account_pending (vban::transaction const &, vban::account const &, bool = false);
 	vban::uint256_t weight (vban::account const &);
+	vban::uint256_fixed weight_fixed (vban::account const &);
 	std::shared_ptr<vban::block> successor (vban::transaction const &, vban::qualified_root const &);
 	std::shared_ptr<vban::block> forked_block (vban::transaction const &, vban::block const &);
 	bool block_confirmed (vban::transaction const &, vban::block_hash const &) const;
@@ -57,6 +58,11 @@ public:
 	bool rollback (vban::write_transaction const &, vban::block_hash const &, std::vector<std::shared_ptr<vban::block>> &);
 	bool rollback (vban::write_transaction const &, vban::block_hash const &);
 	void update_account (vban::write_transaction const &, vban::account const &, vban::account_info const &, vban::account_info const &);
+	/** Writes to the pending table, keeping the pending_summary index up to date */
+	void pending_put (vban::write_transaction const &, vban::pending_key const &, vban::pending_info const &);
+	void pending_del (vban::write_transaction const &, vban::pending_key const &);
+	/** Returns true if the pending_summary index proves \p account_a has nothing pending of at least \p threshold_a */
+	bool pending_summary_excludes (vban::transaction const &, vban::account const & account_a, vban::amount const & threshold_a) const;
 	uint64_t pruning_action (vban::write_transaction &, vban::block_hash const &, uint64_t const);
 	void dump_account_chain (vban::account const &, std::ostream & = std::cout);
 	bool could_fit (vban::transaction const &, vban::block const &) const;
@@ -67,6 +73,17 @@ public:
 	vban::link const & epoch_link (vban::epoch) const;
 	std::multimap<uint64_t, uncemented_info, std::greater<>> unconfirmed_frontiers () const;
 	bool migrate_lmdb_to_rocksdb (boost::filesystem::path const &) const;
+	/** Persists rep weights and counters so the next startup can skip the account scan. Nothing may write to the ledger afterwards */
+	void cache_snapshot_write (vban::write_transaction const &);
+	/** Rebuilds the account_heights index from the blocks table and marks it complete, returns the number of entries. Nothing may write to the ledger while it runs */
+	uint64_t account_heights_rebuild (uint64_t batch_size_a = 64 * 1024);
+	/**
+	 * Rebuilds the delegators index from the accounts table in parallel and marks it complete, returns the number of entries.
+	 * The ledger may be written to while it runs as long as delegators_enabled is set beforehand
+	 */
+	uint64_t delegators_rebuild (uint64_t batch_size_a = 64 * 1024);
+	/** Rebuilds the pending_summary index from the pending table and marks it complete, returns the number of accounts. Nothing may write to the ledger while it runs */
+	uint64_t pending_summary_rebuild (uint64_t batch_size_a = 64 * 1024);
 	static vban::uint256_t const unit;
 	vban::network_params network_params;
 	vban::block_store & store;
@@ -77,9 +94,22 @@ public:
 	uint64_t bootstrap_weight_max_blocks{ 1 };
 	std::atomic<bool> check_bootstrap_weights;
 	bool pruning{ false };
+	/** Keep the account_heights index up to date while processing and rolling back blocks */
+	bool account_heights_enabled{ false };
+	/** Keep the delegators index up to date when account representatives change */
+	bool delegators_enabled{ false };
+	/** Keep the pending_summary index up to date when pending entries are added or removed */
+	bool pending_summary_enabled{ false };
+	/** Set if the cache was restored from a snapshot instead of scanning the ledger */
+	bool cache_snapshot_loaded{ false };
 
 private:
 	void initialize (vban::generate_cache const &);
+	bool cache_snapshot_read (vban::transaction const &, vban::generate_cache const &);
+	vban::uint256_union cache_snapshot_checksum (uint8_t const *, size_t) const;
+	/** Snapshot flags of the caches holding complete values */
+	uint8_t cache_generated{ 0 };
+	static uint8_t constexpr cache_snapshot_version = 2;
 };
 
 std::unique_ptr<container_info_component> collect_container_info (ledger & ledger, std::string const & name);
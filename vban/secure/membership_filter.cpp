@@ -0,0 +1,104 @@
+#include <vban/crypto_lib/random_pool.hpp>
+#include <vban/secure/membership_filter.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+uint64_t random_seed ()
+{
+	uint64_t result;
+	vban::random_pool::generate_block (reinterpret_cast<uint8_t *> (&result), sizeof (result));
+	return result;
+}
+}
+
+size_t constexpr vban::membership_filter::words_per_block;
+unsigned constexpr vban::membership_filter::bits_per_key;
+
+vban::membership_filter::membership_filter (size_t capacity_a, size_t bits_per_entry_a) :
+	block_count (std::max<size_t> (1, capacity_a * bits_per_entry_a / (words_per_block * 64))),
+	// Keyed so peers cannot pick hashes which crowd the same blocks
+	seed (random_seed ()),
+	words (std::make_unique<std::atomic<uint64_t>[]> (block_count * words_per_block))
+{
+}
+
+uint64_t vban::membership_filter::digest (vban::uint256_union const & key_a) const
+{
+	// Block hashes are already uniform but other keys, such as small test values, may differ in a single word
+	auto result (mix (key_a.qwords[0]));
+	for (auto i (1u); i < key_a.qwords.size (); ++i)
+	{
+		result = mix (result ^ key_a.qwords[i]);
+	}
+	return result;
+}
+
+uint64_t vban::membership_filter::mix (uint64_t value_a) const
+{
+	// splitmix64 finalizer
+	value_a += seed;
+	value_a = (value_a ^ (value_a >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	value_a = (value_a ^ (value_a >> 27)) * 0x94d049bb133111ebULL;
+	return value_a ^ (value_a >> 31);
+}
+
+namespace
+{
+/** Bit positions are derived by double hashing inside the 512 bit block, an odd stride keeps them distinct */
+template <typename Action>
+void for_each_word (uint64_t hash_a, unsigned bits_a, Action const & action_a)
+{
+	std::array<uint64_t, 8> masks{};
+	auto position (hash_a & 511);
+	auto stride ((hash_a >> 9) | 1);
+	for (auto i (0u); i < bits_a; ++i)
+	{
+		masks[position >> 6] |= uint64_t (1) << (position & 63);
+		position = (position + stride) & 511;
+	}
+	for (auto i (0u); i < masks.size (); ++i)
+	{
+		if (masks[i] != 0 && !action_a (i, masks[i]))
+		{
+			break;
+		}
+	}
+}
+}
+
+void vban::membership_filter::insert (vban::uint256_union const & key_a)
+{
+	auto hash (digest (key_a));
+	auto base (words.get () + (hash % block_count) * words_per_block);
+	for_each_word (mix (hash), bits_per_key, [base] (unsigned word_a, uint64_t mask_a) {
+		base[word_a].fetch_or (mask_a, std::memory_order_release);
+		return true;
+	});
+}
+
+bool vban::membership_filter::may_contain (vban::uint256_union const & key_a) const
+{
+	auto hash (digest (key_a));
+	auto base (words.get () + (hash % block_count) * words_per_block);
+	bool result (true);
+	for_each_word (mix (hash), bits_per_key, [base, &result] (unsigned word_a, uint64_t mask_a) {
+		result = (base[word_a].load (std::memory_order_acquire) & mask_a) == mask_a;
+		return result;
+	});
+	return result;
+}
+
+size_t vban::membership_filter::size_bytes () const
+{
+	return block_count * words_per_block * sizeof (uint64_t);
+}
+
+std::unique_ptr<vban::container_info_component> vban::collect_container_info (membership_filter & membership_filter, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "bytes", membership_filter.size_bytes (), 1 }));
+	return composite;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vban/lib/numbers.hpp>
+#include <vban/lib/utility.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace vban
+{
+/**
+ * Blocked bloom filter over 256 bit digests (block hashes), used to answer definite misses without touching the database.
+ * Every key sets bits inside a single cache line, so a lookup costs one memory access. Elements cannot be removed,
+ * stale entries and filling the filter past its capacity only raise the false positive rate.
+ * @note This class is thread-safe, inserts happen before the inserting write transaction commits so no reader misses them
+ */
+class membership_filter final
+{
+public:
+	membership_filter (size_t capacity_a, size_t bits_per_entry_a);
+	void insert (vban::uint256_union const &);
+	/** Returns false if \p key_a was never inserted, true if it may have been */
+	bool may_contain (vban::uint256_union const & key_a) const;
+	size_t size_bytes () const;
+
+private:
+	uint64_t digest (vban::uint256_union const &) const;
+	uint64_t mix (uint64_t) const;
+
+	static size_t constexpr words_per_block = 8;
+	static unsigned constexpr bits_per_key = 8;
+	size_t const block_count;
+	uint64_t const seed;
+	std::unique_ptr<std::atomic<uint64_t>[]> words;
+};
+
+std::unique_ptr<container_info_component> collect_container_info (membership_filter & membership_filter, std::string const & name);
+}
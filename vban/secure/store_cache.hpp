@@ -0,0 +1,180 @@
+#pragma once
+
+#include <vban/lib/locks.hpp>
+#include <vban/lib/numbers.hpp>
+#include <vban/lib/utility.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <array>
+#include <atomic>
+
+namespace vban
+{
+/**
+ * Bounded LRU cache in front of a store table keyed by a uniformly distributed 256 bit key (account or block hash).
+ * The owning store decides when entries may be used: see the accounts and blocks caches in block_store_partial.
+ * @note This class is thread-safe, entries are spread over independently locked shards
+ */
+template <typename Key, typename Value>
+class store_cache final
+{
+public:
+	/** Changes the maximum number of entries, evicting the least recently used ones if it shrinks. 0 disables the cache */
+	void resize (size_t max_entries_a)
+	{
+		max_shard_size = (max_entries_a + shard_count - 1) / shard_count;
+		for (auto & shard_l : shards)
+		{
+			vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+			trim (shard_l);
+		}
+	}
+
+	bool enabled () const
+	{
+		return max_shard_size != 0;
+	}
+
+	/** Returns false and sets \p value_a if \p key_a is cached, same convention as the store getters */
+	bool get (Key const & key_a, Value & value_a)
+	{
+		return get (key_a, value_a, [] (Value const &) { return true; });
+	}
+
+	/** Same as above, entries rejected by \p valid_a are treated as misses */
+	template <typename Valid>
+	bool get (Key const & key_a, Value & value_a, Valid const & valid_a)
+	{
+		if (!enabled ())
+		{
+			return true;
+		}
+		bool result (true);
+		auto & shard_l (shard_for (key_a));
+		{
+			vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+			auto & hashed (shard_l.entries.template get<1> ());
+			auto existing (hashed.find (key_a));
+			if (existing != hashed.end () && valid_a (existing->value))
+			{
+				shard_l.entries.relocate (shard_l.entries.end (), shard_l.entries.template project<0> (existing));
+				value_a = existing->value;
+				result = false;
+			}
+		}
+		++(result ? misses : hits);
+		return result;
+	}
+
+	void put (Key const & key_a, Value const & value_a)
+	{
+		if (enabled ())
+		{
+			auto & shard_l (shard_for (key_a));
+			vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+			auto & hashed (shard_l.entries.template get<1> ());
+			auto existing (hashed.find (key_a));
+			if (existing != hashed.end ())
+			{
+				hashed.modify (existing, [&value_a] (entry & entry_a) {
+					entry_a.value = value_a;
+				});
+				shard_l.entries.relocate (shard_l.entries.end (), shard_l.entries.template project<0> (existing));
+			}
+			else
+			{
+				shard_l.entries.push_back (entry{ key_a, value_a });
+				trim (shard_l);
+			}
+		}
+	}
+
+	void erase (Key const & key_a)
+	{
+		auto & shard_l (shard_for (key_a));
+		vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+		shard_l.entries.template get<1> ().erase (key_a);
+	}
+
+	void clear ()
+	{
+		for (auto & shard_l : shards)
+		{
+			vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+			shard_l.entries.clear ();
+		}
+	}
+
+	size_t size ()
+	{
+		size_t result (0);
+		for (auto & shard_l : shards)
+		{
+			vban::lock_guard<vban::mutex> guard (shard_l.mutex);
+			result += shard_l.entries.size ();
+		}
+		return result;
+	}
+
+	std::atomic<uint64_t> hits{ 0 };
+	std::atomic<uint64_t> misses{ 0 };
+
+private:
+	class entry final
+	{
+	public:
+		Key key;
+		Value value;
+	};
+
+public:
+	/** Approximate footprint of an entry, including the list links, hash bucket and allocator overhead */
+	static size_t constexpr entry_size = sizeof (entry) + 6 * sizeof (void *);
+
+private:
+	class shard final
+	{
+	public:
+		// clang-format off
+		boost::multi_index_container<entry,
+		boost::multi_index::indexed_by<
+			boost::multi_index::sequenced<>,
+			boost::multi_index::hashed_unique<boost::multi_index::member<entry, Key, &entry::key>, std::hash<Key>>>>
+		entries;
+		// clang-format on
+		vban::mutex mutex{ mutex_identifier (mutexes::store_cache) };
+	};
+
+	shard & shard_for (Key const & key_a)
+	{
+		// Keys are public keys or digests, any byte selects a shard evenly
+		return shards[key_a.bytes[0] % shard_count];
+	}
+
+	void trim (shard & shard_a)
+	{
+		while (shard_a.entries.size () > max_shard_size)
+		{
+			shard_a.entries.pop_front ();
+		}
+	}
+
+	static size_t constexpr shard_count = 16;
+	std::atomic<size_t> max_shard_size{ 0 };
+	std::array<shard, shard_count> shards;
+};
+
+template <typename Key, typename Value>
+std::unique_ptr<container_info_component> collect_container_info (store_cache<Key, Value> & store_cache, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", store_cache.size (), store_cache.entry_size }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hits", static_cast<size_t> (store_cache.hits), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "misses", static_cast<size_t> (store_cache.misses), 0 }));
+	return composite;
+}
+}
@@ -1,6 +1,7 @@
 #include <vban/crypto_lib/random_pool.hpp>
 #include <vban/lib/threading.hpp>
 #include <vban/node/election.hpp>
+#include <vban/node/rocksdb/rocksdb.hpp>
 #include <vban/node/testing.hpp>
 #include <vban/node/transport/udp.hpp>
 #include <vban/test_common/network.hpp>
@@ -224,10 +225,8 @@ TEST (node, fork_storm)
 			}
 			else
 			{
-				vban::unique_lock<vban::mutex> lock (node_a->active.mutex);
-				auto election = node_a->active.roots.begin ()->election;
-				lock.unlock ();
-				if (election->votes ().size () == 1)
+				auto elections = node_a->active.list_active (1);
+				if (!elections.empty () && elections.front ()->votes ().size () == 1)
 				{
 					++single;
 				}
@@ -461,6 +460,60 @@ TEST (store, pruned_load)
 	}
 }
 
+// Compares pending lookups of accounts seeking in total order against prefix seeks which skip files through the prefix bloom filters
+TEST (store, pending_prefix_seek)
+{
+	vban::logger_mt logger;
+	auto store = std::make_unique<vban::rocksdb_store> (logger, vban::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	constexpr auto num_accounts = 1000000;
+	constexpr auto num_lookups = 200000;
+	constexpr auto batch_size = 10000;
+	std::vector<vban::account> accounts (num_accounts);
+	for (auto & account : accounts)
+	{
+		vban::random_pool::generate_block (account.bytes.data (), account.bytes.size ());
+	}
+	// Batches written in random key order end up in overlapping files, which every total order seek has to read
+	for (auto i (0); i < num_accounts; i += batch_size)
+	{
+		auto transaction (store->tx_begin_write ());
+		for (auto k (i); k < i + batch_size; ++k)
+		{
+			store->pending_put (transaction, vban::pending_key (accounts[k], vban::block_hash (k)), { accounts[k], k, vban::epoch::epoch_0 });
+		}
+	}
+	std::vector<vban::account> missing (num_lookups);
+	for (auto & account : missing)
+	{
+		vban::random_pool::generate_block (account.bytes.data (), account.bytes.size ());
+	}
+	auto lookup = [&store] (std::vector<vban::account> const & accounts_a, bool prefix_a) {
+		auto transaction (store->tx_begin_read ());
+		size_t found (0);
+		auto begin (std::chrono::steady_clock::now ());
+		for (auto const & account : accounts_a)
+		{
+			auto i (prefix_a ? store->pending_begin (transaction, account) : store->pending_begin (transaction, vban::pending_key (account, 0)));
+			if (i != store->pending_end () && i->first.account == account)
+			{
+				++found;
+			}
+		}
+		auto elapsed (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - begin));
+		return std::make_pair (found, elapsed);
+	};
+	std::vector<vban::account> existing (accounts.begin (), accounts.begin () + num_lookups);
+	for (auto prefix : { false, true })
+	{
+		auto [found_existing, time_existing] = lookup (existing, prefix);
+		auto [found_missing, time_missing] = lookup (missing, prefix);
+		ASSERT_EQ (num_lookups, found_existing);
+		ASSERT_EQ (0, found_missing);
+		std::cout << boost::str (boost::format ("%1% seeks: %2% ms for accounts with pending entries, %3% ms for accounts without\n") % (prefix ? "Prefix" : "Total order") % time_existing.count () % time_missing.count ());
+	}
+}
+
 TEST (wallets, rep_scan)
 {
 	vban::system system (1);
@@ -1717,10 +1770,9 @@ TEST (node, mass_block_new)
 		next_block_count += num_blocks;
 		node.block_processor.flush ();
 		// Clear all active
+		for (auto const & election : node.active.list_active ())
 		{
-			vban::lock_guard<vban::mutex> guard (node.active.mutex);
-			node.active.roots.clear ();
-			node.active.blocks.clear ();
+			node.active.erase (*election->winner ());
 		}
 	};
 
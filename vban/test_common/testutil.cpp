@@ -24,6 +24,27 @@ vban::block_hash const & vban::genesis_hash (dev_constants.genesis_hash);
 vban::uint256_t const & vban::genesis_amount (dev_constants.genesis_amount);
 vban::account const & vban::burn_account (dev_constants.burn_account);
 
+std::vector<std::shared_ptr<vban::block>> vban::genesis_send_chain (vban::node & node_a, size_t count_a)
+{
+	std::vector<std::shared_ptr<vban::block>> result;
+	vban::block_hash previous (vban::genesis_hash);
+	vban::state_block_builder builder;
+	for (size_t i (1); i <= count_a; ++i)
+	{
+		result.push_back (builder.make_block ()
+						  .account (vban::dev_genesis_key.pub)
+						  .previous (previous)
+						  .representative (vban::dev_genesis_key.pub)
+						  .balance (vban::genesis_amount - i * vban::Gxrb_ratio)
+						  .link (vban::dev_genesis_key.pub)
+						  .sign (vban::dev_genesis_key.prv, vban::dev_genesis_key.pub)
+						  .work (*node_a.work_generate_blocking (previous))
+						  .build_shared ());
+		previous = result.back ()->hash ();
+	}
+	return result;
+}
+
 void vban::wait_peer_connections (vban::system & system_a)
 {
 	auto wait_peer_count = [&system_a] (bool in_memory) {
@@ -12,8 +12,10 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #define GTEST_TEST_ERROR_CODE(expression, text, actual, expected, fail)                       \
 	GTEST_AMBIGUOUS_ELSE_BLOCKER_                                                             \
@@ -52,6 +54,8 @@ class block_hash;
 class telemetry_data;
 class network_params;
 class system;
+class block;
+class node;
 
 extern vban::keypair const & zero_key;
 extern vban::keypair const & dev_genesis_key;
@@ -213,4 +217,6 @@ namespace util
 }
 
 void wait_peer_connections (vban::system &);
+/** Chain of \p count_a state blocks after the genesis block, each sending Gxrb_ratio from the genesis account to itself */
+std::vector<std::shared_ptr<vban::block>> genesis_send_chain (vban::node &, size_t count_a);
 }
@@ -60,6 +60,9 @@ public:
 	bool operator< (const address_library_pair & other) const;
 	bool operator== (const address_library_pair & other) const;
 };
+
+/** Bytes this process caused to be written to storage, 0 where /proc/self/io is not available */
+uint64_t process_write_bytes ();
 }
 
 int main (int argc, char * const * argv)
@@ -91,9 +94,13 @@ int main (int argc, char * const * argv)
 		("debug_verify_profile_batch", "Profile batch signature verification")
 		("debug_profile_bootstrap", "Profile bootstrap style blocks processing (at least 10GB of free storage space required)")
 		("debug_profile_sign", "Profile signature generation")
+		("debug_profile_rep_weights", "Profile representative weight lookups with and without concurrent weight updates")
+		("debug_profile_uint256", "Profile balance arithmetic with the multiprecision and fixed width 256 bit types")
 		("debug_profile_process", "Profile active blocks processing (only for vban_dev_network)")
-		("debug_profile_votes", "Profile votes processing (only for vban_dev_network)")
+		("debug_profile_votes", "Profile votes processing, use --config node.vote_processor_threads=N to compare thread counts (only for vban_dev_network)")
+		("debug_profile_election_votes", "Profile vote tallying of many representatives voting in a single election (only for vban_dev_network)")
 		("debug_profile_frontiers_confirmation", "Profile frontiers confirmation speed (only for vban_dev_network)")
+		("debug_profile_group_commit", "Profile block processing while every block is cemented as soon as it is written, use --config node.write_group_commit=true to compare (only for vban_dev_network)")
 		("debug_random_feed", "Generates output to RNG test suites")
 		("debug_rpc", "Read an RPC command from stdin and invoke it. Network operations will have no effect.")
 		("debug_peers", "Display peer IPv6:port connections")
@@ -495,7 +502,7 @@ int main (int argc, char * const * argv)
 			vban::change_block block (0, 0, vban::keypair ().prv, 0, 0);
 			if (!result)
 			{
-				std::cerr << boost::str (boost::format ("Starting generation profiling. Difficulty: %1$#x (%2%x from base difficulty %3$#x)\n") % difficulty % vban::to_string (vban::difficulty::to_multiplier (difficulty, network_constants.publish_full.base), 4) % network_constants.publish_full.base);
+				std::cerr << boost::str (boost::format ("Starting generation profiling. Difficulty: %1$#x (%2%x from base difficulty %3$#x). CPU kernel: %4% (%5% lanes)\n") % difficulty % vban::to_string (vban::difficulty::to_multiplier (difficulty, network_constants.publish_full.base), 4) % network_constants.publish_full.base % vban::to_string (work.cpu.kernel_m) % work.cpu.lanes ());
 				while (!result)
 				{
 					block.hashables.previous.qwords[0] += 1;
@@ -853,20 +860,48 @@ int main (int argc, char * const * argv)
 		}
 		else if (vm.count ("debug_verify_profile_batch"))
 		{
-			vban::keypair key;
+			// Votes from a small set of representatives, as seen by the vote processor
 			size_t batch_count (1000);
+			size_t rep_count (100);
+			std::vector<vban::keypair> keys (rep_count);
 			vban::uint256_union message;
-			vban::uint512_union signature (vban::sign_message (key.prv, key.pub, message));
+			std::vector<vban::signature> signatures_l;
+			for (auto const & key : keys)
+			{
+				signatures_l.push_back (vban::sign_message (key.prv, key.pub, message));
+			}
 			std::vector<unsigned char const *> messages (batch_count, message.bytes.data ());
 			std::vector<size_t> lengths (batch_count, sizeof (message));
-			std::vector<unsigned char const *> pub_keys (batch_count, key.pub.bytes.data ());
-			std::vector<unsigned char const *> signatures (batch_count, signature.bytes.data ());
+			std::vector<unsigned char const *> pub_keys;
+			std::vector<unsigned char const *> signatures;
+			for (auto i (0u); i < batch_count; ++i)
+			{
+				pub_keys.push_back (keys[i % rep_count].pub.bytes.data ());
+				signatures.push_back (signatures_l[i % rep_count].bytes.data ());
+			}
 			std::vector<int> verifications;
 			verifications.resize (batch_count);
 			auto begin (std::chrono::high_resolution_clock::now ());
 			vban::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), signatures.data (), batch_count, verifications.data ());
 			auto end (std::chrono::high_resolution_clock::now ());
 			std::cerr << "Batch signature verifications " << std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count () << std::endl;
+			vban::representative_key_cache representative_keys;
+			std::vector<vban::public_key> rep_keys;
+			for (auto const & key : keys)
+			{
+				rep_keys.push_back (key.pub);
+			}
+			representative_keys.update (rep_keys);
+			auto keys_l (representative_keys.keys ());
+			std::vector<ed25519_unpacked_public_key const *> unpacked;
+			for (auto i (0u); i < batch_count; ++i)
+			{
+				unpacked.push_back (&keys_l->find (keys[i % rep_count].pub)->second);
+			}
+			begin = std::chrono::high_resolution_clock::now ();
+			vban::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), unpacked.data (), signatures.data (), batch_count, verifications.data ());
+			end = std::chrono::high_resolution_clock::now ();
+			std::cerr << "Batch signature verifications with decompressed representative keys " << std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count () << std::endl;
 		}
 		else if (vm.count ("debug_profile_sign"))
 		{
@@ -885,6 +920,110 @@ int main (int argc, char * const * argv)
 				std::cerr << boost::str (boost::format ("%|1$ 12d|\n") % std::chrono::duration_cast<std::chrono::microseconds> (end1 - begin1).count ());
 			}
 		}
+		else if (vm.count ("debug_profile_rep_weights"))
+		{
+			size_t const rep_count (1024);
+			auto const duration (std::chrono::seconds (5));
+			std::vector<vban::account> reps (rep_count);
+			vban::rep_weights rep_weights;
+			for (auto & rep : reps)
+			{
+				vban::random_pool::generate_block (rep.bytes.data (), rep.bytes.size ());
+				rep_weights.representation_put (rep, vban::uint128_union (std::numeric_limits<uint64_t>::max ()));
+			}
+			auto reader_count (std::max (1u, std::thread::hardware_concurrency () - 1));
+			auto profile = [&] (bool with_writer) {
+				std::atomic<bool> stopped{ false };
+				std::atomic<uint64_t> reads{ 0 };
+				std::atomic<uint64_t> writes{ 0 };
+				std::vector<std::thread> threads;
+				for (auto i (0u); i < reader_count; ++i)
+				{
+					threads.emplace_back ([&, i] () {
+						uint64_t reads_l (0);
+						vban::uint256_t total (0);
+						for (size_t index (i); !stopped; ++index, ++reads_l)
+						{
+							total += rep_weights.representation_get (reps[index % rep_count]);
+						}
+						reads += reads_l;
+						(void)total;
+					});
+				}
+				if (with_writer)
+				{
+					// Mimics block processing moving balances between representatives
+					threads.emplace_back ([&] () {
+						uint64_t writes_l (0);
+						for (size_t index (0); !stopped; ++index, ++writes_l)
+						{
+							rep_weights.representation_add_dual (reps[index % rep_count], 0 - vban::uint256_t (1), reps[(index * 7 + 1) % rep_count], 1);
+						}
+						writes += writes_l;
+					});
+				}
+				std::this_thread::sleep_for (duration);
+				stopped = true;
+				for (auto & thread : threads)
+				{
+					thread.join ();
+				}
+				std::cout << boost::str (boost::format ("%1% reader threads%2%: %3% reads/s, %4% writes/s\n") % reader_count % (with_writer ? " with concurrent writer" : "") % (reads / duration.count ()) % (writes / duration.count ()));
+			};
+			profile (false);
+			profile (true);
+		}
+		else if (vm.count ("debug_profile_uint256"))
+		{
+			size_t const count (1024 * 1024);
+			std::vector<vban::uint256_t> amounts;
+			amounts.reserve (count);
+			for (size_t i (0); i < count; ++i)
+			{
+				vban::uint128_union amount;
+				vban::random_pool::generate_block (amount.bytes.data (), amount.bytes.size ());
+				amounts.push_back (amount.number ());
+			}
+			std::vector<vban::uint256_fixed> amounts_fixed (amounts.begin (), amounts.end ());
+			// Both operands are prepared up front, the fixed loop only times fixed width arithmetic
+			std::vector<vban::uint256_fixed> halves_fixed;
+			halves_fixed.reserve (count);
+			for (auto const & amount : amounts)
+			{
+				halves_fixed.emplace_back (amount >> 1);
+			}
+			for (auto round (0); round < 5; ++round)
+			{
+				auto begin (std::chrono::high_resolution_clock::now ());
+				vban::uint256_t sum (0);
+				for (auto const & amount : amounts)
+				{
+					sum += amount;
+					sum -= amount >> 1;
+				}
+				auto end (std::chrono::high_resolution_clock::now ());
+				auto multiprecision_time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+				begin = std::chrono::high_resolution_clock::now ();
+				vban::uint256_fixed sum_fixed (0);
+				for (size_t i (0); i < count; ++i)
+				{
+					sum_fixed += amounts_fixed[i];
+					sum_fixed -= halves_fixed[i];
+				}
+				end = std::chrono::high_resolution_clock::now ();
+				auto fixed_time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+				begin = std::chrono::high_resolution_clock::now ();
+				vban::uint256_fixed sum_converted (0);
+				for (auto const & amount : amounts)
+				{
+					sum_converted += vban::uint256_fixed (amount);
+				}
+				end = std::chrono::high_resolution_clock::now ();
+				auto converted_time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+				release_assert (sum == sum_fixed.number ());
+				std::cout << boost::str (boost::format ("%1% additions and subtractions: uint256_t %2% us, uint256_fixed %3% us, %1% conversions and additions %4% us\n") % count % multiprecision_time % fixed_time % converted_time);
+			}
+		}
 		else if (vm.count ("debug_profile_process"))
 		{
 			vban::network_constants::set_active_network (vban::vban_networks::vban_dev_network);
@@ -980,6 +1119,11 @@ int main (int argc, char * const * argv)
 			while (!blocks.empty ())
 			{
 				auto block (blocks.front ());
+				// Live blocks are dropped once their queue is full
+				while (node->block_processor.full (vban::block_source::live))
+				{
+					std::this_thread::yield ();
+				}
 				node->process_active (block);
 				blocks.pop_front ();
 			}
@@ -991,7 +1135,7 @@ int main (int argc, char * const * argv)
 				if (timer_l.after_deadline (std::chrono::seconds (15)))
 				{
 					timer_l.restart ();
-					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked), %3% remaining") % node->ledger.cache.block_count % node->store.unchecked_count (node->store.tx_begin_read ()) % node->block_processor.size ()) << std::endl;
+					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked), %3% remaining") % node->ledger.cache.block_count % node->unchecked.count (node->store.tx_begin_read ()) % node->block_processor.size ()) << std::endl;
 				}
 			}
 
@@ -1087,18 +1231,27 @@ int main (int argc, char * const * argv)
 			while (!blocks.empty ())
 			{
 				auto block (blocks.front ());
+				// Live blocks are dropped once their queue is full
+				while (node->block_processor.full (vban::block_source::live))
+				{
+					std::this_thread::yield ();
+				}
 				node->process_active (block);
 				blocks.pop_front ();
 			}
 			node->block_processor.flush ();
 			// Processing votes
-			std::cerr << boost::str (boost::format ("Starting processing %1% votes\n") % max_votes);
+			std::cerr << boost::str (boost::format ("Starting processing %1% votes with %2% vote processor threads\n") % max_votes % node->config.vote_processor_threads);
 			auto begin (std::chrono::high_resolution_clock::now ());
 			while (!votes.empty ())
 			{
 				auto vote (votes.front ());
 				auto channel (std::make_shared<vban::transport::channel_loopback> (*node));
-				node->vote_processor.vote (vote, channel);
+				// Keep the flood going at the rate the vote processor drains instead of dropping votes when full
+				while (node->vote_processor.vote (vote, channel))
+				{
+					std::this_thread::yield ();
+				}
 				votes.pop_front ();
 			}
 			while (!node->active.empty ())
@@ -1110,6 +1263,81 @@ int main (int argc, char * const * argv)
 			node->stop ();
 			std::cerr << boost::str (boost::format ("%|1$ 12d| us \n%2% votes per second\n") % time % (max_votes * 1000000 / time));
 		}
+		else if (vm.count ("debug_profile_election_votes"))
+		{
+			vban::network_constants::set_active_network (vban::vban_networks::vban_dev_network);
+			vban::network_params dev_params;
+			vban::block_builder builder;
+			size_t num_representatives (4000);
+			vban::node_flags node_flags;
+			vban::update_flags (node_flags, vm);
+			vban::node_wrapper node_wrapper (vban::unique_path (), data_path, node_flags);
+			auto node = node_wrapper.node;
+			std::cerr << boost::str (boost::format ("Starting generating %1% representatives\n") % num_representatives);
+			vban::block_hash genesis_latest (node->latest (dev_params.ledger.dev_genesis_key.pub));
+			vban::uint256_t genesis_balance (node->balance (dev_params.ledger.dev_genesis_key.pub));
+			// Representatives hold a single raw each so the election never reaches quorum
+			std::vector<vban::keypair> keys (num_representatives);
+			{
+				auto transaction (node->store.tx_begin_write ());
+				for (auto const & key : keys)
+				{
+					genesis_balance = genesis_balance - 1;
+					auto send = builder.state ()
+								.account (dev_params.ledger.dev_genesis_key.pub)
+								.previous (genesis_latest)
+								.representative (dev_params.ledger.dev_genesis_key.pub)
+								.balance (genesis_balance)
+								.link (key.pub)
+								.sign (dev_params.ledger.dev_genesis_key.prv, dev_params.ledger.dev_genesis_key.pub)
+								.work (*node->work.generate (vban::work_version::work_1, genesis_latest, node->network_params.network.publish_thresholds.epoch_1))
+								.build ();
+					genesis_latest = send->hash ();
+					release_assert (node->ledger.process (transaction, *send).code == vban::process_result::progress);
+					auto open = builder.state ()
+								.account (key.pub)
+								.previous (0)
+								.representative (key.pub)
+								.balance (1)
+								.link (genesis_latest)
+								.sign (key.prv, key.pub)
+								.work (*node->work.generate (vban::work_version::work_1, key.pub, node->network_params.network.publish_thresholds.epoch_1))
+								.build ();
+					release_assert (node->ledger.process (transaction, *open).code == vban::process_result::progress);
+				}
+			}
+			vban::keypair destination;
+			auto send = builder.state ()
+						.account (dev_params.ledger.dev_genesis_key.pub)
+						.previous (genesis_latest)
+						.representative (dev_params.ledger.dev_genesis_key.pub)
+						.balance (genesis_balance - 1)
+						.link (destination.pub)
+						.sign (dev_params.ledger.dev_genesis_key.prv, dev_params.ledger.dev_genesis_key.pub)
+						.work (*node->work.generate (vban::work_version::work_1, genesis_latest, node->network_params.network.publish_thresholds.epoch_1))
+						.build ();
+			release_assert (node->ledger.process (node->store.tx_begin_write (), *send).code == vban::process_result::progress);
+			node->block_confirm (send);
+			auto election (node->active.election (send->qualified_root ()));
+			release_assert (election != nullptr);
+			// Normal votes insert a voter, final votes replace an existing one
+			// Live traffic changes a weight for every processed block, mostly of representatives not voting in the election
+			for (auto timestamp : { uint64_t (1), std::numeric_limits<uint64_t>::max () })
+			{
+				auto begin (std::chrono::high_resolution_clock::now ());
+				for (auto const & key : keys)
+				{
+					node->ledger.cache.rep_weights.representation_add (destination.pub, 1);
+					election->vote (key.pub, timestamp, send->hash ());
+				}
+				auto end (std::chrono::high_resolution_clock::now ());
+				auto time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+				std::cerr << boost::str (boost::format ("%1% votes with timestamp %2% in %3% us, %4% votes per second\n") % num_representatives % timestamp % time % (num_representatives * 1000000 / std::max<decltype (time)> (time, 1)));
+			}
+			release_assert (!election->confirmed ());
+			release_assert (election->tally ().begin ()->first == num_representatives);
+			node->stop ();
+		}
 		else if (vm.count ("debug_profile_frontiers_confirmation"))
 		{
 			vban::force_vban_dev_network ();
@@ -1295,6 +1523,109 @@ int main (int argc, char * const * argv)
 			node1->stop ();
 			node2->stop ();
 		}
+		else if (vm.count ("debug_profile_group_commit"))
+		{
+			vban::force_vban_dev_network ();
+			vban::network_params dev_params;
+			vban::block_builder builder;
+			size_t count (64 * 1024);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				try
+				{
+					count = boost::lexical_cast<size_t> (count_it->second.as<std::string> ());
+				}
+				catch (boost::bad_lexical_cast &)
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			std::vector<std::string> config_overrides;
+			auto config (vm.find ("config"));
+			if (config != vm.end ())
+			{
+				config_overrides = vban::config_overrides (config->second.as<std::vector<vban::config_key_value_pair>> ());
+			}
+			vban::daemon_config daemon_config (data_path);
+			auto error = vban::read_node_config_toml (data_path, daemon_config, config_overrides);
+			if (error)
+			{
+				std::cerr << "\n"
+						  << error.get_message () << std::endl;
+				std::exit (1);
+			}
+			boost::asio::io_context io_ctx;
+			vban::work_pool work (std::numeric_limits<unsigned>::max ());
+			auto path (vban::unique_path ());
+			vban::logging logging;
+			logging.init (path);
+			vban::node_flags flags;
+			vban::update_flags (flags, vm);
+			flags.disable_lazy_bootstrap = true;
+			flags.disable_legacy_bootstrap = true;
+			flags.disable_wallet_bootstrap = true;
+			flags.disable_bootstrap_listener = true;
+			auto node (std::make_shared<vban::node> (io_ctx, path, daemon_config.node, work, flags, 0));
+			std::cout << boost::str (boost::format ("Starting generating %1% blocks...\n") % count);
+			vban::block_hash genesis_latest (node->latest (dev_params.ledger.dev_genesis_key.pub));
+			vban::uint256_t genesis_balance (vban::uint256_t ("50000000000000000000000000000000000000"));
+			std::vector<std::shared_ptr<vban::block>> blocks;
+			for (auto i (0); i != count; ++i)
+			{
+				vban::keypair key;
+				genesis_balance = genesis_balance - 1;
+				auto send = builder.state ()
+							.account (dev_params.ledger.dev_genesis_key.pub)
+							.previous (genesis_latest)
+							.representative (dev_params.ledger.dev_genesis_key.pub)
+							.balance (genesis_balance)
+							.link (key.pub)
+							.sign (dev_params.ledger.dev_genesis_key.prv, dev_params.ledger.dev_genesis_key.pub)
+							.work (*work.generate (vban::work_version::work_1, genesis_latest, dev_params.network.publish_thresholds.epoch_1))
+							.build ();
+				genesis_latest = send->hash ();
+				blocks.push_back (std::move (send));
+			}
+			std::cout << boost::str (boost::format ("Processing and cementing %1% blocks, group commit %2%\n") % count % (daemon_config.node.write_group_commit ? "enabled" : "disabled"));
+			auto write_bytes_start (process_write_bytes ());
+			auto begin (std::chrono::high_resolution_clock::now ());
+			// Cement each block as soon as it is in the ledger, so cementing competes with block processing for the write queue
+			std::thread cementer ([&node, &blocks] () {
+				for (auto const & block : blocks)
+				{
+					while (!node->ledger.block_or_pruned_exists (block->hash ()))
+					{
+						std::this_thread::sleep_for (std::chrono::microseconds (100));
+					}
+					node->confirmation_height_processor.add (block);
+				}
+			});
+			for (auto const & block : blocks)
+			{
+				// Submitted at the rate the block processor drains, live blocks are dropped once their queue is full
+				while (node->block_processor.full (vban::block_source::live))
+				{
+					std::this_thread::yield ();
+				}
+				node->process_active (block);
+			}
+			cementer.join ();
+			while (node->ledger.cache.cemented_count != count + 1)
+			{
+				std::this_thread::sleep_for (std::chrono::milliseconds (10));
+			}
+			auto end (std::chrono::high_resolution_clock::now ());
+			auto time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+			auto write_bytes (process_write_bytes () - write_bytes_start);
+			auto acquired (node->write_database_queue.acquired ());
+			auto appended (node->write_database_queue.appended ());
+			std::cout << boost::str (boost::format ("%|1$ 12d| us \n%2% blocks per second\n") % time % (count * 1000000 / time));
+			std::cout << boost::str (boost::format ("%1% write transactions committed, %2% writes appended to another writer's transaction\n") % acquired % appended);
+			std::cout << boost::str (boost::format ("%1% bytes written to storage, %2% per block\n") % write_bytes % (write_bytes / count));
+			node->stop ();
+		}
 		else if (vm.count ("debug_random_feed"))
 		{
 			/*
@@ -1845,7 +2176,7 @@ int main (int argc, char * const * argv)
 				if (timer_l.after_deadline (std::chrono::seconds (60)))
 				{
 					timer_l.restart ();
-					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked)") % node.node->ledger.cache.block_count % node.node->store.unchecked_count (node.node->store.tx_begin_read ())) << std::endl;
+					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked)") % node.node->ledger.cache.block_count % node.node->unchecked.count (node.node->store.tx_begin_read ())) << std::endl;
 				}
 			}
 
@@ -2054,4 +2385,20 @@ bool address_library_pair::operator== (const address_library_pair & other) const
 {
 	return address == other.address;
 }
+
+uint64_t process_write_bytes ()
+{
+	uint64_t result (0);
+	std::ifstream io ("/proc/self/io");
+	std::string key;
+	uint64_t value;
+	while (io >> key >> value)
+	{
+		if (key == "write_bytes:")
+		{
+			result = value;
+		}
+	}
+	return result;
+}
 }